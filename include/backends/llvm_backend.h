@@ -9,6 +9,10 @@ int bread_llvm_emit_obj(const ASTStmtList* program, const char* out_path);
 int bread_llvm_emit_exe(const ASTStmtList* program, const char* out_path);
 int bread_llvm_jit_exec(const ASTStmtList* program);
 
+// Build programs that write an allocation-site profile to `path` at exit
+// ("-" for stderr), sampling 1 in `sample_bytes` bytes (0 = every object).
+void bread_llvm_set_alloc_profile(const char* path, size_t sample_bytes);
+
 // JIT one function. Returns 0 on success, 1 on failure >:(
 // The pointer is stored at fn->jit_fn.
 int bread_llvm_jit_function(Function* fn);
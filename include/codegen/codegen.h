@@ -40,6 +40,8 @@ typedef struct CgFunction {
     CgScope* scope;
     LLVMValueRef ret_slot;
     LLVMValueRef runtime_scope_base_depth_slot;
+    LLVMValueRef arena_mark_slot; // set when the body has arena-allocated literals
+    LLVMValueRef alloc_site_slot; // caller's allocation site, in profiling builds
     
     // Method context for self/super support
     struct CgClass* current_class;  // Current class if this is a method
@@ -93,11 +95,22 @@ typedef struct {
     LLVMValueRef fn_value_set_array;
     LLVMValueRef fn_value_set_dict;
     LLVMValueRef fn_value_copy;
+    LLVMValueRef fn_value_store;
     LLVMValueRef fn_value_release;
+    LLVMValueRef fn_nursery_mark;
+    LLVMValueRef fn_nursery_reset;
+    LLVMValueRef fn_arena_enter;
+    LLVMValueRef fn_arena_leave;
+    LLVMValueRef fn_alloc_site;
+    LLVMValueRef fn_alloc_site_get;
+    LLVMValueRef fn_alloc_site_restore;
+    LLVMValueRef fn_alloc_profile_start;
     LLVMValueRef fn_print;
     LLVMValueRef fn_is_truthy;
     LLVMValueRef fn_unary_not;
     LLVMValueRef fn_binary_op;
+    LLVMValueRef fn_concat_op;
+    LLVMValueRef fn_append_op;
     LLVMValueRef fn_index_op;
     LLVMValueRef fn_index_set_op;
     LLVMValueRef fn_member_op;
@@ -109,6 +122,7 @@ typedef struct {
     LLVMValueRef fn_var_decl;
     LLVMValueRef fn_var_decl_if_missing;
     LLVMValueRef fn_var_assign;
+    LLVMValueRef fn_var_append;
     LLVMValueRef fn_var_load;
     LLVMValueRef fn_push_scope;
     LLVMValueRef fn_pop_scope;
@@ -131,8 +145,10 @@ typedef struct {
     LLVMValueRef fn_init_functions;
     LLVMValueRef fn_cleanup_functions;
     LLVMValueRef fn_array_new;
+    LLVMValueRef fn_array_new_arena;
     LLVMValueRef fn_array_release;
     LLVMValueRef fn_dict_new;
+    LLVMValueRef fn_dict_new_arena;
     LLVMValueRef fn_dict_release;
     LLVMValueRef fn_dict_keys;
     LLVMValueRef fn_string_create;
@@ -165,11 +181,22 @@ typedef struct {
     LLVMTypeRef ty_value_set_array;
     LLVMTypeRef ty_value_set_dict;
     LLVMTypeRef ty_value_copy;
+    LLVMTypeRef ty_value_store;
     LLVMTypeRef ty_value_release;
+    LLVMTypeRef ty_nursery_mark;
+    LLVMTypeRef ty_nursery_reset;
+    LLVMTypeRef ty_arena_enter;
+    LLVMTypeRef ty_arena_leave;
+    LLVMTypeRef ty_alloc_site;
+    LLVMTypeRef ty_alloc_site_get;
+    LLVMTypeRef ty_alloc_site_restore;
+    LLVMTypeRef ty_alloc_profile_start;
     LLVMTypeRef ty_print;
     LLVMTypeRef ty_is_truthy;
     LLVMTypeRef ty_unary_not;
     LLVMTypeRef ty_binary_op;
+    LLVMTypeRef ty_concat_op;
+    LLVMTypeRef ty_append_op;
     LLVMTypeRef ty_index_op;
     LLVMTypeRef ty_index_set_op;
     LLVMTypeRef ty_member_op;
@@ -179,6 +206,7 @@ typedef struct {
     LLVMTypeRef ty_var_decl;
     LLVMTypeRef ty_var_decl_if_missing;
     LLVMTypeRef ty_var_assign;
+    LLVMTypeRef ty_var_append;
     LLVMTypeRef ty_var_load;
     LLVMTypeRef ty_push_scope;
     LLVMTypeRef ty_pop_scope;
@@ -195,8 +223,10 @@ typedef struct {
     LLVMTypeRef ty_init_functions;
     LLVMTypeRef ty_cleanup_functions;
     LLVMTypeRef ty_array_new;
+    LLVMTypeRef ty_array_new_arena;
     LLVMTypeRef ty_array_release;
     LLVMTypeRef ty_dict_new;
+    LLVMTypeRef ty_dict_new_arena;
     LLVMTypeRef ty_dict_release;
     LLVMTypeRef ty_dict_keys;
     LLVMTypeRef ty_string_create;
@@ -236,11 +266,17 @@ typedef struct {
     CgScope* global_scope;
     int scope_depth;
     int had_error;
+    int alloc_profile; // tag statements with their source location
+    const SourceLoc* alloc_site_loc; // innermost statement whose site is being emitted
 } Cg;
 
 LLVMValueRef cg_declare_fn(Cg* cg, const char* name, LLVMTypeRef fn_type);
 int cg_define_functions(Cg* cg);
 LLVMValueRef cg_value_size(Cg* cg);
+void cg_arena_enter(Cg* cg, CgFunction* cg_fn);
+void cg_arena_leave(Cg* cg, CgFunction* cg_fn);
+void cg_alloc_site_save(Cg* cg, CgFunction* cg_fn);
+void cg_alloc_site_restore(Cg* cg, CgFunction* cg_fn);
 int cg_build_stmt_list(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, ASTStmtList* program);
 LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, ASTExpr* expr);
 int cg_build_stmt(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, ASTStmt* stmt);
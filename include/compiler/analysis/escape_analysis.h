@@ -17,6 +17,7 @@ typedef struct {
     int can_stack_allocate; // SAFE! 3rd base -> RUNNER UP! 
     int lifetime_end;       
     int ref_count;          
+    int arena_site;         // collection literal allocated from the call arena
 } EscapeInfo;
 
 // Analysis context
@@ -26,11 +27,15 @@ typedef struct {
     int alloc_capacity;
     int current_stmt_index;
     int function_depth;
+    int arena_sites;
 } EscapeAnalysisCtx;
 
 int escape_analysis_run(ASTStmtList* program);
 EscapeInfo* get_escape_info(ASTExpr* expr);
 int can_stack_allocate(ASTExpr* expr);
 int get_value_lifetime(ASTExpr* expr);
+int escape_analysis_is_arena_site(ASTExpr* expr);
+int escape_analysis_body_uses_arena(ASTStmtList* body);
+int escape_analysis_arena_site_count(void);
 
 #endif
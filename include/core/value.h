@@ -9,9 +9,14 @@
 struct BreadArray {
     BreadObjHeader header;
     int count;
-    int capacity;
+    int capacity;         // slots from the first element on
+    int head;             // free slots in front of the first element, see value_array.c
     VarType element_type; 
-    BreadValue* items;
+    BreadValue* items;    // NULL while `unboxed` holds the elements
+    void* unboxed;        // int64_t, double or uint8_t per element of an Int, Double or Bool array
+    int64_t range_start;  // element i of a lazy range() is range_start + i * range_step
+    int64_t range_step;   // 0 unless the array is a range with no storage yet
+    BreadArray* base;     // owns the storage items/unboxed point into, NULL if this array does
 };
 
 typedef struct {
@@ -69,13 +74,18 @@ ExprResult bread_expr_result_from_value(BreadValue v);
 
 void bread_value_release(BreadValue* v);
 BreadValue bread_value_clone(BreadValue v);
+BreadValue bread_value_promote(BreadValue v);
 
 BreadArray* bread_array_new(void);
+BreadArray* bread_array_new_in_arena(void);
 BreadArray* bread_array_new_typed(VarType element_type);
 BreadArray* bread_array_new_with_capacity(int capacity, VarType element_type);
 BreadArray* bread_array_from_literal(BreadValue* elements, int count);
+BreadArray* bread_array_new_range(int64_t start, int64_t stop, int64_t step);
+BreadArray* bread_array_slice(BreadArray* a, int start, int end);  // shares a's elements until either is written
 
 BreadStruct* bread_struct_new(const char* type_name, int field_count, char** field_names);
+BreadStruct* bread_struct_new_in_arena(const char* type_name, int field_count, char** field_names);
 void bread_struct_set_field(BreadStruct* s, const char* field_name, BreadValue value);
 void bread_struct_set_field_value_ptr(BreadStruct* s, const char* field_name, const BreadValue* value);
 BreadValue* bread_struct_get_field(BreadStruct* s, const char* field_name);
@@ -125,12 +135,17 @@ BreadValue bread_array_remove_at(BreadArray* array, int index);
 int bread_array_contains(BreadArray* array, BreadValue value);
 int bread_array_index_of(BreadArray* array, BreadValue value);
 int bread_array_set(BreadArray* a, int idx, BreadValue v);
-BreadValue* bread_array_get(BreadArray* a, int idx);
+BreadValue* bread_array_get(BreadArray* a, int idx);  // boxes an unboxed array for good
+BreadValue bread_array_at(const BreadArray* a, int idx);  // borrowed, idx must be in range
+int bread_array_box(BreadArray* a);
+int64_t* bread_array_int_data(BreadArray* a);    // NULL unless an unboxed [Int]
+double* bread_array_double_data(BreadArray* a);  // NULL unless an unboxed [Double]
 BreadValue* bread_array_get_safe(BreadArray* array, int index);
 int bread_array_set_safe(BreadArray* array, int index, BreadValue value);
 int bread_array_negative_index(BreadArray* array, int index);
 int bread_array_length(BreadArray* a);
 BreadDict* bread_dict_new(void);
+BreadDict* bread_dict_new_in_arena(void);
 BreadDict* bread_dict_new_typed(VarType key_type, VarType value_type);
 BreadDict* bread_dict_new_with_capacity(int capacity, VarType key_type, VarType value_type);
 BreadDict* bread_dict_from_literal(BreadDictEntry* entries, int count);
@@ -141,6 +156,8 @@ int bread_dict_find_slot(BreadDict* dict, BreadValue key);
 void bread_dict_resize(BreadDict* dict, int new_capacity);
 int bread_dict_set(BreadDict* d, const char* key, BreadValue v);
 BreadValue* bread_dict_get(BreadDict* d, const char* key);
+int bread_dict_set_string(BreadDict* d, BreadString* key, BreadValue v);
+BreadValue* bread_dict_get_string(BreadDict* d, const BreadString* key);
 BreadValue* bread_dict_get_safe(BreadDict* dict, BreadValue key);
 BreadValue bread_dict_get_with_default(BreadDict* dict, BreadValue key, BreadValue default_val);
 int bread_dict_set_safe(BreadDict* dict, BreadValue key, BreadValue value);
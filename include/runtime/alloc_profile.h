@@ -0,0 +1,23 @@
+#ifndef ALLOC_PROFILE_H
+#define ALLOC_PROFILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Allocation-site profiler. Compiled code reports the source location of
+// each statement and the allocators charge what they hand out to it,
+// including the item and entry buffers behind arrays and dicts.
+// With a sample size of N bytes, about one allocation per N bytes is
+// recorded and scaled up, so the report is an estimate.
+
+extern int bread_alloc_profile_active;
+
+void bread_alloc_profile_start(const char* path, size_t sample_bytes);
+void bread_alloc_profile_stop(void);
+void bread_alloc_profile_set_site(const char* file, int32_t line, int32_t column);
+uint32_t bread_alloc_profile_site(void);
+void bread_alloc_profile_restore_site(uint32_t site);
+void bread_alloc_profile_record(void* object, size_t size, int tracked);
+void bread_alloc_profile_forget(void* object);
+
+#endif
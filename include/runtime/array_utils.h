@@ -5,6 +5,8 @@
 
 struct BreadArray* bread_range_create(int64_t start, int64_t end, int64_t step);
 struct BreadArray* bread_range(int64_t n);
+struct BreadArray* bread_array_parse_ints(struct BreadArray* strings);    // [String] -> [Int]
+struct BreadArray* bread_array_parse_doubles(struct BreadArray* strings); // [String] -> [Double]
 int bread_array_get_value(struct BreadArray* a, int idx, BreadValue* out);
 int bread_value_array_get(BreadValue* array_val, int idx, BreadValue* out);
 int bread_value_array_length(BreadValue* array_val);
@@ -17,5 +17,11 @@ BreadValue bread_builtin_int(BreadValue* args, int arg_count);
 BreadValue bread_builtin_float(BreadValue* args, int arg_count);
 BreadValue bread_builtin_double(BreadValue* args, int arg_count);
 BreadValue bread_builtin_input(BreadValue* args, int arg_count);
+BreadValue bread_builtin_sum(BreadValue* args, int arg_count);
+BreadValue bread_builtin_prod(BreadValue* args, int arg_count);
+BreadValue bread_builtin_min(BreadValue* args, int arg_count);
+BreadValue bread_builtin_max(BreadValue* args, int arg_count);
+BreadValue bread_builtin_mean(BreadValue* args, int arg_count);
+BreadValue bread_builtin_dot(BreadValue* args, int arg_count);
 
 #endif
@@ -5,6 +5,13 @@
 #include <stdint.h>
 #include "runtime/runtime.h"
 
+// Pause histogram buckets: bucket i counts pauses under 2^i microseconds,
+// the last bucket everything longer.
+#define BREAD_GC_PAUSE_BUCKETS 16
+
+// Upper bound on parallel marking threads
+#define BREAD_GC_MAX_THREADS 8
+
 // For debugging
 typedef struct {
     size_t total_allocations;
@@ -13,24 +20,53 @@ typedef struct {
     size_t peak_objects;
     size_t bytes_allocated;
     size_t bytes_freed;
+    size_t backing_bytes;      // array items and dict entries currently held
+    size_t peak_backing_bytes;
+    size_t chunks_released;
+    size_t nursery_allocations; // young objects, not counted in total_allocations
+    size_t nursery_promotions;
+    size_t arena_allocations;   // per-call arena objects, not counted in total_allocations
+    size_t gc_collections;
+    uint64_t gc_pause_total_ns;
+    uint64_t gc_pause_max_ns;
+    size_t gc_pause_histogram[BREAD_GC_PAUSE_BUCKETS];
 } BreadMemoryStats;
+// Cycle collector colours (Bacon-Rajan trial deletion)
+typedef enum {
+    BREAD_GC_BLACK = 0, // in use or free
+    BREAD_GC_GRAY,      // possible member of a cycle
+    BREAD_GC_WHITE,     // member of a garbage cycle
+    BREAD_GC_PURPLE     // possible root of a cycle
+} BreadGcColor;
+
+// Tracking header stored immediately before every managed object, so the
+// node for an object is found with pointer arithmetic instead of a search.
 typedef struct BreadObjectNode {
-    void* object;
+    struct BreadObjectNode* prev;
+    struct BreadObjectNode* next;
     size_t size;
     BreadObjKind kind;
-    int marked;
-    struct BreadObjectNode* next;
+    uint8_t marked;
+    uint8_t color;
+    uint8_t buffered; // sitting in the cycle root buffer
+    uint8_t pooled;
 } BreadObjectNode;
 
+// Slab size classes, in bytes of block (tracking node included)
+#define BREAD_POOL_CLASS_COUNT 9
+#define BREAD_POOL_MAX_BLOCK_SIZE 512
+
 typedef struct BreadMemoryChunk BreadMemoryChunk;
 typedef struct BreadMemoryPool {
-    BreadMemoryChunk* chunks;
+    BreadMemoryChunk* available; // chunks with at least one free block
+    BreadMemoryChunk* full;
+    size_t block_size;
     size_t total_chunks;
 } BreadMemoryPool;
 
 typedef struct BreadMemoryManager {
-    BreadObjectNode* all_objects;
-    BreadMemoryPool small_pool;
+    BreadObjectNode all_objects; // circular list sentinel
+    BreadMemoryPool pools[BREAD_POOL_CLASS_COUNT];
     
     // gc state
     int cycle_collection_enabled;
@@ -38,6 +74,33 @@ typedef struct BreadMemoryManager {
     size_t allocations_since_gc;
     size_t bytes_threshold;
     size_t bytes_since_gc;
+    BreadObjectNode** cycle_roots;
+    size_t cycle_root_count;
+    size_t cycle_root_capacity;
+    size_t gc_slice_budget_us;      // incremental mode when either budget is set
+    size_t gc_slice_budget_objects;
+    int gc_slice_pending;
+    int gc_threads; // marking threads for large full collections
+
+    // limits
+    size_t heap_limit;        // soft cap on live object bytes, 0 = unlimited
+    size_t pool_retain_bytes; // empty slab chunks kept around before unmapping
+    size_t empty_chunks;
+
+    // nursery for statement temporaries
+    uint8_t* nursery_base;
+    size_t nursery_top;
+    size_t nursery_high_water;
+    size_t nursery_depth; // statements open; young allocation only while nonzero
+    void** nursery_finalizers; // young objects holding references, in allocation order
+    size_t nursery_finalizer_count;
+    size_t nursery_finalizer_capacity;
+
+    // per-call arena for collections proven not to escape
+    uint8_t* arena_base;
+    size_t arena_top;
+    size_t arena_high_water;
+    int arena_depth; // open frames
     
     // stats for debugging
     BreadMemoryStats stats;
@@ -53,14 +116,35 @@ void bread_memory_init(void);
 void bread_memory_cleanup(void);
 void* bread_memory_alloc(size_t size, BreadObjKind kind);
 void* bread_memory_realloc(void* ptr, size_t new_size);
+size_t bread_memory_object_size(const void* object); // 0 unless tracked
 void bread_memory_free(void* ptr);
 void bread_memory_track_object(void* object, size_t size, BreadObjKind kind);
 void bread_memory_untrack_object(void* object);
 void bread_object_retain(void* object);
 void bread_object_release(void* object);
 uint32_t bread_object_get_refcount(void* object);
+// nursery
+void* bread_memory_alloc_young(size_t size, BreadObjKind kind);
+int bread_memory_is_young(const void* object);
+void* bread_memory_promote(void* object);
+size_t bread_memory_nursery_mark(void);
+void bread_memory_nursery_reset(size_t mark);
+int bread_memory_nursery_finalize(void* object);
+// call arena
+void* bread_memory_alloc_arena(size_t size, BreadObjKind kind);
+int bread_memory_is_arena(const void* object);
+size_t bread_memory_arena_enter(void);
+void bread_memory_arena_leave(size_t mark);
+// collection backing stores, accounted but not tracked as objects
+void* bread_memory_alloc_backing(size_t size, int zeroed);
+void* bread_memory_realloc_backing(void* ptr, size_t old_size, size_t new_size);
+void bread_memory_free_backing(void* ptr, size_t size);
 // cycle detect
+void bread_memory_possible_cycle_root(void* object);
 void bread_memory_collect_cycles(void);
+void bread_memory_gc_safepoint(void);
+void bread_memory_set_incremental_gc(size_t budget_us, size_t budget_objects);
+void bread_memory_set_gc_threads(int threads);
 void bread_memory_mark_reachable(void* root);
 void bread_memory_sweep_unreachable(void);
 void bread_memory_set_cycle_collection_threshold(int threshold);
@@ -70,6 +154,10 @@ void bread_memory_print_stats(void);
 int bread_memory_check_leaks(void);
 void bread_memory_print_leak_report(void);
 void bread_memory_enable_debug_mode(int enable);
+void bread_memory_set_heap_limit(size_t bytes);
+size_t bread_memory_get_heap_limit(void);
+void bread_memory_set_pool_retention(size_t bytes);
+int bread_memory_parse_size(const char* text, size_t* out_bytes);
 void bread_memory_cleanup_all(void);
 void bread_memory_cleanup_on_error(void);
 
@@ -0,0 +1,20 @@
+#ifndef NUMBER_FORMAT_H
+#define NUMBER_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Number to text without going through printf. Output is byte-for-byte what
+// the printf format named next to each function produces; the double
+// formatters start from the shortest digits that round-trip (Grisu2) and
+// only fall back to snprintf when rounding those digits could disagree with
+// rounding the exact value. Each writes a NUL and returns the length.
+
+#define BREAD_FORMAT_MAX 320 // "%.6f" of -DBL_MAX plus the terminator
+
+size_t bread_format_int_length(int64_t value);
+size_t bread_format_int(char* buf, int64_t value);                        // "%lld"
+size_t bread_format_double(char* buf, double value, int precision);       // "%.<precision>g"
+size_t bread_format_double_fixed(char* buf, double value, int decimals);  // "%.<decimals>f"
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef NUMBER_PARSE_H
+#define NUMBER_PARSE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Text to number without strtol/strtod. Both accept what the C library
+// would in the "C" locale (leading whitespace, an optional sign) but only
+// succeed when the number fills the whole of [s, s + len). Digits are read
+// eight at a time where the platform allows. Doubles are exact: a single
+// multiply or divide when that cannot round, otherwise Eisel-Lemire, and
+// strtod for what neither covers (more than 19 digits, subnormals, hex,
+// inf and nan).
+
+int bread_parse_int(const char* s, size_t len, int64_t* out);
+int bread_parse_double(const char* s, size_t len, double* out);
+
+#endif
@@ -26,13 +26,18 @@ typedef struct {
 struct BreadString {
     BreadObjHeader header;
     size_t len;           
+    uint64_t hash;        // bread_string_hash, 0 until first asked for
     uint32_t flags;       // String flags (e.g., BREAD_STRING_INTERNED, BREAD_STRING_SMALL)
     char data[];          
 };
 #endif // BREAD_STRING_DEFINED
 
+// Refcount of statically allocated objects; retain and release ignore them
+#define BREAD_REFCOUNT_IMMORTAL UINT32_MAX
+
 #define BREAD_STRING_INTERNED   0x01
 #define BREAD_STRING_SMALL      0x02
+#define BREAD_STRING_VIEW       0x04  // slice of another string, see string_ops.c
 #define BREAD_STRING_SMALL_MAX  15
 
 void* bread_alloc(size_t size);
@@ -41,19 +46,33 @@ void bread_free(void* ptr);
 
 BreadString* bread_string_new(const char* cstr);
 BreadString* bread_string_new_len(const char* data, size_t len);
+BreadString* bread_string_from_int(int64_t value);                   // statement temporary
+BreadString* bread_string_from_double(double value, int precision);  // same, "%.<precision>g"
 BreadString* bread_string_new_literal(const char* cstr);  // For string literals (interned)
 const char* bread_string_cstr(const BreadString* s);
+const char* bread_string_data(const BreadString* s);  // bytes only, may lack a NUL
 size_t bread_string_len(const BreadString* s);
 
 void bread_string_retain(BreadString* s);
 void bread_string_release(BreadString* s);
+BreadString* bread_string_new_young(const char* cstr);  // statement temporary
+BreadString* bread_string_promote(BreadString* s);
+BreadString* bread_string_slice(BreadString* s, size_t start, size_t end);
+BreadArray* bread_string_split(BreadString* s, const BreadString* sep);
+BreadString* bread_string_replace(BreadString* s, const BreadString* from, const BreadString* to);
+void bread_string_finalize_young(BreadString* s);
 
 BreadString* bread_string_concat(const BreadString* a, const BreadString* b);
+BreadString* bread_string_concat_n(const BreadString* const* parts, size_t count);
+BreadString* bread_string_append(BreadString* s, const BreadString* tail);
 int bread_string_eq(const BreadString* a, const BreadString* b);
 int bread_string_cmp(const BreadString* a, const BreadString* b);
+uint64_t bread_hash_bytes(const void* data, size_t len);
+uint64_t bread_string_hash(const BreadString* s);
 char bread_string_get_char(const BreadString* s, size_t index);  // For string indexing
 void bread_string_intern_init(void);
 void bread_string_intern_cleanup(void);
+void bread_string_intern_stats(size_t* count, size_t* lookups, size_t* hits);
 
 struct BreadArray;
 struct BreadDict;
@@ -66,7 +85,10 @@ typedef struct BreadValue {
     VarValue value;
 } BreadValue;
 
+int bread_string_index_in(const BreadValue* items, int count, const BreadString* needle);  // -1 if absent
 int bread_add(const struct BreadValue* left, const struct BreadValue* right, struct BreadValue* out);
+int bread_concat_op(struct BreadValue** parts, int32_t count, struct BreadValue* out);
+int bread_append_op(struct BreadValue* target, struct BreadValue** parts, int32_t count);
 int bread_eq(const struct BreadValue* left, const struct BreadValue* right, int* out_bool);
 void bread_print(const struct BreadValue* v);
 void bread_print_compact(const struct BreadValue* v);
@@ -83,6 +105,7 @@ void bread_value_set_struct(struct BreadValue* out, struct BreadStruct* s);
 void bread_value_set_class(struct BreadValue* out, struct BreadClass* c);
 size_t bread_value_size(void);
 void bread_value_copy(const struct BreadValue* in, struct BreadValue* out);
+void bread_value_store(const struct BreadValue* in, struct BreadValue* out);
 void bread_value_release_value(struct BreadValue* v);
 int bread_value_assign(struct BreadValue* target, const struct BreadValue* source);
 int bread_is_truthy(const BreadValue* v);
@@ -104,6 +127,7 @@ BreadClass* bread_class_create_instance(const char* class_name, const char* pare
 int bread_var_decl(const char* name, VarType type, int is_const, const BreadValue* init);
 int bread_var_decl_if_missing(const char* name, VarType type, int is_const, const BreadValue* init);
 int bread_var_assign(const char* name, const BreadValue* value);
+int bread_var_append(const char* name, BreadValue** parts, int32_t count);
 int bread_var_load(const char* name, BreadValue* out);
 void bread_push_scope(void);
 void bread_pop_scope(void);
@@ -112,6 +136,8 @@ int bread_scope_depth(void);
 void bread_pop_to_scope_depth(int target_depth);
 struct BreadArray* bread_range_create(int64_t start, int64_t end, int64_t step);
 struct BreadArray* bread_range(int64_t n);
+struct BreadArray* bread_array_parse_ints(struct BreadArray* strings);
+struct BreadArray* bread_array_parse_doubles(struct BreadArray* strings);
 int bread_array_get_value(struct BreadArray* a, int idx, struct BreadValue* out);
 int bread_value_array_get(struct BreadValue* array_val, int idx, struct BreadValue* out);
 int bread_value_array_length(struct BreadValue* array_val);
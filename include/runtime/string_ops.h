@@ -6,18 +6,32 @@
 BreadString* bread_string_new(const char* cstr);
 BreadString* bread_string_new_len(const char* data, size_t len);
 BreadString* bread_string_new_literal(const char* cstr);
+BreadString* bread_string_from_int(int64_t value);
+BreadString* bread_string_from_double(double value, int precision); // "%.<precision>g"
 const char* bread_string_cstr(const BreadString* s);
+const char* bread_string_data(const BreadString* s);
 size_t bread_string_len(const BreadString* s);
 
 void bread_string_retain(BreadString* s);
 void bread_string_release(BreadString* s);
+BreadString* bread_string_promote(BreadString* s);
+BreadString* bread_string_slice(BreadString* s, size_t start, size_t end);
+BreadArray* bread_string_split(BreadString* s, const BreadString* sep);
+BreadString* bread_string_replace(BreadString* s, const BreadString* from, const BreadString* to);
+void bread_string_finalize_young(BreadString* s);
 
 BreadString* bread_string_concat(const BreadString* a, const BreadString* b);
+BreadString* bread_string_concat_n(const BreadString* const* parts, size_t count);
+BreadString* bread_string_append(BreadString* s, const BreadString* tail);
 int bread_string_eq(const BreadString* a, const BreadString* b);
 int bread_string_cmp(const BreadString* a, const BreadString* b);
+int bread_string_index_in(const BreadValue* items, int count, const BreadString* needle); // -1 if absent
+uint64_t bread_hash_bytes(const void* data, size_t len);
+uint64_t bread_string_hash(const BreadString* s);
 char bread_string_get_char(const BreadString* s, size_t index);
 
 void bread_string_intern_init(void);
 void bread_string_intern_cleanup(void);
+void bread_string_intern_stats(size_t* count, size_t* lookups, size_t* hits);
 
 #endif // STRING_OPS_H
\ No newline at end of file
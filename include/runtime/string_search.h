@@ -0,0 +1,19 @@
+#ifndef STRING_SEARCH_H
+#define STRING_SEARCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Substring search over raw bytes. Candidate positions are those where both
+// the first and the last byte of the needle match; only those are compared
+// in full. On x86 the filter runs over 16 (SSE2) or 32 (AVX2) positions per
+// step, picked once from the CPU's features, with a scalar loop elsewhere.
+
+int64_t bread_bytes_find(const char* hay, size_t n, const char* needle, size_t m); // -1 if absent
+size_t bread_bytes_count(const char* hay, size_t n, const char* needle, size_t m);  // non-overlapping
+
+// "scalar", "sse2" or "avx2"; set returns 0 if the CPU lacks it
+const char* bread_bytes_kernel(void);
+int bread_bytes_set_kernel(const char* name);
+
+#endif
@@ -4,6 +4,8 @@
 #include "runtime/runtime.h"
 
 int bread_add(const BreadValue* left, const BreadValue* right, BreadValue* out);
+int bread_concat_op(BreadValue** parts, int32_t count, BreadValue* out);
+int bread_append_op(BreadValue* target, BreadValue** parts, int32_t count);
 int bread_eq(const BreadValue* left, const BreadValue* right, int* out_bool);
 int bread_binary_op(char op, const BreadValue* left, const BreadValue* right, BreadValue* out);
 int bread_unary_not(const BreadValue* in, BreadValue* out);
@@ -21,6 +23,7 @@ void bread_value_set_optional(BreadValue* out, struct BreadOptional* o);
 void bread_value_set_struct(BreadValue* out, struct BreadStruct* s);
 size_t bread_value_size(void);
 void bread_value_copy(const BreadValue* in, BreadValue* out);
+void bread_value_store(const BreadValue* in, BreadValue* out);
 void bread_value_release_value(BreadValue* v);
 int bread_is_truthy(const BreadValue* v);
 int bread_coerce_value(VarType target, const BreadValue* in, BreadValue* out);
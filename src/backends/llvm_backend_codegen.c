@@ -45,6 +45,14 @@ static void cg_init_basic_types(Cg* cg) {
     cg->value_ptr_type = LLVMPointerType(cg->value_type, 0);
 }
 
+static const char* g_alloc_profile_path = NULL;
+static size_t g_alloc_profile_sample = 0;
+
+void bread_llvm_set_alloc_profile(const char* path, size_t sample_bytes) {
+    g_alloc_profile_path = path;
+    g_alloc_profile_sample = sample_bytes;
+}
+
 static void cg_init_state(Cg* cg) {
     cg->loop_depth = 0;
     cg->tmp_counter = 0;
@@ -54,6 +62,8 @@ static void cg_init_state(Cg* cg) {
     cg->global_scope = NULL;
     cg->scope_depth = 0;
     cg->had_error = 0;
+    cg->alloc_profile = g_alloc_profile_path != NULL;
+    cg->alloc_site_loc = NULL;
 }
 
 static void cg_declare_runtime_functions(Cg* cg) {
@@ -67,11 +77,22 @@ static void cg_declare_runtime_functions(Cg* cg) {
         {"bread_value_set_array", &cg->ty_value_set_array, &cg->fn_value_set_array, cg->void_ty, (LLVMTypeRef[]){cg->i8_ptr, cg->i8_ptr}, 2, 0},
         {"bread_value_set_dict", &cg->ty_value_set_dict, &cg->fn_value_set_dict, cg->void_ty, (LLVMTypeRef[]){cg->i8_ptr, cg->i8_ptr}, 2, 0},
         {"bread_value_copy", &cg->ty_value_copy, &cg->fn_value_copy, cg->void_ty, (LLVMTypeRef[]){cg->i8_ptr, cg->i8_ptr}, 2, 0},
+        {"bread_value_store", &cg->ty_value_store, &cg->fn_value_store, cg->void_ty, (LLVMTypeRef[]){cg->i8_ptr, cg->i8_ptr}, 2, 0},
+        {"bread_memory_nursery_mark", &cg->ty_nursery_mark, &cg->fn_nursery_mark, cg->i64, NULL, 0, 0},
+        {"bread_memory_nursery_reset", &cg->ty_nursery_reset, &cg->fn_nursery_reset, cg->void_ty, (LLVMTypeRef[]){cg->i64}, 1, 0},
+        {"bread_memory_arena_enter", &cg->ty_arena_enter, &cg->fn_arena_enter, cg->i64, NULL, 0, 0},
+        {"bread_memory_arena_leave", &cg->ty_arena_leave, &cg->fn_arena_leave, cg->void_ty, (LLVMTypeRef[]){cg->i64}, 1, 0},
+        {"bread_alloc_profile_set_site", &cg->ty_alloc_site, &cg->fn_alloc_site, cg->void_ty, (LLVMTypeRef[]){cg->i8_ptr, cg->i32, cg->i32}, 3, 0},
+        {"bread_alloc_profile_site", &cg->ty_alloc_site_get, &cg->fn_alloc_site_get, cg->i32, NULL, 0, 0},
+        {"bread_alloc_profile_restore_site", &cg->ty_alloc_site_restore, &cg->fn_alloc_site_restore, cg->void_ty, (LLVMTypeRef[]){cg->i32}, 1, 0},
+        {"bread_alloc_profile_start", &cg->ty_alloc_profile_start, &cg->fn_alloc_profile_start, cg->void_ty, (LLVMTypeRef[]){cg->i8_ptr, cg->i64}, 2, 0},
         {"bread_value_release_value", &cg->ty_value_release, &cg->fn_value_release, cg->void_ty, (LLVMTypeRef[]){cg->i8_ptr}, 1, 0},
         {"bread_print", &cg->ty_print, &cg->fn_print, cg->void_ty, (LLVMTypeRef[]){cg->i8_ptr}, 1, 0},
         {"bread_is_truthy", &cg->ty_is_truthy, &cg->fn_is_truthy, cg->i32, (LLVMTypeRef[]){cg->i8_ptr}, 1, 0},
         {"bread_unary_not", &cg->ty_unary_not, &cg->fn_unary_not, cg->i32, (LLVMTypeRef[]){cg->i8_ptr, cg->i8_ptr}, 2, 0},
         {"bread_binary_op", &cg->ty_binary_op, &cg->fn_binary_op, cg->i32, (LLVMTypeRef[]){cg->i8, cg->i8_ptr, cg->i8_ptr, cg->i8_ptr}, 4, 0},
+        {"bread_concat_op", &cg->ty_concat_op, &cg->fn_concat_op, cg->i32, (LLVMTypeRef[]){cg->i8_ptr, cg->i32, cg->i8_ptr}, 3, 0},
+        {"bread_append_op", &cg->ty_append_op, &cg->fn_append_op, cg->i32, (LLVMTypeRef[]){cg->i8_ptr, cg->i8_ptr, cg->i32}, 3, 0},
         {"bread_index_op", &cg->ty_index_op, &cg->fn_index_op, cg->i32, (LLVMTypeRef[]){cg->i8_ptr, cg->i8_ptr, cg->i8_ptr}, 3, 0},
         {"bread_index_set_op", &cg->ty_index_set_op, &cg->fn_index_set_op, cg->i32, (LLVMTypeRef[]){cg->i8_ptr, cg->i8_ptr, cg->i8_ptr}, 3, 0},
         {"bread_member_op", &cg->ty_member_op, &cg->fn_member_op, cg->i32, (LLVMTypeRef[]){cg->i8_ptr, cg->i8_ptr, cg->i32, cg->i8_ptr}, 4, 0},
@@ -82,6 +103,7 @@ static void cg_declare_runtime_functions(Cg* cg) {
         {"bread_var_decl", &cg->ty_var_decl, &cg->fn_var_decl, cg->i32, (LLVMTypeRef[]){cg->i8_ptr, cg->i32, cg->i32, cg->i8_ptr}, 4, 0},
         {"bread_var_decl_if_missing", &cg->ty_var_decl_if_missing, &cg->fn_var_decl_if_missing, cg->i32, (LLVMTypeRef[]){cg->i8_ptr, cg->i32, cg->i32, cg->i8_ptr}, 4, 0},
         {"bread_var_assign", &cg->ty_var_assign, &cg->fn_var_assign, cg->i32, (LLVMTypeRef[]){cg->i8_ptr, cg->i8_ptr}, 2, 0},
+        {"bread_var_append", &cg->ty_var_append, &cg->fn_var_append, cg->i32, (LLVMTypeRef[]){cg->i8_ptr, cg->i8_ptr, cg->i32}, 3, 0},
         {"bread_var_load", &cg->ty_var_load, &cg->fn_var_load, cg->i32, (LLVMTypeRef[]){cg->i8_ptr, cg->i8_ptr}, 2, 0},
         {"bread_push_scope", &cg->ty_push_scope, &cg->fn_push_scope, cg->void_ty, NULL, 0, 0},
         {"bread_pop_scope", &cg->ty_pop_scope, &cg->fn_pop_scope, cg->void_ty, NULL, 0, 0},
@@ -101,8 +123,10 @@ static void cg_declare_runtime_functions(Cg* cg) {
         {"init_functions", &cg->ty_init_functions, &cg->fn_init_functions, cg->void_ty, NULL, 0, 0},
         {"cleanup_functions", &cg->ty_cleanup_functions, &cg->fn_cleanup_functions, cg->void_ty, NULL, 0, 0},
         {"bread_array_new", &cg->ty_array_new, &cg->fn_array_new, cg->i8_ptr, NULL, 0, 0},
+        {"bread_array_new_in_arena", &cg->ty_array_new_arena, &cg->fn_array_new_arena, cg->i8_ptr, NULL, 0, 0},
         {"bread_array_release", &cg->ty_array_release, &cg->fn_array_release, cg->void_ty, (LLVMTypeRef[]){cg->i8_ptr}, 1, 0},
         {"bread_dict_new", &cg->ty_dict_new, &cg->fn_dict_new, cg->i8_ptr, NULL, 0, 0},
+        {"bread_dict_new_in_arena", &cg->ty_dict_new_arena, &cg->fn_dict_new_arena, cg->i8_ptr, NULL, 0, 0},
         {"bread_dict_release", &cg->ty_dict_release, &cg->fn_dict_release, cg->void_ty, (LLVMTypeRef[]){cg->i8_ptr}, 1, 0},
         {"bread_value_dict_keys_as_value", &cg->ty_dict_keys, &cg->fn_dict_keys, cg->i32, (LLVMTypeRef[]){cg->i8_ptr, cg->i8_ptr}, 2, 0},
         {"bread_string_create", &cg->ty_string_create, &cg->fn_string_create, cg->i8_ptr, (LLVMTypeRef[]){cg->i8_ptr, cg->i64}, 2, 0},
@@ -179,6 +203,14 @@ static void emit_runtime_init_calls(Cg* cg, LLVMBuilderRef builder) {
     for (size_t i = 0; i < sizeof(init_calls) / sizeof(init_calls[0]); i++) {
         LLVMBuildCall2(builder, init_calls[i].ty, init_calls[i].fn, NULL, 0, "");
     }
+
+    if (cg->alloc_profile) {
+        LLVMValueRef args[] = {
+            cg_get_string_ptr(cg, g_alloc_profile_path),
+            LLVMConstInt(cg->i64, g_alloc_profile_sample, 0)
+        };
+        LLVMBuildCall2(builder, cg->ty_alloc_profile_start, cg->fn_alloc_profile_start, args, 2, "");
+    }
 }
 
 static void emit_runtime_cleanup_calls(Cg* cg, LLVMBuilderRef builder) {
@@ -189,9 +221,9 @@ static void emit_runtime_cleanup_calls(Cg* cg, LLVMBuilderRef builder) {
         {cg->fn_bread_error_cleanup, cg->ty_bread_error_cleanup},
         {cg->fn_bread_builtin_cleanup, cg->ty_bread_builtin_cleanup},
         {cg->fn_bread_string_intern_cleanup, cg->ty_bread_string_intern_cleanup},
-        {cg->fn_bread_memory_cleanup, cg->ty_bread_memory_cleanup},
         {cg->fn_cleanup_functions, cg->ty_cleanup_functions},
-        {cg->fn_cleanup_variables, cg->ty_cleanup_variables}
+        {cg->fn_cleanup_variables, cg->ty_cleanup_variables},
+        {cg->fn_bread_memory_cleanup, cg->ty_bread_memory_cleanup}
     };
 
     for (size_t i = 0; i < sizeof(cleanup_calls) / sizeof(cleanup_calls[0]); i++) {
@@ -319,6 +351,8 @@ int bread_llvm_generate_function_bodies(Cg* cg, LLVMBuilderRef builder, LLVMValu
         f->ret_slot = LLVMGetParam(f->fn, 0);
         setup_function_scope(cg, f, builder);
         setup_function_parameters(cg, f, builder);
+        cg_arena_enter(cg, f);
+        cg_alloc_site_save(cg, f);
 
         if (!cg_build_stmt_list(cg, f, val_size, f->body)) {
             return 0;
@@ -326,6 +360,8 @@ int bread_llvm_generate_function_bodies(Cg* cg, LLVMBuilderRef builder, LLVMValu
         
         if (!LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(builder))) {
             cleanup_function_scope(cg, f, builder);
+            cg_arena_leave(cg, f);
+            cg_alloc_site_restore(cg, f);
             LLVMBuildRetVoid(builder);
         }
     }
@@ -372,12 +408,14 @@ static int generate_method_body(Cg* cg, LLVMBuilderRef builder, LLVMValueRef met
     LLVMValueRef self_param = LLVMGetParam(method_fn, 1);
     setup_method_self_parameter(cg, builder, self_param, temp_fn.scope);
     setup_method_parameters(cg, builder, method_fn, method->param_names, method->param_count, temp_fn.scope);
+    cg_alloc_site_save(cg, &temp_fn);
     
     if (!cg_build_stmt_list(cg, &temp_fn, val_size, method->body)) {
         return 0;
     }
     
     if (!LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(builder))) {
+        cg_alloc_site_restore(cg, &temp_fn);
         LLVMBuildRetVoid(builder);
     }
     
@@ -248,6 +248,7 @@ static void ensure_function_terminator(Cg* cg, LLVMBuilderRef builder, CgFunctio
     LLVMValueRef pop_args[] = { safe_depth };
     (void)LLVMBuildCall2(builder, cg->ty_pop_to_scope_depth, cg->fn_pop_to_scope_depth, 
                          pop_args, 1, "");
+    cg_alloc_site_restore(cg, target_fn);
     LLVMBuildRetVoid(builder);
 }
 
@@ -314,6 +315,8 @@ int bread_llvm_jit_function(Function* fn) {
         return 0;
     }
 
+    cg_alloc_site_save(&cg, target_fn);
+
     LLVMValueRef val_size = cg_value_size(&cg);
     if (!cg_build_stmt_list(&cg, target_fn, val_size, target_fn->body)) {
         fprintf(stderr, "Error: Failed to generate body for function '%s'\n", fn->name);
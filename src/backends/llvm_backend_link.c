@@ -39,10 +39,15 @@ static const char* BREAD_RUNTIME_SOURCES[] = {
     // runtime
     "src/runtime/runtime.c",
     "src/runtime/memory.c",
+    "src/runtime/alloc_profile.c",
     "src/runtime/print.c",
     "src/runtime/string_ops.c",
+    "src/runtime/string_search.c",
+    "src/runtime/number_format.c",
+    "src/runtime/number_parse.c",
     "src/runtime/operators.c",
     "src/runtime/array_utils.c",
+    "src/runtime/array_reduce.c",
     "src/runtime/value_ops.c",
     "src/runtime/builtins.c",
     "src/runtime/error.c",
@@ -100,7 +105,7 @@ int bread_llvm_link_executable_with_clang(const char* obj_path,
     len += snprintf(
         cmd + len,
         cap - len,
-        "clang -std=c11 -O2 -g -fPIC -lm "
+        "clang -std=c11 -O2 -g -fPIC -pthread "
         "-I'%s/breadlang/include' "
         "-o '%s' '%s'",
         root_dir,
@@ -133,6 +138,9 @@ int bread_llvm_link_executable_with_clang(const char* obj_path,
         append_arg(&cmd, &cap, &len, full_path);
     }
 
+    // libraries go after the sources that use them
+    append_arg(&cmd, &cap, &len, "-lm");
+
     if (getenv("BREAD_DEBUG_LINK")) {
         printf("BreadLang link command:\n%s\n", cmd);
     }
@@ -1,5 +1,87 @@
 #include "codegen_internal.h"
 
+// Literals the escape analysis confined to the current call
+static int cg_in_arena(const CgFunction* cg_fn, ASTExpr* expr) {
+    return cg_fn && cg_fn->arena_mark_slot && escape_analysis_is_arena_site(expr);
+}
+
+// Operands of a left-leaning `a + b + c ...` chain, in evaluation order.
+// The caller frees the returned array.
+int cg_add_chain(ASTExpr* expr, ASTExpr*** out_leaves) {
+    int count = 1;
+    for (ASTExpr* e = expr; e->kind == AST_EXPR_BINARY && e->as.binary.op == '+'; e = e->as.binary.left) {
+        count++;
+    }
+    ASTExpr** leaves = malloc((size_t)count * sizeof(ASTExpr*));
+    if (!leaves) return 0;
+
+    ASTExpr* e = expr;
+    for (int i = count - 1; i > 0; i--) {
+        leaves[i] = e->as.binary.right;
+        e = e->as.binary.left;
+    }
+    leaves[0] = e;
+    *out_leaves = leaves;
+    return count;
+}
+
+static int cg_is_string_operand(const ASTExpr* e) {
+    if (e->kind == AST_EXPR_STRING || e->kind == AST_EXPR_STRING_LITERAL) return 1;
+    if (e->tag.is_known && e->tag.type == TYPE_STRING) return 1;
+    // interpolation segments
+    return e->kind == AST_EXPR_CALL && e->as.call.name && strcmp(e->as.call.name, "str") == 0;
+}
+
+// Evaluates each expression and returns an i8* to an array of pointers to
+// the resulting values.
+LLVMValueRef cg_build_value_ptrs(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, ASTExpr** exprs, int count) {
+    LLVMTypeRef arr_ty = LLVMArrayType(cg->i8_ptr, (unsigned)count);
+    LLVMValueRef arr = cg_entry_alloca(cg, arr_ty, "value_ptrs");
+    for (int i = 0; i < count; i++) {
+        LLVMValueRef value = cg_build_expr(cg, cg_fn, val_size, exprs[i]);
+        if (!value) return NULL;
+        LLVMValueRef slot = LLVMBuildGEP2(cg->builder, arr_ty, arr,
+                                          (LLVMValueRef[]){LLVMConstInt(cg->i32, 0, 0), LLVMConstInt(cg->i32, i, 0)},
+                                          2, "value_ptr_slot");
+        LLVMBuildStore(cg->builder, cg_value_to_i8_ptr(cg, value), slot);
+    }
+    return LLVMBuildBitCast(cg->builder, arr, cg->i8_ptr, "value_ptrs_i8");
+}
+
+// Three or more operands with a string among them are joined by one call
+// that sizes the result once, instead of one intermediate per `+`.
+// Interpolated strings parse into exactly such chains.
+// Returns 0 when the chain does not qualify; otherwise *out is the result,
+// NULL on error.
+static int cg_build_concat_chain(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, ASTExpr* expr,
+                                 LLVMValueRef* out) {
+    ASTExpr** leaves = NULL;
+    int count = cg_add_chain(expr, &leaves);
+    if (count < 3) {
+        free(leaves);
+        return 0;
+    }
+    int has_string = 0;
+    for (int i = 0; i < count && !has_string; i++) {
+        has_string = cg_is_string_operand(leaves[i]);
+    }
+    if (!has_string) {
+        free(leaves);
+        return 0;
+    }
+
+    *out = NULL;
+    LLVMValueRef parts = cg_build_value_ptrs(cg, cg_fn, val_size, leaves, count);
+    free(leaves);
+    if (!parts) return 1;
+
+    LLVMValueRef tmp = cg_alloc_value(cg, "concattmp");
+    LLVMValueRef args[] = {parts, LLVMConstInt(cg->i32, (unsigned long long)count, 0), cg_value_to_i8_ptr(cg, tmp)};
+    (void)LLVMBuildCall2(cg->builder, cg->ty_concat_op, cg->fn_concat_op, args, 3, "");
+    *out = tmp;
+    return 1;
+}
+
 LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, ASTExpr* expr) {
     LLVMValueRef tmp;
 
@@ -50,26 +132,10 @@ LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, AST
             LLVMValueRef dbl_args[] = {cg_value_to_i8_ptr(cg, tmp), d};
             (void)LLVMBuildCall2(cg->builder, cg->ty_value_set_double, cg->fn_value_set_double, dbl_args, 2, "");
             return tmp;
-        case AST_EXPR_STRING: {
-            tmp = cg_alloc_value(cg, "strtmp");
-            const char* s = expr->as.string_val ? expr->as.string_val : "";
-            LLVMValueRef ptr = cg_get_string_ptr(cg, s);
-            LLVMValueRef str_args[] = {cg_value_to_i8_ptr(cg, tmp), ptr};
-            (void)LLVMBuildCall2(cg->builder, cg->ty_value_set_string, cg->fn_value_set_string, str_args, 2, "");
-            return tmp;
-        }
-        case AST_EXPR_STRING_LITERAL: {
-            tmp = cg_alloc_value(cg, "strlittmp");
-            const char* s = expr->as.string_literal.value ? expr->as.string_literal.value : "";
-            
-            // llvm string const
-            LLVMValueRef ptr = cg_get_string_ptr(cg, s);
-            
-            // I love bread value
-            LLVMValueRef str_args[] = {cg_value_to_i8_ptr(cg, tmp), ptr};
-            (void)LLVMBuildCall2(cg->builder, cg->ty_value_set_string, cg->fn_value_set_string, str_args, 2, "");
-            return tmp;
-        }
+        case AST_EXPR_STRING:
+            return cg_build_string_literal(cg, expr->as.string_val, "strtmp");
+        case AST_EXPR_STRING_LITERAL:
+            return cg_build_string_literal(cg, expr->as.string_literal.value, "strlittmp");
         case AST_EXPR_VAR: {
             CgVar* var = NULL;
             if (cg_fn) {
@@ -183,10 +249,12 @@ LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, AST
             
             // Handle concatanation. Muy especial. 
             if (expr->as.binary.op == '+') {
+                if (cg_build_concat_chain(cg, cg_fn, val_size, expr, &tmp)) return tmp;
+                
                 int left_is_builtin = (expr->as.binary.left->kind == AST_EXPR_CALL && 
-                                     bread_builtin_lookup(expr->as.binary.left->as.call.name) != NULL);
+                                     cg_find_builtin(cg, expr->as.binary.left->as.call.name) != NULL);
                 int right_is_builtin = (expr->as.binary.right->kind == AST_EXPR_CALL && 
-                                       bread_builtin_lookup(expr->as.binary.right->as.call.name) != NULL);
+                                       cg_find_builtin(cg, expr->as.binary.right->as.call.name) != NULL);
                 
                 if (left_is_builtin || right_is_builtin) {
                     LLVMValueRef left = cg_build_expr(cg, cg_fn, val_size, expr->as.binary.left);
@@ -418,7 +486,7 @@ LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, AST
                         LLVMValueRef args_ptr = LLVMConstNull(cg->i8_ptr);
                         if (expr->as.method_call.arg_count > 0) {
                             LLVMTypeRef args_arr_ty = LLVMArrayType(cg->value_type, (unsigned)expr->as.method_call.arg_count);
-                            LLVMValueRef args_alloca = LLVMBuildAlloca(cg->builder, args_arr_ty, "super_init_args");
+                            LLVMValueRef args_alloca = cg_entry_alloca(cg, args_arr_ty, "super_init_args");
                             LLVMSetAlignment(args_alloca, 16);
 
                             for (int i = 0; i < expr->as.method_call.arg_count; i++) {
@@ -540,7 +608,7 @@ LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, AST
                 LLVMValueRef args_ptr = LLVMConstNull(cg->i8_ptr);
                 if (expr->as.method_call.arg_count > 0) {
                     LLVMTypeRef args_arr_ty = LLVMArrayType(cg->value_type, (unsigned)expr->as.method_call.arg_count);
-                    LLVMValueRef args_alloca = LLVMBuildAlloca(cg->builder, args_arr_ty, "method_args");
+                    LLVMValueRef args_alloca = cg_entry_alloca(cg, args_arr_ty, "method_args");
                     LLVMSetAlignment(args_alloca, 16);
 
                     for (int i = 0; i < expr->as.method_call.arg_count; i++) {
@@ -618,7 +686,7 @@ LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, AST
                         step_int = LLVMBuildCall2(cg->builder, cg->ty_value_get_int, cg->fn_value_get_int, 
                                                  (LLVMValueRef[]){cg_value_to_i8_ptr(cg, step_val)}, 1, "range_step");
                     } else {
-                        step_int = LLVMConstInt(cg->i32, 1, 0); // default step = 1
+                        step_int = LLVMConstInt(cg->i64, 1, 0); // default step = 1
                     }
                     
                     LLVMValueRef range_array = LLVMBuildCall2(cg->builder, cg->ty_range_create, cg->fn_range_create,
@@ -631,7 +699,7 @@ LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, AST
                 return tmp;
             }
 
-            const BuiltinFunction* builtin = bread_builtin_lookup(expr->as.call.name);
+            const BuiltinFunction* builtin = cg_find_builtin(cg, expr->as.call.name);
             if (builtin) {
                 if (builtin->param_count != expr->as.call.arg_count) {
                     fprintf(stderr, "Error: Built-in function '%s' expects %d arguments, got %d\n", 
@@ -669,7 +737,7 @@ LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, AST
                 LLVMValueRef args_ptr = NULL;
                 if (expr->as.call.arg_count > 0) {
                     LLVMTypeRef args_arr_ty = LLVMArrayType(cg->value_type, (unsigned)expr->as.call.arg_count);
-                    LLVMValueRef args_arr = LLVMBuildAlloca(cg->builder, args_arr_ty, "builtin.args");
+                    LLVMValueRef args_arr = cg_entry_alloca(cg, args_arr_ty, "builtin.args");
                     LLVMSetAlignment(args_arr, 16);
 
                     LLVMValueRef zero = LLVMConstInt(cg->i32, 0, 0);
@@ -737,7 +805,7 @@ LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, AST
                 
                 if (total_field_count > 0) {
                     LLVMTypeRef field_names_arr_ty = LLVMArrayType(cg->i8_ptr, (unsigned)total_field_count);
-                    LLVMValueRef field_names_arr = LLVMBuildAlloca(cg->builder, field_names_arr_ty, "class_field_names");
+                    LLVMValueRef field_names_arr = cg_entry_alloca(cg, field_names_arr_ty, "class_field_names");
                     
                     for (int i = 0; i < total_field_count; i++) {
                         LLVMValueRef field_name_str = cg_get_string_global(cg, all_field_names[i]);
@@ -784,7 +852,7 @@ LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, AST
                 LLVMValueRef method_count = LLVMConstInt(cg->i32, callee_class->method_count, 0);
                 if (callee_class->method_count > 0) {
                     LLVMTypeRef method_names_arr_ty = LLVMArrayType(cg->i8_ptr, (unsigned)callee_class->method_count);
-                    LLVMValueRef method_names_arr = LLVMBuildAlloca(cg->builder, method_names_arr_ty, "class_method_names");
+                    LLVMValueRef method_names_arr = cg_entry_alloca(cg, method_names_arr_ty, "class_method_names");
                     
                     for (int i = 0; i < callee_class->method_count; i++) {
                         LLVMValueRef method_name_str = cg_get_string_global(cg, callee_class->method_names[i]);
@@ -841,7 +909,7 @@ LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, AST
                     LLVMValueRef args_ptr = LLVMConstNull(cg->i8_ptr);
                     if (final_argc > 0) {
                         LLVMTypeRef args_arr_ty = LLVMArrayType(cg->value_type, (unsigned)final_argc);
-                        LLVMValueRef args_alloca = LLVMBuildAlloca(cg->builder, args_arr_ty, "constructor_args");
+                        LLVMValueRef args_alloca = cg_entry_alloca(cg, args_arr_ty, "constructor_args");
                         LLVMSetAlignment(args_alloca, 16);
 
                         for (int i = 0; i < final_argc; i++) {
@@ -937,7 +1005,9 @@ LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, AST
         case AST_EXPR_ARRAY_LITERAL: {
             tmp = cg_alloc_value(cg, "arraylittmp");
             
-            LLVMValueRef array_ptr = LLVMBuildCall2(cg->builder, cg->ty_array_new, cg->fn_array_new, NULL, 0, "");
+            LLVMValueRef array_ptr = cg_in_arena(cg_fn, expr)
+                ? LLVMBuildCall2(cg->builder, cg->ty_array_new_arena, cg->fn_array_new_arena, NULL, 0, "")
+                : LLVMBuildCall2(cg->builder, cg->ty_array_new, cg->fn_array_new, NULL, 0, "");
             for (int i = 0; i < expr->as.array_literal.element_count; i++) {
                 CgValue elem_unboxed = cg_build_expr_unboxed(cg, cg_fn, expr->as.array_literal.elements[i]);
                 LLVMValueRef elem_val = NULL;
@@ -962,7 +1032,9 @@ LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, AST
         case AST_EXPR_DICT: {
             tmp = cg_alloc_value(cg, "dicttmp");
 
-            LLVMValueRef dict_ptr = LLVMBuildCall2(cg->builder, cg->ty_dict_new, cg->fn_dict_new, NULL, 0, "");
+            LLVMValueRef dict_ptr = cg_in_arena(cg_fn, expr)
+                ? LLVMBuildCall2(cg->builder, cg->ty_dict_new_arena, cg->fn_dict_new_arena, NULL, 0, "")
+                : LLVMBuildCall2(cg->builder, cg->ty_dict_new, cg->fn_dict_new, NULL, 0, "");
 
             for (int i = 0; i < expr->as.dict.entry_count; i++) {
                 ASTDictEntry* entry = &expr->as.dict.entries[i];
@@ -993,7 +1065,7 @@ LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, AST
             LLVMValueRef field_names_ptr = LLVMConstNull(i8_ptr_ptr);
             if (expr->as.struct_literal.field_count > 0) {
                 LLVMTypeRef field_names_arr_ty = LLVMArrayType(cg->i8_ptr, (unsigned)expr->as.struct_literal.field_count);
-                LLVMValueRef field_names_arr = LLVMBuildAlloca(cg->builder, field_names_arr_ty, "struct_field_names");
+                LLVMValueRef field_names_arr = cg_entry_alloca(cg, field_names_arr_ty, "struct_field_names");
                 
                 for (int i = 0; i < expr->as.struct_literal.field_count; i++) {
                     LLVMValueRef field_name_str = cg_get_string_global(cg, expr->as.struct_literal.field_names[i]);
@@ -1025,7 +1097,8 @@ LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, AST
                 3,
                 0
             );
-            LLVMValueRef fn_struct_new = cg_declare_fn(cg, "bread_struct_new", ty_struct_new);
+            LLVMValueRef fn_struct_new = cg_declare_fn(cg,
+                cg_in_arena(cg_fn, expr) ? "bread_struct_new_in_arena" : "bread_struct_new", ty_struct_new);
             
             LLVMValueRef field_count = LLVMConstInt(cg->i32, expr->as.struct_literal.field_count, 0);
             LLVMValueRef struct_ptr = LLVMBuildCall2(cg->builder, ty_struct_new, fn_struct_new,
@@ -1078,7 +1151,7 @@ LLVMValueRef cg_build_expr(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, AST
             LLVMValueRef field_names_ptr = LLVMConstNull(i8_ptr_ptr);
             if (expr->as.class_literal.field_count > 0) {
                 LLVMTypeRef field_names_arr_ty = LLVMArrayType(cg->i8_ptr, (unsigned)expr->as.class_literal.field_count);
-                LLVMValueRef field_names_arr = LLVMBuildAlloca(cg->builder, field_names_arr_ty, "class_field_names");
+                LLVMValueRef field_names_arr = cg_entry_alloca(cg, field_names_arr_ty, "class_field_names");
                 
                 for (int i = 0; i < expr->as.class_literal.field_count; i++) {
                     LLVMValueRef field_name_str = cg_get_string_global(cg, expr->as.class_literal.field_names[i]);
@@ -18,11 +18,28 @@ static unsigned cg_value_alignment(Cg* cg) {
     return LLVMABIAlignmentOfType(td, cg->value_type);
 }
 
+// Slots go at the top of the entry block, so a loop body reuses the same
+// ones every iteration instead of growing the stack.
+LLVMValueRef cg_entry_alloca(Cg* cg, LLVMTypeRef type, const char* name) {
+    LLVMValueRef fn = LLVMGetBasicBlockParent(LLVMGetInsertBlock(cg->builder));
+    LLVMBasicBlockRef entry = LLVMGetEntryBasicBlock(fn);
+    LLVMValueRef first = LLVMGetFirstInstruction(entry);
+
+    LLVMBuilderRef builder = LLVMCreateBuilderInContext(LLVMGetModuleContext(cg->mod));
+    if (first) {
+        LLVMPositionBuilderBefore(builder, first);
+    } else {
+        LLVMPositionBuilderAtEnd(builder, entry);
+    }
+    LLVMValueRef slot = LLVMBuildAlloca(builder, type, name ? name : "");
+    LLVMDisposeBuilder(builder);
+    return slot;
+}
+
 LLVMValueRef cg_alloc_value(Cg* cg, const char* name) {
     if (!cg || !cg->builder) return NULL;
 
-    LLVMValueRef alloca =
-        LLVMBuildAlloca(cg->builder, cg->value_type, name ? name : "");
+    LLVMValueRef alloca = cg_entry_alloca(cg, cg->value_type, name);
 
     LLVMSetAlignment(alloca, cg_value_alignment(cg));
 
@@ -66,6 +83,80 @@ void cg_copy_value_into(Cg* cg, LLVMValueRef dst, LLVMValueRef src) {
     );
 }
 
+// For slots that outlive the statement (variables): young values are
+// promoted out of the nursery.
+void cg_store_value_into(Cg* cg, LLVMValueRef dst, LLVMValueRef src) {
+    if (!cg || !dst || !src) return;
+
+    LLVMValueRef args[] = {
+        cg_value_to_i8_ptr(cg, src),
+        cg_value_to_i8_ptr(cg, dst),
+    };
+
+    LLVMBuildCall2(cg->builder, cg->ty_value_store, cg->fn_value_store, args, 2, "");
+}
+
+LLVMValueRef cg_nursery_mark(Cg* cg) {
+    return LLVMBuildCall2(cg->builder, cg->ty_nursery_mark, cg->fn_nursery_mark, NULL, 0, "nursery.mark");
+}
+
+// Frees the temporaries of everything emitted since `mark`, unless the
+// current block already left through a return, break or continue.
+void cg_nursery_reset(Cg* cg, LLVMValueRef mark) {
+    if (!mark || LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(cg->builder))) return;
+
+    LLVMValueRef args[] = {mark};
+    LLVMBuildCall2(cg->builder, cg->ty_nursery_reset, cg->fn_nursery_reset, args, 1, "");
+}
+
+void cg_alloc_site(Cg* cg, const SourceLoc* loc) {
+    LLVMValueRef args[] = {
+        cg_get_string_ptr(cg, loc->filename ? loc->filename : "<input>"),
+        LLVMConstInt(cg->i32, (unsigned long long)loc->line, 0),
+        LLVMConstInt(cg->i32, (unsigned long long)loc->column, 0)
+    };
+    LLVMBuildCall2(cg->builder, cg->ty_alloc_site, cg->fn_alloc_site, args, 3, "");
+}
+
+// Opens a call arena frame when the escape analysis placed any of the
+// function's literals in it.
+void cg_arena_enter(Cg* cg, CgFunction* cg_fn) {
+    if (!cg_fn || !escape_analysis_body_uses_arena(cg_fn->body)) return;
+
+    LLVMValueRef mark = LLVMBuildCall2(cg->builder, cg->ty_arena_enter, cg->fn_arena_enter, NULL, 0, "arena.mark");
+    cg_fn->arena_mark_slot = LLVMBuildAlloca(cg->builder, cg->i64, "arena.mark.slot");
+    LLVMBuildStore(cg->builder, mark, cg_fn->arena_mark_slot);
+}
+
+// Emitted on every return path, after the runtime scope is popped so no
+// variable still refers to an arena object.
+void cg_arena_leave(Cg* cg, CgFunction* cg_fn) {
+    if (!cg_fn || !cg_fn->arena_mark_slot) return;
+
+    LLVMValueRef mark = LLVMBuildLoad2(cg->builder, cg->i64, cg_fn->arena_mark_slot, "");
+    LLVMValueRef args[] = {mark};
+    LLVMBuildCall2(cg->builder, cg->ty_arena_leave, cg->fn_arena_leave, args, 1, "");
+}
+
+// Profiling builds save the caller's allocation site at entry and put it
+// back on every return path, next to cg_arena_leave, so what the calling
+// statement allocates after the call is still charged to it.
+void cg_alloc_site_save(Cg* cg, CgFunction* cg_fn) {
+    if (!cg->alloc_profile || !cg_fn) return;
+
+    LLVMValueRef site = LLVMBuildCall2(cg->builder, cg->ty_alloc_site_get, cg->fn_alloc_site_get, NULL, 0, "alloc.site");
+    cg_fn->alloc_site_slot = cg_entry_alloca(cg, cg->i32, "alloc.site.slot");
+    LLVMBuildStore(cg->builder, site, cg_fn->alloc_site_slot);
+}
+
+void cg_alloc_site_restore(Cg* cg, CgFunction* cg_fn) {
+    if (!cg_fn || !cg_fn->alloc_site_slot) return;
+
+    LLVMValueRef site = LLVMBuildLoad2(cg->builder, cg->i32, cg_fn->alloc_site_slot, "");
+    LLVMValueRef args[] = {site};
+    LLVMBuildCall2(cg->builder, cg->ty_alloc_site_restore, cg->fn_alloc_site_restore, args, 1, "");
+}
+
 LLVMValueRef cg_clone_value(Cg* cg, LLVMValueRef src, const char* name) {
     if (!cg || !src) return NULL;
 
@@ -129,3 +220,111 @@ LLVMValueRef cg_get_string_ptr(Cg* cg, const char* s) {
     
     return LLVMBuildBitCast(cg->builder, gep, cg->i8_ptr, "str_ptr");
 }
+
+static void cg_literal_pad(Cg* cg, LLVMTypeRef* types, LLVMValueRef* vals, unsigned* n, size_t* at, size_t to) {
+    if (to <= *at) return;
+    types[*n] = LLVMArrayType(cg->i8, (unsigned)(to - *at));
+    vals[*n] = LLVMConstNull(types[*n]);
+    (*n)++;
+    *at = to;
+}
+
+static void cg_literal_field(LLVMTypeRef* types, LLVMValueRef* vals, unsigned* n, size_t* at, LLVMValueRef v,
+                             size_t size) {
+    types[*n] = LLVMTypeOf(v);
+    vals[*n] = v;
+    (*n)++;
+    *at += size;
+}
+
+// Global names come from a 32-bit hash, so check a hit holds the same text
+static int cg_string_object_holds(LLVMValueRef glob, const char* s, size_t len) {
+    LLVMValueRef init = LLVMGetInitializer(glob);
+    LLVMValueRef data = LLVMGetOperand(init, (unsigned)LLVMGetNumOperands(init) - 1);
+    size_t data_len = 0;
+    const char* bytes = LLVMGetAsString(data, &data_len);
+    return data_len == len + 1 && memcmp(bytes, s, len) == 0;
+}
+
+// cg_literal_pad only pads forward, so the object below relies on the
+// header being kind then refcount and on len, hash, flags and data
+// following in that order with exactly these widths
+_Static_assert(offsetof(BreadString, header) == 0 && offsetof(BreadObjHeader, kind) == 0 &&
+               offsetof(BreadObjHeader, refcount) == sizeof(uint32_t) &&
+               sizeof(BreadObjHeader) == 2 * sizeof(uint32_t),
+               "string literal header layout");
+_Static_assert(sizeof(((BreadString*)0)->len) == sizeof(size_t) &&
+               sizeof(((BreadString*)0)->hash) == sizeof(uint64_t) &&
+               sizeof(((BreadString*)0)->flags) == sizeof(uint32_t),
+               "string literal field widths");
+_Static_assert(offsetof(BreadString, len) >= sizeof(BreadObjHeader) &&
+               offsetof(BreadString, hash) >= offsetof(BreadString, len) + sizeof(size_t) &&
+               offsetof(BreadString, flags) >= offsetof(BreadString, hash) + sizeof(uint64_t) &&
+               offsetof(BreadString, data) >= offsetof(BreadString, flags) + sizeof(uint32_t),
+               "string literal field order");
+
+// An immortal BreadString for `s`, laid out field by field in read-only
+// data. The hash is computed now since nothing may write to the object.
+LLVMValueRef cg_get_string_object(Cg* cg, const char* s) {
+    if (!cg || !cg->mod) return NULL;
+    if (!s) s = "";
+
+    size_t len = strlen(s);
+    unsigned hash = fnv1a_hash(s);
+    char gname[64];
+    for (unsigned k = 0;; k++) {
+        snprintf(gname, sizeof(gname), "__bread_strobj_%08x_%u", hash, k);
+        LLVMValueRef existing = LLVMGetNamedGlobal(cg->mod, gname);
+        if (!existing) break;
+        if (cg_string_object_holds(existing, s, len)) return existing;
+    }
+
+    LLVMTypeRef size_ty = LLVMIntType((unsigned)(sizeof(size_t) * 8));
+    LLVMTypeRef types[9];
+    LLVMValueRef vals[9];
+    unsigned n = 0;
+    size_t at = 0;
+    cg_literal_field(types, vals, &n, &at, LLVMConstInt(cg->i32, BREAD_OBJ_STRING, 0), sizeof(uint32_t));
+    cg_literal_field(types, vals, &n, &at, LLVMConstInt(cg->i32, BREAD_REFCOUNT_IMMORTAL, 0), sizeof(uint32_t));
+    cg_literal_pad(cg, types, vals, &n, &at, offsetof(BreadString, len));
+    cg_literal_field(types, vals, &n, &at, LLVMConstInt(size_ty, len, 0), sizeof(size_t));
+    cg_literal_pad(cg, types, vals, &n, &at, offsetof(BreadString, hash));
+    cg_literal_field(types, vals, &n, &at, LLVMConstInt(cg->i64, bread_hash_bytes(s, len), 0), sizeof(uint64_t));
+    cg_literal_pad(cg, types, vals, &n, &at, offsetof(BreadString, flags));
+    uint32_t flags = len <= BREAD_STRING_SMALL_MAX ? BREAD_STRING_SMALL : 0;
+    cg_literal_field(types, vals, &n, &at, LLVMConstInt(cg->i32, flags, 0), sizeof(uint32_t));
+    cg_literal_pad(cg, types, vals, &n, &at, offsetof(BreadString, data));
+    cg_literal_field(types, vals, &n, &at, LLVMConstString(s, (unsigned)len, 0), len + 1);
+
+    LLVMValueRef glob = LLVMAddGlobal(cg->mod, LLVMStructType(types, n, 1), gname);
+    LLVMSetInitializer(glob, LLVMConstStruct(vals, n, 1));
+    LLVMSetLinkage(glob, LLVMPrivateLinkage);
+    LLVMSetGlobalConstant(glob, 1);
+    LLVMSetAlignment(glob, (unsigned)_Alignof(BreadString));
+    return glob;
+}
+
+// Evaluating a string literal: a String value pointing at its immortal
+// object, written with plain stores instead of a runtime call.
+LLVMValueRef cg_build_string_literal(Cg* cg, const char* s, const char* name) {
+    if (!cg || !cg->builder) return NULL;
+
+    LLVMValueRef obj = cg_get_string_object(cg, s);
+    if (!obj) return NULL;
+
+    LLVMValueRef tmp = cg_entry_alloca(cg, cg->value_type, name);
+    LLVMSetAlignment(tmp, cg_value_alignment(cg));
+    LLVMBuildStore(cg->builder, LLVMConstNull(cg->value_type), tmp);
+
+    LLVMValueRef base = cg_value_to_i8_ptr(cg, tmp);
+    LLVMValueRef type_at = LLVMConstInt(cg->i64, offsetof(BreadValue, type), 0);
+    LLVMValueRef type_slot = LLVMBuildInBoundsGEP2(cg->builder, cg->i8, base, &type_at, 1, "");
+    type_slot = LLVMBuildBitCast(cg->builder, type_slot, LLVMPointerType(cg->i32, 0), "");
+    LLVMBuildStore(cg->builder, LLVMConstInt(cg->i32, TYPE_STRING, 0), type_slot);
+
+    LLVMValueRef val_at = LLVMConstInt(cg->i64, offsetof(BreadValue, value), 0);
+    LLVMValueRef val_slot = LLVMBuildInBoundsGEP2(cg->builder, cg->i8, base, &val_at, 1, "");
+    val_slot = LLVMBuildBitCast(cg->builder, val_slot, LLVMPointerType(cg->i8_ptr, 0), "");
+    LLVMBuildStore(cg->builder, LLVMBuildBitCast(cg->builder, obj, cg->i8_ptr, ""), val_slot);
+    return tmp;
+}
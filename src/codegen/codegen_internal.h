@@ -9,14 +9,25 @@
 
 #include "runtime/builtins.h"
 #include "compiler/analysis/type_stability.h"
+#include "compiler/analysis/escape_analysis.h"
 
+LLVMValueRef cg_entry_alloca(Cg* cg, LLVMTypeRef type, const char* name);
 LLVMValueRef cg_alloc_value(Cg* cg, const char* name);
 LLVMValueRef cg_value_to_i8_ptr(Cg* cg, LLVMValueRef value_ptr);
 void cg_copy_value_into(Cg* cg, LLVMValueRef dst, LLVMValueRef src);
+void cg_store_value_into(Cg* cg, LLVMValueRef dst, LLVMValueRef src);
+LLVMValueRef cg_nursery_mark(Cg* cg);
+void cg_nursery_reset(Cg* cg, LLVMValueRef mark);
+void cg_alloc_site(Cg* cg, const SourceLoc* loc);
 LLVMValueRef cg_clone_value(Cg* cg, LLVMValueRef src, const char* name);
+int cg_add_chain(ASTExpr* expr, ASTExpr*** out_leaves);
+LLVMValueRef cg_build_value_ptrs(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, ASTExpr** exprs, int count);
 LLVMValueRef cg_get_string_global(Cg* cg, const char* s);
 LLVMValueRef cg_get_string_ptr(Cg* cg, const char* s);
+LLVMValueRef cg_get_string_object(Cg* cg, const char* s);
+LLVMValueRef cg_build_string_literal(Cg* cg, const char* s, const char* name);
 CgScope* cg_scope_new(CgScope* parent);
+const BuiltinFunction* cg_find_builtin(Cg* cg, const char* name);
 CgValue cg_unbox_value(Cg* cg, LLVMValueRef boxed_val, VarType expected_type);
 
 #endif
@@ -263,6 +263,47 @@ static CgVar* cg_find_var_in_scope(Cg* cg, const char* name) {
     return NULL;
 }
 
+// Result type of a built-in String method, NULL if there is no such
+// method (see bread_string_method in operators.c).
+static TypeDescriptor* cg_string_method_type(const char* name) {
+    static const struct {
+        const char* name;
+        VarType result;
+    } string_methods[] = {
+        {"slice", TYPE_STRING},    {"prefix", TYPE_STRING}, {"suffix", TYPE_STRING},
+        {"replace", TYPE_STRING},  {"contains", TYPE_BOOL}, {"startsWith", TYPE_BOOL},
+        {"indexOf", TYPE_INT},     {"count", TYPE_INT},
+    };
+    if (!name) return NULL;
+    if (strcmp(name, "split") == 0) {
+        return type_descriptor_create_array(type_descriptor_create_primitive(TYPE_STRING));
+    }
+    for (size_t i = 0; i < sizeof(string_methods) / sizeof(string_methods[0]); i++) {
+        if (strcmp(name, string_methods[i].name) == 0) {
+            return type_descriptor_create_primitive(string_methods[i].result);
+        }
+    }
+    return NULL;
+}
+
+// Result type of a built-in Array method called on `array_type`, NULL
+// for any other name.
+static TypeDescriptor* cg_array_method_type(const TypeDescriptor* array_type, const char* name) {
+    if (!name) return NULL;
+    if (strcmp(name, "slice") == 0) return type_descriptor_clone(array_type);
+    if (strcmp(name, "removeAt") == 0) return type_descriptor_clone(array_type->params.array.element_type);
+    if (strcmp(name, "insert") == 0) return type_descriptor_create_primitive(TYPE_NIL);
+    if (strcmp(name, "toInts") == 0) {
+        return type_descriptor_create_array(type_descriptor_create_primitive(TYPE_INT));
+    }
+    if (strcmp(name, "toDoubles") == 0) {
+        return type_descriptor_create_array(type_descriptor_create_primitive(TYPE_DOUBLE));
+    }
+    if (strcmp(name, "contains") == 0) return type_descriptor_create_primitive(TYPE_BOOL);
+    if (strcmp(name, "indexOf") == 0) return type_descriptor_create_primitive(TYPE_INT);
+    return NULL;
+}
+
 static CgStruct* cg_find_struct(Cg* cg, const char* name) {
     if (!cg || !name) return NULL;
 
@@ -365,6 +406,22 @@ CgFunction* cg_find_function(Cg* cg, const char* name) {
     return NULL;
 }
 
+// A function the program defines hides a builtin of the same name
+const BuiltinFunction* cg_find_builtin(Cg* cg, const char* name) {
+    if (cg_find_function(cg, name)) return NULL;
+    return bread_builtin_lookup(name);
+}
+
+// Builtins registered without a return type (sum, min, max, ...) give
+// back the element type of the array they are called on
+static VarType cg_builtin_return_type(const BuiltinFunction* builtin, const TypeDescriptor* first_arg) {
+    if (builtin->return_type != TYPE_NIL) return builtin->return_type;
+    if (first_arg && first_arg->base_type == TYPE_ARRAY && first_arg->params.array.element_type) {
+        return first_arg->params.array.element_type->base_type;
+    }
+    return TYPE_NIL;
+}
+
 CgClass* cg_find_class(Cg* cg, const char* name) {
     if (!cg || !name) return NULL;
     
@@ -834,7 +891,11 @@ VarType cg_infer_expr_type_simple(Cg* cg, ASTExpr* expr) {
             // Check for builtins
             const BuiltinFunction* builtin = bread_builtin_lookup(expr->as.call.name);
             if (builtin) {
-                return builtin->return_type;
+                TypeDescriptor* first_arg = builtin->return_type == TYPE_NIL && expr->as.call.arg_count > 0
+                    ? cg_infer_expr_type_desc_simple(cg, expr->as.call.args[0]) : NULL;
+                VarType result = cg_builtin_return_type(builtin, first_arg);
+                type_descriptor_free(first_arg);
+                return result;
             }
             
             return TYPE_NIL;
@@ -887,9 +948,13 @@ TypeDescriptor* cg_infer_expr_type_desc_simple(Cg* cg, ASTExpr* expr) {
                 return out;
             }
 
-            const BuiltinFunction* builtin = bread_builtin_lookup(expr->as.call.name);
+            const BuiltinFunction* builtin = cg_find_builtin(cg, expr->as.call.name);
             if (builtin) {
-                return type_descriptor_create_primitive(builtin->return_type);
+                TypeDescriptor* first_arg = builtin->return_type == TYPE_NIL && expr->as.call.arg_count > 0
+                    ? cg_infer_expr_type_desc_simple(cg, expr->as.call.args[0]) : NULL;
+                VarType result = cg_builtin_return_type(builtin, first_arg);
+                type_descriptor_free(first_arg);
+                return type_descriptor_create_primitive(result);
             }
 
             // Check for user-defined functions
@@ -925,6 +990,14 @@ TypeDescriptor* cg_infer_expr_type_desc_simple(Cg* cg, ASTExpr* expr) {
                 class_name = target_type->params.class_type.name;
             } else if (target_type->base_type == TYPE_STRUCT) {
                 class_name = target_type->params.struct_type.name;
+            } else if (target_type->base_type == TYPE_STRING) {
+                type_descriptor_free(target_type);
+                TypeDescriptor* result = cg_string_method_type(expr->as.method_call.name);
+                return result ? result : type_descriptor_create_primitive(TYPE_NIL);
+            } else if (target_type->base_type == TYPE_ARRAY) {
+                TypeDescriptor* result = cg_array_method_type(target_type, expr->as.method_call.name);
+                type_descriptor_free(target_type);
+                return result ? result : type_descriptor_create_primitive(TYPE_NIL);
             } else {
                 type_descriptor_free(target_type);
                 // Non-class targets may still support runtime-dispatched methods (e.g. Array/String/Dict).
@@ -1468,7 +1541,7 @@ int cg_analyze_expr(Cg* cg, ASTExpr* expr) {
                     return 0;
                 }
             } else {
-                const BuiltinFunction* builtin = bread_builtin_lookup(expr->as.call.name);
+                const BuiltinFunction* builtin = cg_find_builtin(cg, expr->as.call.name);
                 if (builtin) {
                     if (builtin->param_count != expr->as.call.arg_count) {
                         char msg[256];
@@ -1744,12 +1817,15 @@ int cg_analyze_stmt(Cg* cg, ASTStmt* stmt) {
                     } else if (iterable_type->base_type == TYPE_DICT && iterable_type->params.dict.key_type) {
                         // For dictionary iteration, we iterate over keys
                         element_type = type_descriptor_clone(iterable_type->params.dict.key_type);
+                    } else if (iterable_type->base_type == TYPE_STRING) {
+                        // one-character strings
+                        element_type = type_descriptor_create_primitive(TYPE_STRING);
                     }
                     type_descriptor_free(iterable_type);
                 }
                 
                 if (!element_type) {
-                    cg_error_at(cg, "Cannot infer element type for 'for-in' (expected Array or Dict with known element/key type)", NULL, &stmt->loc);
+                    cg_error_at(cg, "Cannot infer element type for 'for-in' (expected Array or Dict with known element/key type, or String)", NULL, &stmt->loc);
                     return 0;
                 }
                 
@@ -1913,9 +1989,13 @@ TypeDescriptor* cg_infer_expr_type_desc_with_function(Cg* cg, CgFunction* cg_fn,
                 return out;
             }
 
-            const BuiltinFunction* builtin = bread_builtin_lookup(expr->as.call.name);
+            const BuiltinFunction* builtin = cg_find_builtin(cg, expr->as.call.name);
             if (builtin) {
-                return type_descriptor_create_primitive(builtin->return_type);
+                TypeDescriptor* first_arg = builtin->return_type == TYPE_NIL && expr->as.call.arg_count > 0
+                    ? cg_infer_expr_type_desc_with_function(cg, cg_fn, expr->as.call.args[0]) : NULL;
+                VarType result = cg_builtin_return_type(builtin, first_arg);
+                type_descriptor_free(first_arg);
+                return type_descriptor_create_primitive(result);
             }
 
             // Check for user-defined functions
@@ -1940,6 +2020,17 @@ TypeDescriptor* cg_infer_expr_type_desc_with_function(Cg* cg, CgFunction* cg_fn,
                     type_descriptor_free(target_type);
                     return type_descriptor_create_primitive(TYPE_NIL);
                 }
+                TypeDescriptor* result = cg_array_method_type(target_type, expr->as.method_call.name);
+                if (result) {
+                    type_descriptor_free(target_type);
+                    return result;
+                }
+            } else if (target_type->base_type == TYPE_STRING) {
+                TypeDescriptor* result = cg_string_method_type(expr->as.method_call.name);
+                if (result) {
+                    type_descriptor_free(target_type);
+                    return result;
+                }
             } else if (target_type->base_type == TYPE_DICT) {
                 if (strcmp(expr->as.method_call.name, "set") == 0) {
                     type_descriptor_free(target_type);
@@ -21,10 +21,10 @@ static int handle_boxed_var_assign(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_s
         CgVar* var = cg_scope_find_var(cg_fn->scope, stmt->as.var_assign.var_name);
         if (!var) {
             LLVMValueRef slot = cg_alloc_value(cg, stmt->as.var_assign.var_name);
-            cg_copy_value_into(cg, slot, value);
+            cg_store_value_into(cg, slot, value);
             cg_scope_add_var(cg_fn->scope, stmt->as.var_assign.var_name, slot);
         } else {
-            cg_copy_value_into(cg, var->alloca, value);
+            cg_store_value_into(cg, var->alloca, value);
         }
     } else {
         LLVMValueRef name_ptr = cg_get_string_ptr(cg, stmt->as.var_assign.var_name);
@@ -111,7 +111,7 @@ static int handle_unboxed_var_decl(Cg* cg, CgFunction* cg_fn, ASTStmt* stmt, Unb
     CgValue init_val = cg_build_expr_unboxed(cg, cg_fn, stmt->as.var_decl.init);
     
     LLVMTypeRef alloc_type = get_unboxed_alloc_type(cg, unboxed_type);
-    LLVMValueRef slot = LLVMBuildAlloca(cg->builder, alloc_type, stmt->as.var_decl.var_name);
+    LLVMValueRef slot = cg_entry_alloca(cg, alloc_type, stmt->as.var_decl.var_name);
     
     store_unboxed_value(cg, slot, init_val, stmt->as.var_decl.type);
     
@@ -120,7 +120,7 @@ static int handle_unboxed_var_decl(Cg* cg, CgFunction* cg_fn, ASTStmt* stmt, Unb
     
     LLVMValueRef boxed_slot = cg_alloc_value(cg, stmt->as.var_decl.var_name);
     LLVMValueRef boxed_val = cg_box_value(cg, init_val);
-    cg_copy_value_into(cg, boxed_slot, boxed_val);
+    cg_store_value_into(cg, boxed_slot, boxed_val);
     
     declare_var_if_missing(cg, stmt->as.var_decl.var_name, stmt->as.var_decl.type, 
                           stmt->as.var_decl.is_const, boxed_slot);
@@ -133,7 +133,7 @@ static int handle_boxed_var_decl(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_siz
 
     if (cg_fn) {
         LLVMValueRef slot = cg_alloc_value(cg, stmt->as.var_decl.var_name);
-        cg_copy_value_into(cg, slot, init);
+        cg_store_value_into(cg, slot, init);
         CgVar* var = cg_scope_add_var(cg_fn->scope, stmt->as.var_decl.var_name, slot);
         init_var_metadata(var, stmt, UNBOXED_NONE);
         declare_var_if_missing(cg, stmt->as.var_decl.var_name, stmt->as.var_decl.type, 
@@ -142,7 +142,7 @@ static int handle_boxed_var_decl(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_siz
         const char* var_name = stmt->as.var_decl.var_name;
         size_t name_len = strlen(var_name);
         LLVMTypeRef str_buf_ty = LLVMArrayType(cg->i8, (unsigned)(name_len + 1));
-        LLVMValueRef str_buf = LLVMBuildAlloca(cg->builder, str_buf_ty, "var_decl_name_buf");
+        LLVMValueRef str_buf = cg_entry_alloca(cg, str_buf_ty, "var_decl_name_buf");
         LLVMValueRef name_glob = cg_get_string_global(cg, var_name);
         if (!name_glob) {
             return 0;
@@ -158,7 +158,7 @@ static int handle_boxed_var_decl(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_siz
         LLVMBasicBlockRef copy_loop = LLVMAppendBasicBlock(LLVMGetBasicBlockParent(copy_entry), "copy_loop");
         LLVMBasicBlockRef copy_body = LLVMAppendBasicBlock(LLVMGetBasicBlockParent(copy_entry), "copy_body");
         LLVMBasicBlockRef copy_done = LLVMAppendBasicBlock(LLVMGetBasicBlockParent(copy_entry), "copy_done");
-        LLVMValueRef idx_slot = LLVMBuildAlloca(cg->builder, cg->i32, "copy_idx");
+        LLVMValueRef idx_slot = cg_entry_alloca(cg, cg->i32, "copy_idx");
         LLVMBuildStore(cg->builder, zero, idx_slot);
         LLVMBuildBr(cg->builder, copy_loop);
         LLVMPositionBuilderAtEnd(cg->builder, copy_loop);
@@ -252,7 +252,7 @@ static LLVMValueRef setup_loop_scope(Cg* cg, CgFunction* cg_fn, const char* pref
     
     char slot_name[64];
     snprintf(slot_name, sizeof(slot_name), "%s.scope.base", prefix);
-    LLVMValueRef base_slot = LLVMBuildAlloca(cg->builder, cg->i32, slot_name);
+    LLVMValueRef base_slot = cg_entry_alloca(cg, cg->i32, slot_name);
     LLVMBuildStore(cg->builder, scope_base, base_slot);
     cg->current_loop_scope_base_depth_slot = base_slot;
     
@@ -274,6 +274,8 @@ static void ensure_function_return(Cg* cg, CgFunction* cg_fn, int is_constructor
     LLVMValueRef loaded_base = LLVMBuildLoad2(cg->builder, cg->i32, cg_fn->runtime_scope_base_depth_slot, "");
     LLVMValueRef pop_args[] = {loaded_base};
     LLVMBuildCall2(cg->builder, cg->ty_pop_to_scope_depth, cg->fn_pop_to_scope_depth, pop_args, 1, "");
+    cg_arena_leave(cg, cg_fn);
+    cg_alloc_site_restore(cg, cg_fn);
     LLVMBuildRetVoid(cg->builder);
 }
 
@@ -348,6 +350,7 @@ static __attribute__((unused)) int build_method_or_constructor(Cg* cg, CgClass*
     init_method_function(&cg_fn, fn_name, fn, fn_type, func_decl, class);
     setup_method_scope(cg, &cg_fn);
     add_method_params(&cg_fn, func_decl);
+    cg_alloc_site_save(cg, &cg_fn);
     
     if (func_decl->body) {
         cg_build_stmt_list(cg, &cg_fn, val_size, func_decl->body);
@@ -458,7 +461,7 @@ static int handle_boxed_var_compound_assign(Cg* cg, CgFunction* cg_fn, LLVMValue
     if (cg_fn) {
         CgVar* var = cg_scope_find_var(cg_fn->scope, stmt->as.var_assign.var_name);
         if (var) {
-             cg_copy_value_into(cg, var->alloca, res);
+             cg_store_value_into(cg, var->alloca, res);
              return 1;
         }
     }
@@ -470,6 +473,101 @@ static int handle_boxed_var_compound_assign(Cg* cg, CgFunction* cg_fn, LLVMValue
     return 1;
 }
 
+// No user code runs while evaluating `e`, so it cannot reassign a global
+static int expr_calls_no_user_code(Cg* cg, const ASTExpr* e) {
+    switch (e->kind) {
+        case AST_EXPR_NIL:
+        case AST_EXPR_BOOL:
+        case AST_EXPR_INT:
+        case AST_EXPR_DOUBLE:
+        case AST_EXPR_STRING:
+        case AST_EXPR_STRING_LITERAL:
+        case AST_EXPR_VAR:
+            return 1;
+        case AST_EXPR_BINARY:
+            return expr_calls_no_user_code(cg, e->as.binary.left) && expr_calls_no_user_code(cg, e->as.binary.right);
+        case AST_EXPR_UNARY:
+            return expr_calls_no_user_code(cg, e->as.unary.operand);
+        case AST_EXPR_INDEX:
+            return expr_calls_no_user_code(cg, e->as.index.target) && expr_calls_no_user_code(cg, e->as.index.index);
+        case AST_EXPR_CALL:
+            if (!cg_find_builtin(cg, e->as.call.name)) return 0;
+            for (int i = 0; i < e->as.call.arg_count; i++) {
+                if (!expr_calls_no_user_code(cg, e->as.call.args[i])) return 0;
+            }
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// Recognises `v = v + a + b ...` and `v += a`, returning the appended
+// operands (caller frees) and their count, or 0 for any other shape.
+static int var_append_parts(const ASTStmt* stmt, ASTExpr*** out_parts) {
+    ASTExpr* value = stmt->as.var_assign.value;
+    if (stmt->as.var_assign.op) {
+        if (stmt->as.var_assign.op != '+') return 0;
+        *out_parts = malloc(sizeof(ASTExpr*));
+        if (!*out_parts) return 0;
+        (*out_parts)[0] = value;
+        return 1;
+    }
+
+    if (value->kind != AST_EXPR_BINARY || value->as.binary.op != '+') return 0;
+    ASTExpr** leaves = NULL;
+    int count = cg_add_chain(value, &leaves);
+    if (count < 2 || leaves[0]->kind != AST_EXPR_VAR ||
+        strcmp(leaves[0]->as.var_name, stmt->as.var_assign.var_name) != 0) {
+        free(leaves);
+        return 0;
+    }
+    memmove(leaves, leaves + 1, (size_t)(count - 1) * sizeof(ASTExpr*));
+    *out_parts = leaves;
+    return count - 1;
+}
+
+// Appending to a variable updates it in place, so a string grown in a loop
+// is not copied on every iteration. Globals qualify only when evaluating
+// the operands cannot reassign them first.
+static int try_var_append(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, ASTStmt* stmt, int* ok) {
+    ASTExpr** parts = NULL;
+    int count = var_append_parts(stmt, &parts);
+    if (count == 0) return 0;
+
+    CgVar* var = cg_fn ? cg_scope_find_var(cg_fn->scope, stmt->as.var_assign.var_name) : NULL;
+    if (!var) {
+        if (cg_fn && !stmt->as.var_assign.op) {
+            // plain assignment to an unknown name declares a local
+            free(parts);
+            return 0;
+        }
+        for (int i = 0; i < count; i++) {
+            if (!expr_calls_no_user_code(cg, parts[i])) {
+                free(parts);
+                return 0;
+            }
+        }
+    }
+
+    LLVMValueRef values = cg_build_value_ptrs(cg, cg_fn, val_size, parts, count);
+    free(parts);
+    if (!values) {
+        *ok = 0;
+        return 1;
+    }
+
+    LLVMValueRef n = LLVMConstInt(cg->i32, (unsigned long long)count, 0);
+    if (var) {
+        LLVMValueRef args[] = {cg_value_to_i8_ptr(cg, var->alloca), values, n};
+        LLVMBuildCall2(cg->builder, cg->ty_append_op, cg->fn_append_op, args, 3, "");
+    } else {
+        LLVMValueRef args[] = {cg_get_string_ptr(cg, stmt->as.var_assign.var_name), values, n};
+        LLVMBuildCall2(cg->builder, cg->ty_var_append, cg->fn_var_append, args, 3, "");
+    }
+    *ok = 1;
+    return 1;
+}
+
 static int build_var_assign_stmt(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, ASTStmt* stmt) {
     if (cg_fn) {
         CgVar* var = cg_scope_find_var(cg_fn->scope, stmt->as.var_assign.var_name);
@@ -480,6 +578,10 @@ static int build_var_assign_stmt(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_siz
             return handle_unboxed_var_assign(cg, cg_fn, var, stmt->as.var_assign.value);
         }
     }
+    int ok = 0;
+    if (try_var_append(cg, cg_fn, val_size, stmt, &ok)) {
+        return ok;
+    }
     if (stmt->as.var_assign.op) {
         return handle_boxed_var_compound_assign(cg, cg_fn, val_size, stmt);
     }
@@ -654,9 +756,11 @@ static int build_while_stmt(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, AS
     LLVMValueRef prev_loop_scope_base;
     setup_loop_state(cg, end_block, cond_block, &prev_loop_end, &prev_loop_continue, &prev_loop_scope_base);
 
+    LLVMValueRef loop_mark = cg_nursery_mark(cg);
     LLVMBuildBr(cg->builder, cond_block);
 
     LLVMPositionBuilderAtEnd(cg->builder, cond_block);
+    cg_nursery_reset(cg, loop_mark); // previous iteration's condition temporaries
     LLVMValueRef cond_i1 = get_condition_bool(cg, cg_fn, val_size, stmt->as.while_stmt.condition);
     if (!cond_i1) return 0;
     
@@ -730,7 +834,7 @@ static int build_for_stmt(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, ASTS
     LLVMValueRef prev_loop_scope_base;
     setup_loop_state(cg, end_block, inc_block, &prev_loop_end, &prev_loop_continue, &prev_loop_scope_base);
 
-    LLVMValueRef i_slot = LLVMBuildAlloca(cg->builder, cg->i32, "for.i");
+    LLVMValueRef i_slot = cg_entry_alloca(cg, cg->i32, "for.i");
     LLVMBuildStore(cg->builder, LLVMConstInt(cg->i32, start, 0), i_slot);
 
     declare_loop_variable(cg, stmt->as.for_stmt.var_name, TYPE_INT, start);
@@ -796,7 +900,8 @@ static LLVMValueRef get_iterable_for_loop(Cg* cg, CgFunction* cg_fn, LLVMValueRe
         return keys_array;
     }
     
-    if ((*out_type)->base_type != TYPE_ARRAY) {
+    // strings are walked by index like arrays, see bread_value_array_get
+    if ((*out_type)->base_type != TYPE_ARRAY && (*out_type)->base_type != TYPE_STRING) {
         type_descriptor_free(*out_type);
         *out_type = NULL;
         return NULL;
@@ -827,7 +932,7 @@ static int build_for_in_stmt(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, A
     LLVMValueRef actual_iterable = get_iterable_for_loop(cg, cg_fn, val_size, stmt->as.for_in_stmt.iterable, &iterable_type, end_block);
     if (!actual_iterable) return 0;
 
-    LLVMValueRef index_slot = LLVMBuildAlloca(cg->builder, cg->i32, "forin.index");
+    LLVMValueRef index_slot = cg_entry_alloca(cg, cg->i32, "forin.index");
     LLVMBuildStore(cg->builder, LLVMConstInt(cg->i32, 0, 0), index_slot);
 
     LLVMValueRef length = LLVMBuildCall2(cg->builder, cg->ty_array_length, cg->fn_array_length,
@@ -844,9 +949,12 @@ static int build_for_in_stmt(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, A
             element_var_type = iterable_type->params.array.element_type->base_type;
         } else if (iterable_type->base_type == TYPE_DICT && iterable_type->params.dict.key_type) {
             element_var_type = iterable_type->params.dict.key_type->base_type;
+        } else if (iterable_type->base_type == TYPE_STRING) {
+            element_var_type = TYPE_STRING;
         }
     }
     declare_loop_variable(cg, stmt->as.for_in_stmt.var_name, TYPE_NIL, 0);
+    LLVMValueRef loop_mark = cg_nursery_mark(cg);
     LLVMBuildBr(cg->builder, cond_block);
 
     LLVMPositionBuilderAtEnd(cg->builder, cond_block);
@@ -859,6 +967,7 @@ static int build_for_in_stmt(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, A
     LLVMBuildCondBr(cg->builder, cmp, body_block, end_block);
 
     LLVMPositionBuilderAtEnd(cg->builder, body_block);
+    cg_nursery_reset(cg, loop_mark);
     LLVMValueRef element_tmp = cg_alloc_value(cg, "forin.element");
     LLVMValueRef get_args[] = {cg_value_to_i8_ptr(cg, actual_iterable), index_phi, cg_value_to_i8_ptr(cg, element_tmp)};
     LLVMValueRef get_success = LLVMBuildCall2(cg->builder, cg->ty_array_get, cg->fn_array_get, get_args, 3, "");
@@ -945,6 +1054,8 @@ static int build_func_decl_stmt(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size
     new_cg_fn->next = cg->functions;
     new_cg_fn->ret_slot = NULL;
     new_cg_fn->runtime_scope_base_depth_slot = NULL;
+    new_cg_fn->arena_mark_slot = NULL;
+    new_cg_fn->alloc_site_slot = NULL;
     cg->functions = new_cg_fn;
     
     return 1;
@@ -970,6 +1081,8 @@ static int build_return_stmt(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, A
         LLVMValueRef pop_args[] = {safe_depth};
         LLVMBuildCall2(cg->builder, cg->ty_pop_to_scope_depth, cg->fn_pop_to_scope_depth, pop_args, 1, "");
     }
+    cg_arena_leave(cg, cg_fn);
+    cg_alloc_site_restore(cg, cg_fn);
 
     LLVMBuildRetVoid(cg->builder);
     return 1;
@@ -1035,6 +1148,7 @@ static int build_constructor(Cg* cg, CgClass* class, LLVMValueRef val_size) {
                         class->constructor, class);
     setup_method_scope(cg, &cg_constructor);
     add_method_params(&cg_constructor, class->constructor);
+    cg_alloc_site_save(cg, &cg_constructor);
     
     if (class->constructor->body) {
         cg_build_stmt_list(cg, &cg_constructor, val_size, class->constructor->body);
@@ -1065,6 +1179,7 @@ static int build_method(Cg* cg, CgClass* class, ASTStmtFuncDecl* method, int met
     init_method_function(&cg_method, method_name, method_fn, method_type, method, class);
     setup_method_scope(cg, &cg_method);
     add_method_params(&cg_method, method);
+    cg_alloc_site_save(cg, &cg_method);
     
     if (method->body) {
         cg_build_stmt_list(cg, &cg_method, val_size, method->body);
@@ -1105,9 +1220,7 @@ static int build_class_decl_stmt(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_siz
     return 1;
 }
 
-int cg_build_stmt(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, ASTStmt* stmt) {
-    if (!cg || !stmt) return 0;
-    
+static int build_stmt_kind(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, ASTStmt* stmt) {
     switch (stmt->kind) {
         case AST_STMT_EXPR:         return build_expr_stmt(cg, cg_fn, val_size, stmt);
         case AST_STMT_VAR_ASSIGN:   return build_var_assign_stmt(cg, cg_fn, val_size, stmt);
@@ -1131,6 +1244,50 @@ int cg_build_stmt(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, ASTStmt* stm
     }
 }
 
+static int stmt_makes_temporaries(const ASTStmt* stmt) {
+    switch (stmt->kind) {
+        case AST_STMT_FUNC_DECL:
+        case AST_STMT_STRUCT_DECL:
+        case AST_STMT_CLASS_DECL:
+        case AST_STMT_RETURN:
+        case AST_STMT_BREAK:
+        case AST_STMT_CONTINUE:
+            return 0;
+        default:
+            return 1;
+    }
+}
+
+// Every statement is bracketed by a nursery mark/reset, so the temporaries
+// it creates are dropped together once it completes. Profiling builds also
+// charge the statement's allocations to its source location, and hand the
+// site back to the enclosing statement once a nested one completes, so a
+// loop condition or the rest of an if is not charged to the body's last
+// statement.
+int cg_build_stmt(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, ASTStmt* stmt) {
+    if (!cg || !stmt) return 0;
+    
+    LLVMValueRef mark = NULL;
+    const SourceLoc* outer_site = cg->alloc_site_loc;
+    if (stmt_makes_temporaries(stmt) && !LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(cg->builder))) {
+        mark = cg_nursery_mark(cg);
+        if (cg->alloc_profile) {
+            cg_alloc_site(cg, &stmt->loc);
+            cg->alloc_site_loc = &stmt->loc;
+        }
+    }
+    
+    int ok = build_stmt_kind(cg, cg_fn, val_size, stmt);
+    cg->alloc_site_loc = outer_site;
+    if (!ok) return 0;
+    
+    cg_nursery_reset(cg, mark);
+    if (mark && outer_site && !LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(cg->builder))) {
+        cg_alloc_site(cg, outer_site);
+    }
+    return 1;
+}
+
 int cg_build_stmt_list(Cg* cg, CgFunction* cg_fn, LLVMValueRef val_size, ASTStmtList* list) {
     if (!cg || !list) return 1;
     
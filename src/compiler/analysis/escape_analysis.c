@@ -202,6 +202,168 @@ static void analyze_expr_escape(ASTExpr* expr, int is_assignment_target) {
     }
 }
 
+// Arena sites. A collection literal that initialises a local at the top
+// level of a function body runs once per call, and if the local is only
+// ever indexed, iterated, measured or mutated in place, nothing can hold
+// the collection after the call returns. Any other use of the name, a
+// second declaration of it or a parameter with the same name counts as
+// an escape.
+
+static int is_arena_literal(const ASTExpr* expr) {
+    return expr && (expr->kind == AST_EXPR_ARRAY_LITERAL ||
+                    expr->kind == AST_EXPR_DICT ||
+                    expr->kind == AST_EXPR_STRUCT_LITERAL);
+}
+
+static int is_var_named(const ASTExpr* expr, const char* name) {
+    return expr && expr->kind == AST_EXPR_VAR && strcmp(expr->as.var_name, name) == 0;
+}
+
+static int builtin_reads_only(const char* fn_name) {
+    return strcmp(fn_name, "len") == 0 || strcmp(fn_name, "str") == 0 ||
+           strcmp(fn_name, "type") == 0;
+}
+
+static int expr_leaks_var(const ASTExpr* expr, const char* name);
+static int stmts_leak_var(const ASTStmtList* list, const char* name, const ASTStmt* decl);
+
+static int exprs_leak_var(ASTExpr** exprs, int count, const char* name) {
+    for (int i = 0; i < count; i++) {
+        if (expr_leaks_var(exprs[i], name)) return 1;
+    }
+    return 0;
+}
+
+// Leak check for a target that may safely be the variable itself
+static int target_leaks_var(const ASTExpr* target, const char* name) {
+    return !is_var_named(target, name) && expr_leaks_var(target, name);
+}
+
+static int expr_leaks_var(const ASTExpr* expr, const char* name) {
+    if (!expr) return 0;
+
+    switch (expr->kind) {
+        case AST_EXPR_VAR:
+            return strcmp(expr->as.var_name, name) == 0;
+        case AST_EXPR_BINARY:
+            return expr_leaks_var(expr->as.binary.left, name) ||
+                   expr_leaks_var(expr->as.binary.right, name);
+        case AST_EXPR_UNARY:
+            return expr_leaks_var(expr->as.unary.operand, name);
+        case AST_EXPR_CALL:
+            if (builtin_reads_only(expr->as.call.name)) {
+                for (int i = 0; i < expr->as.call.arg_count; i++) {
+                    if (target_leaks_var(expr->as.call.args[i], name)) return 1;
+                }
+                return 0;
+            }
+            return exprs_leak_var(expr->as.call.args, expr->as.call.arg_count, name);
+        case AST_EXPR_ARRAY:
+            return exprs_leak_var(expr->as.array.items, expr->as.array.item_count, name);
+        case AST_EXPR_DICT:
+            for (int i = 0; i < expr->as.dict.entry_count; i++) {
+                if (expr_leaks_var(expr->as.dict.entries[i].key, name) ||
+                    expr_leaks_var(expr->as.dict.entries[i].value, name)) {
+                    return 1;
+                }
+            }
+            return 0;
+        case AST_EXPR_INDEX:
+            return target_leaks_var(expr->as.index.target, name) ||
+                   expr_leaks_var(expr->as.index.index, name);
+        case AST_EXPR_MEMBER:
+            return target_leaks_var(expr->as.member.target, name);
+        case AST_EXPR_METHOD_CALL:
+            return target_leaks_var(expr->as.method_call.target, name) ||
+                   exprs_leak_var(expr->as.method_call.args, expr->as.method_call.arg_count, name);
+        case AST_EXPR_ARRAY_LITERAL:
+            return exprs_leak_var(expr->as.array_literal.elements,
+                                  expr->as.array_literal.element_count, name);
+        case AST_EXPR_STRUCT_LITERAL:
+            return exprs_leak_var(expr->as.struct_literal.field_values,
+                                  expr->as.struct_literal.field_count, name);
+        case AST_EXPR_CLASS_LITERAL:
+            return exprs_leak_var(expr->as.class_literal.field_values,
+                                  expr->as.class_literal.field_count, name);
+        default:
+            return 0;
+    }
+}
+
+static int stmt_leaks_var(const ASTStmt* stmt, const char* name, const ASTStmt* decl) {
+    switch (stmt->kind) {
+        case AST_STMT_VAR_DECL:
+            if (stmt != decl && strcmp(stmt->as.var_decl.var_name, name) == 0) return 1;
+            return expr_leaks_var(stmt->as.var_decl.init, name);
+        case AST_STMT_VAR_ASSIGN:
+            // compound assignment reads the old value through the operator
+            if (stmt->as.var_assign.op && strcmp(stmt->as.var_assign.var_name, name) == 0) return 1;
+            return expr_leaks_var(stmt->as.var_assign.value, name);
+        case AST_STMT_INDEX_ASSIGN:
+            return target_leaks_var(stmt->as.index_assign.target, name) ||
+                   expr_leaks_var(stmt->as.index_assign.index, name) ||
+                   expr_leaks_var(stmt->as.index_assign.value, name);
+        case AST_STMT_MEMBER_ASSIGN:
+            return target_leaks_var(stmt->as.member_assign.target, name) ||
+                   expr_leaks_var(stmt->as.member_assign.value, name);
+        case AST_STMT_PRINT:
+            return target_leaks_var(stmt->as.print.expr, name);
+        case AST_STMT_EXPR:
+            return expr_leaks_var(stmt->as.expr.expr, name);
+        case AST_STMT_IF:
+            return expr_leaks_var(stmt->as.if_stmt.condition, name) ||
+                   stmts_leak_var(stmt->as.if_stmt.then_branch, name, decl) ||
+                   stmts_leak_var(stmt->as.if_stmt.else_branch, name, decl);
+        case AST_STMT_WHILE:
+            return expr_leaks_var(stmt->as.while_stmt.condition, name) ||
+                   stmts_leak_var(stmt->as.while_stmt.body, name, decl);
+        case AST_STMT_FOR:
+            if (strcmp(stmt->as.for_stmt.var_name, name) == 0) return 1;
+            return expr_leaks_var(stmt->as.for_stmt.range_expr, name) ||
+                   stmts_leak_var(stmt->as.for_stmt.body, name, decl);
+        case AST_STMT_FOR_IN:
+            if (strcmp(stmt->as.for_in_stmt.var_name, name) == 0) return 1;
+            return target_leaks_var(stmt->as.for_in_stmt.iterable, name) ||
+                   stmts_leak_var(stmt->as.for_in_stmt.body, name, decl);
+        case AST_STMT_RETURN:
+            return expr_leaks_var(stmt->as.ret.expr, name);
+        case AST_STMT_FUNC_DECL:
+            return stmts_leak_var(stmt->as.func_decl.body, name, decl);
+        default:
+            return 0;
+    }
+}
+
+static int stmts_leak_var(const ASTStmtList* list, const char* name, const ASTStmt* decl) {
+    if (!list) return 0;
+    for (const ASTStmt* s = list->head; s; s = s->next) {
+        if (stmt_leaks_var(s, name, decl)) return 1;
+    }
+    return 0;
+}
+
+static void mark_arena_sites(ASTStmtFuncDecl* func) {
+    if (!func->body) return;
+
+    for (ASTStmt* s = func->body->head; s; s = s->next) {
+        if (s->kind != AST_STMT_VAR_DECL || !is_arena_literal(s->as.var_decl.init)) continue;
+
+        const char* name = s->as.var_decl.var_name;
+        int is_param = 0;
+        for (int i = 0; i < func->param_count; i++) {
+            if (strcmp(func->param_names[i], name) == 0) is_param = 1;
+        }
+        if (is_param || stmts_leak_var(func->body, name, s)) continue;
+
+        EscapeInfo* info = (EscapeInfo*)s->as.var_decl.init->escape_info;
+        if (!info) continue;
+        info->escape_kind = ESCAPE_NONE;
+        info->can_stack_allocate = 1;
+        info->arena_site = 1;
+        g_escape_ctx->arena_sites++;
+    }
+}
+
 static void analyze_stmt_escape(ASTStmt* stmt) {
     if (!stmt) return;
     
@@ -285,6 +447,7 @@ static void analyze_stmt_escape(ASTStmt* stmt) {
                     analyze_stmt_escape(s);
                 }
             }
+            mark_arena_sites(&stmt->as.func_decl);
             g_escape_ctx->function_depth--;
             break;
             
@@ -364,6 +527,25 @@ int can_stack_allocate(ASTExpr* expr) {
     return info && info->can_stack_allocate;
 }
 
+int escape_analysis_is_arena_site(ASTExpr* expr) {
+    EscapeInfo* info = get_escape_info(expr);
+    return info && info->arena_site;
+}
+
+int escape_analysis_body_uses_arena(ASTStmtList* body) {
+    if (!body) return 0;
+    for (ASTStmt* s = body->head; s; s = s->next) {
+        if (s->kind == AST_STMT_VAR_DECL && escape_analysis_is_arena_site(s->as.var_decl.init)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int escape_analysis_arena_site_count(void) {
+    return g_escape_ctx ? g_escape_ctx->arena_sites : 0;
+}
+
 int get_value_lifetime(ASTExpr* expr) {
     EscapeInfo* info = get_escape_info(expr);
     return info ? info->lifetime_end : -1;
@@ -100,7 +100,7 @@ int register_function(const Function* fn) {
                 dst->parameters[i].name = strdup(fn->parameters[i].name);
                 dst->parameters[i].has_default = fn->parameters[i].has_default;
                 if (fn->parameters[i].has_default) {
-                    dst->parameters[i].default_value = bread_value_clone(fn->parameters[i].default_value);
+                    dst->parameters[i].default_value = bread_value_promote(fn->parameters[i].default_value);
                 } else {
                     memset(&dst->parameters[i].default_value, 0, sizeof(BreadValue));
                 }
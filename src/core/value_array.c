@@ -1,11 +1,249 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <limits.h>
 
 #include "core/value.h"
 #include "runtime/memory.h"
 #include "runtime/error.h"
 
+// Int, Double and Bool arrays keep their elements in `unboxed`: 8, 8 and 1
+// bytes each instead of a 16-byte BreadValue, and nothing for release or
+// the collector to walk. Readers get one element boxed at a time through
+// bread_array_at. Only bread_array_get, which hands out a BreadValue*
+// into the array, converts it to boxed storage, and that is permanent.
+//
+// range() arrays start with no storage at all: range_start and range_step
+// give every element, so a loop over range(n) runs in constant memory. The
+// first write or bread_array_get materialises them as an unboxed [Int].
+//
+// slice() shares elements instead of copying them. The first slice of an
+// array moves its storage into a hidden owner array, and from then on the
+// array and every slice of it point into that storage with `base` holding
+// a reference to the owner. The owner's refcount is the number of arrays
+// sharing it, so a write checks it: the only array left takes the storage
+// back, any other copies its own elements first. Slices of a range() are
+// ranges themselves.
+//
+// Removing the first element does not shift the rest: items/unboxed moves
+// up one slot and `head` counts the free slots left in front, so the
+// storage starts `head` slots before the first element. An insert at the
+// front uses one of them, and when there are none it opens as many as
+// there are elements, so push and pop at either end are amortised O(1)
+// and an insert or removal elsewhere moves whichever side is shorter.
+
+static inline int bread_array_unboxable(VarType type) {
+    return type == TYPE_INT || type == TYPE_DOUBLE || type == TYPE_BOOL;
+}
+
+static inline size_t bread_array_width(const BreadArray* a) {
+    if (!a->unboxed) return sizeof(BreadValue);
+    return a->element_type == TYPE_BOOL ? sizeof(uint8_t) : sizeof(int64_t);
+}
+
+static inline char* bread_array_data(const BreadArray* a) {
+    return a->unboxed ? (char*)a->unboxed : (char*)a->items;
+}
+
+static inline void bread_array_set_data(BreadArray* a, char* data) {
+    if (a->unboxed) {
+        a->unboxed = data;
+    } else {
+        a->items = (BreadValue*)data;
+    }
+}
+
+static void bread_array_free_storage(BreadArray* a) {
+    char* data = bread_array_data(a);
+    if (!data || a->base) return;
+    size_t width = bread_array_width(a);
+    bread_memory_free_backing(data - (size_t)a->head * width, width * (size_t)(a->head + a->capacity));
+}
+
+static int bread_array_materialize(BreadArray* a) {
+    if (!a->range_step) return 1;
+
+    int64_t* ints = bread_memory_alloc_backing(sizeof(int64_t) * (size_t)a->count, 0);
+    if (!ints) {
+        BREAD_ERROR_SET_MEMORY_ALLOCATION("Failed to allocate memory for range elements");
+        return 0;
+    }
+    uint64_t v = (uint64_t)a->range_start;
+    for (int i = 0; i < a->count; i++, v += (uint64_t)a->range_step) {
+        ints[i] = (int64_t)v;
+    }
+    a->unboxed = ints;
+    a->capacity = a->count;
+    a->range_step = 0;
+    return 1;
+}
+
+// Gives an array that shares its storage a copy of its own elements, or
+// the storage itself when no other array is using it
+static int bread_array_unshare(BreadArray* a) {
+    BreadArray* owner = a->base;
+    if (!owner) return 1;
+
+    if (owner->header.refcount == 1 && owner->count == a->count) {
+        a->capacity = owner->capacity;
+        a->head = owner->head;
+        owner->items = NULL;
+        owner->unboxed = NULL;
+        owner->count = 0;
+    } else if (a->count == 0) {
+        a->items = NULL;
+        a->unboxed = NULL;
+        a->capacity = 0;
+    } else {
+        size_t width = bread_array_width(a);
+        void* copy = bread_memory_alloc_backing(width * (size_t)a->count, 0);
+        if (!copy) {
+            BREAD_ERROR_SET_MEMORY_ALLOCATION("Failed to allocate memory for array elements");
+            return 0;
+        }
+        if (a->unboxed) {
+            memcpy(copy, a->unboxed, width * (size_t)a->count);
+            a->unboxed = copy;
+        } else {
+            BreadValue* items = copy;
+            for (int i = 0; i < a->count; i++) {
+                items[i] = bread_value_clone(a->items[i]);
+            }
+            a->items = items;
+        }
+        a->capacity = a->count;
+    }
+    a->base = NULL;
+    bread_array_release(owner);
+    return 1;
+}
+
+// Every write goes through here first
+static inline int bread_array_writable(BreadArray* a) {
+    return bread_array_materialize(a) && bread_array_unshare(a);
+}
+
+// Grows the storage to hold at least `need` elements. An array without
+// storage yet is unboxed if its element type allows.
+static int bread_array_reserve(BreadArray* a, int need) {
+    if (!bread_array_writable(a)) return 0;
+    if (need <= a->capacity) return 1;
+    int new_cap = a->capacity == 0 ? 8 : a->capacity * 2;
+    if (new_cap < need) new_cap = need;
+
+    if (!a->items && !a->unboxed && bread_array_unboxable(a->element_type)) {
+        size_t width = a->element_type == TYPE_BOOL ? sizeof(uint8_t) : sizeof(int64_t);
+        a->unboxed = bread_memory_alloc_backing(width * (size_t)new_cap, 0);
+        if (!a->unboxed) return 0;
+        a->capacity = new_cap;
+        return 1;
+    }
+
+    size_t width = bread_array_width(a);
+    char* storage = a->head ? bread_array_data(a) - (size_t)a->head * width : bread_array_data(a);
+    if (a->head > 0 && a->head >= a->count && need <= a->head + a->capacity) {
+        // a queue: slide back to the start instead of growing
+        memmove(storage, bread_array_data(a), (size_t)a->count * width);
+        bread_array_set_data(a, storage);
+        a->capacity += a->head;
+        a->head = 0;
+        return 1;
+    }
+    char* grown = bread_memory_realloc_backing(storage, width * (size_t)(a->head + a->capacity),
+                                               width * (size_t)(a->head + new_cap));
+    if (!grown) return 0;
+    bread_array_set_data(a, grown + (size_t)a->head * width);
+    a->capacity = new_cap;
+    return 1;
+}
+
+// Opens free slots in front of the first element if there are none
+static int bread_array_reserve_front(BreadArray* a) {
+    if (!bread_array_writable(a)) return 0;
+    if (a->head > 0) return 1;
+    int gap = a->count < 8 ? 8 : a->count;
+    if (!bread_array_reserve(a, a->count + gap)) return 0;
+
+    size_t width = bread_array_width(a);
+    char* data = bread_array_data(a);
+    memmove(data + (size_t)gap * width, data, (size_t)a->count * width);
+    bread_array_set_data(a, data + (size_t)gap * width);
+    a->head = gap;
+    a->capacity -= gap;
+    return 1;
+}
+
+// Stores a value whose type already matches the array
+static inline void bread_array_put(BreadArray* a, int idx, BreadValue v) {
+    if (!a->unboxed) {
+        a->items[idx] = bread_value_promote(v);
+        return;
+    }
+    switch (a->element_type) {
+        case TYPE_INT:
+            ((int64_t*)a->unboxed)[idx] = v.value.int_val;
+            break;
+        case TYPE_DOUBLE:
+            ((double*)a->unboxed)[idx] = v.value.double_val;
+            break;
+        default:
+            ((uint8_t*)a->unboxed)[idx] = v.value.bool_val != 0;
+            break;
+    }
+}
+
+BreadValue bread_array_at(const BreadArray* a, int idx) {
+    if (a->items) return a->items[idx];
+
+    BreadValue v;
+    memset(&v, 0, sizeof(v));
+    v.type = a->element_type;
+    if (a->range_step) {
+        v.value.int_val = (int64_t)((uint64_t)a->range_start + (uint64_t)idx * (uint64_t)a->range_step);
+        return v;
+    }
+    switch (a->element_type) {
+        case TYPE_INT:
+            v.value.int_val = ((const int64_t*)a->unboxed)[idx];
+            break;
+        case TYPE_DOUBLE:
+            v.value.double_val = ((const double*)a->unboxed)[idx];
+            break;
+        default:
+            v.value.bool_val = ((const uint8_t*)a->unboxed)[idx];
+            break;
+    }
+    return v;
+}
+
+int bread_array_box(BreadArray* a) {
+    if (!a) return 1;
+    if (!bread_array_writable(a)) return 0;
+    if (!a->unboxed) return 1;
+
+    BreadValue* items = bread_memory_alloc_backing(sizeof(BreadValue) * (size_t)a->capacity, 0);
+    if (!items) {
+        BREAD_ERROR_SET_MEMORY_ALLOCATION("Failed to allocate memory for array elements");
+        return 0;
+    }
+    for (int i = 0; i < a->count; i++) {
+        items[i] = bread_array_at(a, i);
+    }
+    bread_array_free_storage(a);
+    a->unboxed = NULL;
+    a->items = items;
+    a->head = 0;
+    return 1;
+}
+
+int64_t* bread_array_int_data(BreadArray* a) {
+    return a && a->unboxed && a->element_type == TYPE_INT ? (int64_t*)a->unboxed : NULL;
+}
+
+double* bread_array_double_data(BreadArray* a) {
+    return a && a->unboxed && a->element_type == TYPE_DOUBLE ? (double*)a->unboxed : NULL;
+}
+
 BreadArray* bread_array_new(void) {
     BreadArray* a = (BreadArray*)bread_memory_alloc(sizeof(BreadArray), BREAD_OBJ_ARRAY);
     if (!a) return NULL;
@@ -13,6 +251,27 @@ BreadArray* bread_array_new(void) {
     a->capacity = 0;
     a->element_type = TYPE_NIL;
     a->items = NULL;
+    a->unboxed = NULL;
+    a->range_start = 0;
+    a->range_step = 0;
+    a->base = NULL;
+    a->head = 0;
+    return a;
+}
+
+// For literals the escape analysis keeps inside one call
+BreadArray* bread_array_new_in_arena(void) {
+    BreadArray* a = (BreadArray*)bread_memory_alloc_arena(sizeof(BreadArray), BREAD_OBJ_ARRAY);
+    if (!a) return NULL;
+    a->count = 0;
+    a->capacity = 0;
+    a->element_type = TYPE_NIL;
+    a->items = NULL;
+    a->unboxed = NULL;
+    a->range_start = 0;
+    a->range_step = 0;
+    a->base = NULL;
+    a->head = 0;
     return a;
 }
 
@@ -23,6 +282,11 @@ BreadArray* bread_array_new_typed(VarType element_type) {
     a->capacity = 0;
     a->element_type = element_type;
     a->items = NULL;
+    a->unboxed = NULL;
+    a->range_start = 0;
+    a->range_step = 0;
+    a->base = NULL;
+    a->head = 0;
     return a;
 }
 
@@ -30,18 +294,92 @@ BreadArray* bread_array_new_with_capacity(int capacity, VarType element_type) {
     BreadArray* a = (BreadArray*)bread_memory_alloc(sizeof(BreadArray), BREAD_OBJ_ARRAY);
     if (!a) return NULL;
     a->count = 0;
-    a->capacity = capacity;
+    a->capacity = 0;
     a->element_type = element_type;
-    if (capacity > 0) {
-        a->items = malloc(sizeof(BreadValue) * capacity);
-        if (!a->items) {
-            bread_memory_free(a);
+    a->items = NULL;
+    a->unboxed = NULL;
+    a->range_start = 0;
+    a->range_step = 0;
+    a->base = NULL;
+    a->head = 0;
+    if (capacity > 0 && !bread_array_reserve(a, capacity)) {
+        bread_memory_free(a);
+        return NULL;
+    }
+    return a;
+}
+
+BreadArray* bread_array_new_range(int64_t start, int64_t stop, int64_t step) {
+    if (step == 0) {
+        BREAD_ERROR_SET_RUNTIME("range() step cannot be zero");
+        return NULL;
+    }
+    BreadArray* a = bread_array_new_typed(TYPE_INT);
+    if (!a) return NULL;
+    if (step > 0 ? start >= stop : start <= stop) return a;
+
+    // unsigned, so neither the span nor -step can overflow
+    uint64_t span = step > 0 ? (uint64_t)stop - (uint64_t)start : (uint64_t)start - (uint64_t)stop;
+    uint64_t stride = step > 0 ? (uint64_t)step : 0 - (uint64_t)step;
+    uint64_t count = (span - 1) / stride + 1;
+    if (count > INT_MAX) {
+        BREAD_ERROR_SET_RUNTIME("range() has more elements than an array can hold");
+        bread_array_release(a);
+        return NULL;
+    }
+    a->count = (int)count;
+    a->range_start = start;
+    a->range_step = step;
+    return a;
+}
+
+// Elements [start, end) of `a`; negative positions count from the end and
+// both are clamped to its length, as String's slice() does
+BreadArray* bread_array_slice(BreadArray* a, int start, int end) {
+    if (!a) {
+        BREAD_ERROR_SET_RUNTIME("Cannot slice null array");
+        return NULL;
+    }
+    if (start < 0) start = start + a->count < 0 ? 0 : start + a->count;
+    if (end < 0) end = end + a->count < 0 ? 0 : end + a->count;
+    if (end > a->count) end = a->count;
+    if (start > end) start = end;
+
+    BreadArray* slice = bread_array_new_typed(a->element_type);
+    if (!slice || start == end) return slice;
+    slice->count = end - start;
+    slice->capacity = slice->count;
+
+    if (a->range_step) {
+        slice->capacity = 0;
+        slice->range_start = (int64_t)((uint64_t)a->range_start + (uint64_t)start * (uint64_t)a->range_step);
+        slice->range_step = a->range_step;
+        return slice;
+    }
+
+    if (!a->base) {
+        BreadArray* owner = bread_array_new_typed(a->element_type);
+        if (!owner) {
+            bread_array_release(slice);
             return NULL;
         }
+        owner->count = a->count;
+        owner->capacity = a->capacity;
+        owner->head = a->head;
+        owner->items = a->items;
+        owner->unboxed = a->unboxed;
+        a->base = owner;
+        a->capacity = a->count;
+        a->head = 0;
+    }
+    slice->base = a->base;
+    bread_array_retain(slice->base);
+    if (a->unboxed) {
+        slice->unboxed = (char*)a->unboxed + (size_t)start * bread_array_width(a);
     } else {
-        a->items = NULL;
+        slice->items = a->items + start;
     }
-    return a;
+    return slice;
 }
 
 void bread_array_retain(BreadArray* a) {
@@ -56,13 +394,18 @@ void bread_array_release(BreadArray* a) {
     
     header->refcount--;
     if (header->refcount == 0) {
-        if (a->items) {
+        if (a->base) {
+            bread_array_release(a->base);
+        } else if (a->items) {
             for (int i = 0; i < a->count; i++) {
                 bread_value_release(&a->items[i]);
             }
-            free(a->items);
         }
+        bread_array_free_storage(a);
         bread_memory_free(a);
+    } else if (a->items) {
+        // slices too, since a cycle can run through the owner they hold
+        bread_memory_possible_cycle_root(a);
     }
 }
 
@@ -77,19 +420,14 @@ int bread_array_append(BreadArray* a, BreadValue v) {
         a->element_type = v.type;
     }
     
-    if (a->count >= a->capacity) {
-        int new_cap = a->capacity == 0 ? 8 : a->capacity * 2;
-        BreadValue* new_items = realloc(a->items, sizeof(BreadValue) * new_cap);
-        if (!new_items) return 0;
-        a->items = new_items;
-        a->capacity = new_cap;
-    }
-    a->items[a->count++] = bread_value_clone(v);
+    if (a->count >= a->capacity && !bread_array_reserve(a, a->count + 1)) return 0;
+    bread_array_put(a, a->count++, v);
     return 1;
 }
 
 BreadValue* bread_array_get(BreadArray* a, int idx) {
     if (!a || idx < 0 || idx >= a->count) return NULL;
+    if (!bread_array_box(a)) return NULL;
     return &a->items[idx];
 }
 
@@ -98,9 +436,10 @@ int bread_array_set(BreadArray* a, int idx, BreadValue v) {
     if (a->element_type != TYPE_NIL && a->element_type != v.type) {
         return 0;
     }
+    if (!bread_array_writable(a)) return 0;
     
-    bread_value_release(&a->items[idx]);
-    a->items[idx] = bread_value_clone(v);
+    if (a->items) bread_value_release(&a->items[idx]);
+    bread_array_put(a, idx, v);
     return 1;
 }
 
@@ -123,7 +462,7 @@ BreadArray* bread_array_from_literal(BreadValue* elements, int count) {
     BreadArray* array = bread_array_new_with_capacity(count, element_type);
     if (!array) return NULL;
     for (int i = 0; i < count; i++) {
-        array->items[i] = bread_value_clone(elements[i]);
+        bread_array_put(array, i, elements[i]);
         array->count++;
     }
     
@@ -139,7 +478,7 @@ BreadArray* bread_array_repeating(BreadValue value, int count) {
     BreadArray* array = bread_array_new_with_capacity(count, value.type);
     if (!array) return NULL;
     for (int i = 0; i < count; i++) {
-        array->items[i] = bread_value_clone(value);
+        bread_array_put(array, i, value);
         array->count++;
     }
     
@@ -164,6 +503,7 @@ BreadValue* bread_array_get_safe(BreadArray* array, int index) {
         return NULL;
     }
     
+    if (!bread_array_box(array)) return NULL;
     return &array->items[index];
 }
 
@@ -194,9 +534,10 @@ int bread_array_set_safe(BreadArray* array, int index, BreadValue value) {
         BREAD_ERROR_SET_TYPE_MISMATCH(error_msg);
         return 0;
     }
+    if (!bread_array_writable(array)) return 0;
     
-    bread_value_release(&array->items[index]);
-    array->items[index] = bread_value_clone(value);
+    if (array->items) bread_value_release(&array->items[index]);
+    bread_array_put(array, index, value);
     return 1;
 }
 
@@ -241,22 +582,29 @@ int bread_array_insert(BreadArray* array, BreadValue value, int index) {
         array->element_type = value.type;
     }
     
-    if (array->count >= array->capacity) {
-        int new_cap = array->capacity == 0 ? 8 : array->capacity * 2;
-        BreadValue* new_items = realloc(array->items, sizeof(BreadValue) * new_cap);
-        if (!new_items) {
+    if (index < array->count - index) {
+        if (!bread_array_reserve_front(array)) {
             BREAD_ERROR_SET_MEMORY_ALLOCATION("Failed to allocate memory for array growth");
             return 0;
         }
-        array->items = new_items;
-        array->capacity = new_cap;
-    }
-    
-    for (int i = array->count; i > index; i--) {
-        array->items[i] = array->items[i - 1];
+        size_t width = bread_array_width(array);
+        char* data = bread_array_data(array);
+        memmove(data - width, data, (size_t)index * width);
+        bread_array_set_data(array, data - width);
+        array->head--;
+        array->capacity++;
+    } else {
+        if (array->count >= array->capacity && !bread_array_reserve(array, array->count + 1)) {
+            BREAD_ERROR_SET_MEMORY_ALLOCATION("Failed to allocate memory for array growth");
+            return 0;
+        }
+        size_t width = bread_array_width(array);
+        char* data = bread_array_data(array);
+        memmove(data + (size_t)(index + 1) * width, data + (size_t)index * width,
+                (size_t)(array->count - index) * width);
     }
     
-    array->items[index] = bread_value_clone(value);
+    bread_array_put(array, index, value);
     array->count++;
     
     return 1;
@@ -285,62 +633,82 @@ BreadValue bread_array_remove_at(BreadArray* array, int index) {
         return null_value;
     }
     
-    BreadValue removed_value = bread_value_clone(array->items[index]);
-    bread_value_release(&array->items[index]);
-    
-    for (int i = index; i < array->count - 1; i++) {
-        array->items[i] = array->items[i + 1];
+    if (!bread_array_writable(array)) return null_value;
+
+    BreadValue removed_value = bread_value_clone(bread_array_at(array, index));
+    if (array->items) bread_value_release(&array->items[index]);
+    
+    size_t width = bread_array_width(array);
+    char* data = bread_array_data(array);
+    if (index < array->count - index - 1) {
+        memmove(data + width, data, (size_t)index * width);
+        bread_array_set_data(array, data + width);
+        array->head++;
+        array->capacity--;
+    } else {
+        memmove(data + (size_t)index * width, data + (size_t)(index + 1) * width,
+                (size_t)(array->count - index - 1) * width);
     }
     
     array->count--;
+    if (array->count == 0 && array->head > 0) {
+        bread_array_set_data(array, bread_array_data(array) - (size_t)array->head * width);
+        array->capacity += array->head;
+        array->head = 0;
+    }
     
     return removed_value;
 }
 
 int bread_array_contains(BreadArray* array, BreadValue value) {
-    if (!array) return 0;
-    
-    for (int i = 0; i < array->count; i++) {
-        BreadValue* element = &array->items[i];
-        if (element->type != value.type) continue;
-        
+    return bread_array_index_of(array, value) >= 0;
+}
+
+int bread_array_index_of(BreadArray* array, BreadValue value) {
+    if (!array) return -1;
+
+    if (array->range_step) {
+        if (value.type != TYPE_INT) return -1;
+        int64_t v = value.value.int_val, start = array->range_start, step = array->range_step;
+        if (step > 0 ? v < start : v > start) return -1;
+        uint64_t offset = step > 0 ? (uint64_t)v - (uint64_t)start : (uint64_t)start - (uint64_t)v;
+        uint64_t stride = step > 0 ? (uint64_t)step : 0 - (uint64_t)step;
+        if (offset % stride != 0 || offset / stride >= (uint64_t)array->count) return -1;
+        return (int)(offset / stride);
+    }
+
+    if (array->unboxed) {
+        if (value.type != array->element_type) return -1;
         switch (value.type) {
-            case TYPE_INT:
-                if (element->value.int_val == value.value.int_val) {
-                    return 1;
-                }
-                break;
-            case TYPE_DOUBLE:
-                if (element->value.double_val == value.value.double_val) {
-                    return 1;
+            case TYPE_INT: {
+                const int64_t* ints = array->unboxed;
+                for (int i = 0; i < array->count; i++) {
+                    if (ints[i] == value.value.int_val) return i;
                 }
-                break;
-            case TYPE_BOOL:
-                if (element->value.bool_val == value.value.bool_val) {
-                    return 1;
+                return -1;
+            }
+            case TYPE_DOUBLE: {
+                const double* doubles = array->unboxed;
+                for (int i = 0; i < array->count; i++) {
+                    if (doubles[i] == value.value.double_val) return i;
                 }
-                break;
-            case TYPE_STRING:
-                if (element->value.string_val && value.value.string_val) {
-                    const char* elem_str = bread_string_cstr(element->value.string_val);
-                    const char* val_str = bread_string_cstr(value.value.string_val);
-                    if (strcmp(elem_str, val_str) == 0) {
-                        return 1;
-                    }
+                return -1;
+            }
+            default: {
+                const uint8_t* bools = array->unboxed;
+                for (int i = 0; i < array->count; i++) {
+                    if (bools[i] == (value.value.bool_val != 0)) return i;
                 }
-                break;
-            case TYPE_NIL:
-                return 1; // NIL equals NIL
-            default:
-                break;
+                return -1;
+            }
         }
     }
-    
-    return 0;
-}
 
-int bread_array_index_of(BreadArray* array, BreadValue value) {
-    if (!array) return -1;
+    // a loop of its own, so most elements are rejected on length inline
+    if (value.type == TYPE_STRING) {
+        return value.value.string_val ? bread_string_index_in(array->items, array->count, value.value.string_val)
+                                      : -1;
+    }
     
     for (int i = 0; i < array->count; i++) {
         BreadValue* element = &array->items[i];
@@ -362,15 +730,6 @@ int bread_array_index_of(BreadArray* array, BreadValue value) {
                     return i;
                 }
                 break;
-            case TYPE_STRING:
-                if (element->value.string_val && value.value.string_val) {
-                    const char* elem_str = bread_string_cstr(element->value.string_val);
-                    const char* val_str = bread_string_cstr(value.value.string_val);
-                    if (strcmp(elem_str, val_str) == 0) {
-                        return i;
-                    }
-                }
-                break;
             case TYPE_NIL:
                 return i; 
             default:
@@ -232,7 +232,7 @@ void bread_class_set_field(BreadClass* c, const char* field_name, BreadValue val
     int index = bread_class_find_field_index(c, field_name);
     if (index >= 0) {
         bread_value_release(&c->field_values[index]);
-        c->field_values[index] = bread_value_clone(value);
+        c->field_values[index] = bread_value_promote(value);
     }
 }
 
@@ -242,7 +242,7 @@ void bread_class_set_field_value_ptr(BreadClass* c, const char* field_name, cons
     int index = bread_class_find_field_index(c, field_name);
     if (index >= 0) {
         bread_value_release(&c->field_values[index]);
-        c->field_values[index] = bread_value_clone(*value);
+        c->field_values[index] = bread_value_promote(*value);
     }
 }
 
@@ -378,6 +378,8 @@ void bread_class_release(BreadClass* c) {
         free(c->methods);
         free(c->compiled_methods);
         bread_memory_free(c);
+    } else {
+        bread_memory_possible_cycle_root(c);
     }
 }
 
@@ -24,6 +24,16 @@ ExprResult bread_expr_result_from_value(BreadValue v) {
     return r;
 }
 
+// Like bread_value_clone, for stores that outlive the current statement:
+// a young string is copied out of the nursery.
+BreadValue bread_value_promote(BreadValue v) {
+    if (v.type != TYPE_STRING) return bread_value_clone(v);
+    
+    BreadValue out = v;
+    out.value.string_val = bread_string_promote(v.value.string_val);
+    return out;
+}
+
 BreadValue bread_value_clone(BreadValue v) {
     BreadValue out;
     memset(&out, 0, sizeof(out));
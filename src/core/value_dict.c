@@ -6,11 +6,6 @@
 #include "runtime/memory.h"
 #include "runtime/error.h"
 
-static int bread_string_equals(const BreadString* bs, const char* str) {
-    if (!bs || !str) return 0;
-    return strcmp(bread_string_cstr(bs), str) == 0;
-}
-
 BreadDict* bread_dict_new(void) {
     BreadDict* d = (BreadDict*)bread_memory_alloc(sizeof(BreadDict), BREAD_OBJ_DICT);
     if (!d) return NULL;
@@ -22,6 +17,17 @@ BreadDict* bread_dict_new(void) {
     return d;
 }
 
+BreadDict* bread_dict_new_in_arena(void) {
+    BreadDict* d = (BreadDict*)bread_memory_alloc_arena(sizeof(BreadDict), BREAD_OBJ_DICT);
+    if (!d) return NULL;
+    d->count = 0;
+    d->capacity = 0;
+    d->key_type = TYPE_NIL;
+    d->value_type = TYPE_NIL;
+    d->entries = NULL;
+    return d;
+}
+
 BreadDict* bread_dict_new_with_capacity(int capacity, VarType key_type, VarType value_type) {
     BreadDict* d = (BreadDict*)bread_memory_alloc(sizeof(BreadDict), BREAD_OBJ_DICT);
     if (!d) return NULL;
@@ -30,7 +36,7 @@ BreadDict* bread_dict_new_with_capacity(int capacity, VarType key_type, VarType
     d->key_type = key_type;      
     d->value_type = value_type;
     if (capacity > 0) {
-        d->entries = calloc(capacity, sizeof(BreadDictEntry));
+        d->entries = bread_memory_alloc_backing(sizeof(BreadDictEntry) * capacity, 1);
         if (!d->entries) {
             bread_memory_free(d);
             return NULL;
@@ -57,19 +63,9 @@ uint32_t bread_dict_hash_key(BreadValue key) {
             uint32_t h2 = (uint32_t)(u.i >> 32);
             return h1 ^ h2;
         }
-        case TYPE_STRING: {
+        case TYPE_STRING:
             if (!key.value.string_val) return 0;
-            const char* str = bread_string_cstr(key.value.string_val);
-            size_t len = bread_string_len(key.value.string_val);
-            
-            // FNV-1a hash
-            uint32_t hash = 2166136261u;
-            for (size_t i = 0; i < len; i++) {
-                hash ^= (uint32_t)str[i];
-                hash *= 16777619u;
-            }
-            return hash;
-        }
+            return (uint32_t)bread_string_hash(key.value.string_val);
         case TYPE_BOOL:
             return key.value.bool_val ? 1 : 0;
         case TYPE_NIL:
@@ -110,9 +106,7 @@ int bread_dict_find_slot(BreadDict* dict, BreadValue key) {
                     break;
                 case TYPE_STRING:
                     if (entry->key.value.string_val && key.value.string_val) {
-                        const char* entry_str = bread_string_cstr(entry->key.value.string_val);
-                        const char* key_str = bread_string_cstr(key.value.string_val);
-                        keys_equal = (strcmp(entry_str, key_str) == 0);
+                        keys_equal = bread_string_eq(entry->key.value.string_val, key.value.string_val);
                     }
                     break;
                 case TYPE_NIL:
@@ -168,8 +162,8 @@ BreadDict* bread_dict_from_literal(BreadDictEntry* entries, int count) {
     for (int i = 0; i < count; i++) {
         int slot = bread_dict_find_slot(dict, entries[i].key);
         if (slot >= 0) {
-            dict->entries[slot].key = bread_value_clone(entries[i].key);
-            dict->entries[slot].value = bread_value_clone(entries[i].value);
+            dict->entries[slot].key = bread_value_promote(entries[i].key);
+            dict->entries[slot].value = bread_value_promote(entries[i].value);
             dict->entries[slot].is_occupied = 1;
             dict->entries[slot].is_deleted = 0;
             dict->count++;
@@ -259,12 +253,12 @@ int bread_dict_set_safe(BreadDict* dict, BreadValue key, BreadValue value) {
     
     if (dict->entries[slot].is_occupied && !dict->entries[slot].is_deleted) {
         bread_value_release(&dict->entries[slot].value);
-        dict->entries[slot].value = bread_value_clone(value);
+        dict->entries[slot].value = bread_value_promote(value);
         return 1;
     }
     
-    dict->entries[slot].key = bread_value_clone(key);
-    dict->entries[slot].value = bread_value_clone(value);
+    dict->entries[slot].key = bread_value_promote(key);
+    dict->entries[slot].value = bread_value_promote(value);
     dict->entries[slot].is_occupied = 1;
     dict->entries[slot].is_deleted = 0;
     dict->count++;
@@ -284,12 +278,10 @@ void bread_dict_resize(BreadDict* dict, int new_capacity) {
     int old_capacity = dict->capacity;
     
     // Allocate new table
-    dict->entries = calloc(new_capacity, sizeof(BreadDictEntry));
-    if (!dict->entries) {
-        dict->entries = old_entries; // Restore on failure
-        return;
-    }
+    BreadDictEntry* new_entries = bread_memory_alloc_backing(sizeof(BreadDictEntry) * new_capacity, 1);
+    if (!new_entries) return;
     
+    dict->entries = new_entries;
     dict->capacity = new_capacity;
     dict->count = 0;
     
@@ -303,9 +295,7 @@ void bread_dict_resize(BreadDict* dict, int new_capacity) {
         }
     }
     
-    if (old_entries) {
-        free(old_entries);
-    }
+    bread_memory_free_backing(old_entries, sizeof(BreadDictEntry) * old_capacity);
 }
 
 BreadArray* bread_dict_keys(BreadDict* dict) {
@@ -435,17 +425,34 @@ void bread_dict_release(BreadDict* d) {
                     bread_value_release(&d->entries[i].value);
                 }
             }
-            free(d->entries);
+            bread_memory_free_backing(d->entries, sizeof(BreadDictEntry) * d->capacity);
         }
         bread_memory_free(d);
+    } else {
+        bread_memory_possible_cycle_root(d);
     }
 }
 
-int bread_dict_set(BreadDict* d, const char* key, BreadValue v) {
-    if (!d || !key) return 0;
+// Index of the live entry whose key is the given string, or -1. Cached
+// hashes reject almost every mismatch without touching string data.
+static int bread_dict_index_of_string(BreadDict* d, const char* key, size_t len, uint64_t hash) {
+    for (int i = 0; i < d->capacity; i++) {
+        BreadDictEntry* e = &d->entries[i];
+        if (!e->is_occupied || e->is_deleted || e->key.type != TYPE_STRING) continue;
+        BreadString* k = e->key.value.string_val;
+        if (k && bread_string_hash(k) == hash && k->len == len && memcmp(bread_string_data(k), key, len) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Takes ownership of the reference in `key`.
+static int bread_dict_set_owned_key(BreadDict* d, BreadString* key, BreadValue v) {
+    if (!key) return 0;
     BreadValue key_val;
     key_val.type = TYPE_STRING;
-    key_val.value.string_val = bread_string_new(key);
+    key_val.value.string_val = key;
     if (d->key_type != TYPE_NIL && d->key_type != TYPE_STRING) {
         bread_string_release(key_val.value.string_val);
         return 0;
@@ -463,21 +470,17 @@ int bread_dict_set(BreadDict* d, const char* key, BreadValue v) {
         d->value_type = v.type;
     }
     
-    for (int i = 0; i < d->capacity; i++) {
-        if (d->entries[i].is_occupied && !d->entries[i].is_deleted) {
-            if (d->entries[i].key.type == TYPE_STRING && 
-                bread_string_equals(d->entries[i].key.value.string_val, key)) {
-                bread_value_release(&d->entries[i].value);
-                d->entries[i].value = bread_value_clone(v);
-                bread_string_release(key_val.value.string_val);
-                return 1;
-            }
-        }
+    int existing = bread_dict_index_of_string(d, bread_string_data(key), key->len, bread_string_hash(key));
+    if (existing >= 0) {
+        bread_value_release(&d->entries[existing].value);
+        d->entries[existing].value = bread_value_promote(v);
+        bread_string_release(key_val.value.string_val);
+        return 1;
     }
     
     if (d->count >= d->capacity * 0.75) {
         int new_capacity = d->capacity == 0 ? 8 : d->capacity * 2;
-        BreadDictEntry* new_entries = calloc(new_capacity, sizeof(BreadDictEntry));
+        BreadDictEntry* new_entries = bread_memory_alloc_backing(sizeof(BreadDictEntry) * new_capacity, 1);
         if (!new_entries) {
             bread_string_release(key_val.value.string_val);
             return 0;
@@ -506,7 +509,7 @@ int bread_dict_set(BreadDict* d, const char* key, BreadValue v) {
             }
         }
         
-        if (old_entries) free(old_entries);
+        bread_memory_free_backing(old_entries, sizeof(BreadDictEntry) * old_capacity);
     }
     
     int slot = -1;
@@ -519,7 +522,7 @@ int bread_dict_set(BreadDict* d, const char* key, BreadValue v) {
     
     if (slot >= 0) {
         d->entries[slot].key = key_val;
-        d->entries[slot].value = bread_value_clone(v);
+        d->entries[slot].value = bread_value_promote(v);
         d->entries[slot].is_occupied = 1;
         d->entries[slot].is_deleted = 0;
         d->count++;
@@ -530,17 +533,25 @@ int bread_dict_set(BreadDict* d, const char* key, BreadValue v) {
     return 0;
 }
 
+int bread_dict_set(BreadDict* d, const char* key, BreadValue v) {
+    if (!d || !key) return 0;
+    return bread_dict_set_owned_key(d, bread_string_new(key), v);
+}
+
+int bread_dict_set_string(BreadDict* d, BreadString* key, BreadValue v) {
+    if (!d || !key) return 0;
+    return bread_dict_set_owned_key(d, bread_string_promote(key), v);
+}
+
 BreadValue* bread_dict_get(BreadDict* d, const char* key) {
     if (!d || !key) return NULL;
-    
-    for (int i = 0; i < d->capacity; i++) {
-        if (d->entries[i].is_occupied && !d->entries[i].is_deleted) {
-            if (d->entries[i].key.type == TYPE_STRING && 
-                bread_string_equals(d->entries[i].key.value.string_val, key)) {
-                return &d->entries[i].value;
-            }
-        }
-    }
-    
-    return NULL;
+    size_t len = strlen(key);
+    int i = bread_dict_index_of_string(d, key, len, bread_hash_bytes(key, len));
+    return i >= 0 ? &d->entries[i].value : NULL;
+}
+
+BreadValue* bread_dict_get_string(BreadDict* d, const BreadString* key) {
+    if (!d || !key) return NULL;
+    int i = bread_dict_index_of_string(d, bread_string_data(key), key->len, bread_string_hash(key));
+    return i >= 0 ? &d->entries[i].value : NULL;
 }
\ No newline at end of file
@@ -18,7 +18,7 @@ BreadOptional* bread_optional_new_some(BreadValue v) {
     BreadOptional* o = (BreadOptional*)bread_memory_alloc(sizeof(BreadOptional), BREAD_OBJ_OPTIONAL);
     if (!o) return NULL;
     o->is_some = 1;
-    o->value = bread_value_clone(v);
+    o->value = bread_value_promote(v);
     return o;
 }
 
@@ -38,5 +38,7 @@ void bread_optional_release(BreadOptional* o) {
             bread_value_release(&o->value);
         }
         bread_memory_free(o);
+    } else {
+        bread_memory_possible_cycle_root(o);
     }
 }
\ No newline at end of file
@@ -6,12 +6,13 @@
 #include "runtime/memory.h"
 #include "runtime/error.h"
 
-BreadStruct* bread_struct_new(const char* type_name, int field_count, char** field_names) {
+static BreadStruct* bread_struct_new_in(const char* type_name, int field_count, char** field_names, int in_arena) {
     if (!type_name || field_count < 0 || (field_count > 0 && !field_names)) {
         return NULL;
     }
     
-    BreadStruct* s = (BreadStruct*)bread_memory_alloc(sizeof(BreadStruct), BREAD_OBJ_STRUCT);
+    BreadStruct* s = (BreadStruct*)(in_arena ? bread_memory_alloc_arena(sizeof(BreadStruct), BREAD_OBJ_STRUCT)
+                                             : bread_memory_alloc(sizeof(BreadStruct), BREAD_OBJ_STRUCT));
     if (!s) return NULL;
     
     s->type_name = strdup(type_name);
@@ -42,13 +43,21 @@ BreadStruct* bread_struct_new(const char* type_name, int field_count, char** fie
     return s;
 }
 
+BreadStruct* bread_struct_new(const char* type_name, int field_count, char** field_names) {
+    return bread_struct_new_in(type_name, field_count, field_names, 0);
+}
+
+BreadStruct* bread_struct_new_in_arena(const char* type_name, int field_count, char** field_names) {
+    return bread_struct_new_in(type_name, field_count, field_names, 1);
+}
+
 void bread_struct_set_field(BreadStruct* s, const char* field_name, BreadValue value) {
     if (!s || !field_name) return;
     
     int index = bread_struct_find_field_index(s, field_name);
     if (index >= 0) {
         bread_value_release(&s->field_values[index]);
-        s->field_values[index] = bread_value_clone(value);
+        s->field_values[index] = bread_value_promote(value);
     }
 }
 
@@ -109,5 +118,7 @@ void bread_struct_release(BreadStruct* s) {
         }
         
         bread_memory_free(s);
+    } else {
+        bread_memory_possible_cycle_root(s);
     }
 }
\ No newline at end of file
@@ -136,7 +136,7 @@ static int retain_value_by_type(VarType type, VarValue* value) {
     switch (type) {
         case TYPE_STRING:
             if (value->string_val) {
-                bread_string_retain(value->string_val);
+                value->string_val = bread_string_promote(value->string_val);
             } else {
                 value->string_val = bread_string_new("");
                 if (!value->string_val) return 0;
@@ -364,7 +364,7 @@ static int coerce_and_assign(Variable* target, VarType source_type, VarValue sou
         case TYPE_STRING: {
             BreadString* s = coerced_value.string_val;
             if (s) {
-                bread_string_retain(s);
+                s = bread_string_promote(s);
             } else {
                 s = bread_string_new("");
                 if (!s) return 0;
@@ -14,6 +14,7 @@
 #include "core/module.h"
 #include "backends/llvm_backend.h"
 #include "codegen/codegen_runtime_bridge.h"
+#include "compiler/analysis/escape_analysis.h"
 
 #define MAX_FILE_SIZE 1048576  // 1MB max file size
 #define VERSION "1.0.0"
@@ -30,6 +31,14 @@ typedef struct {
     const char* input_file;
     const char* output_file;
     int verbose;
+    size_t heap_limit;
+    size_t pool_retain;
+    int has_pool_retain;
+    size_t gc_slice_us;
+    size_t gc_slice_objects;
+    int gc_threads;
+    const char* alloc_profile;
+    size_t alloc_sample;
 } CompilerConfig;
 
 static char* normalize_source(const char* src, size_t len, size_t* out_len) {
@@ -111,6 +120,17 @@ static void print_usage(const char* prog) {
     printf("  --jit                 Execute using JIT compilation\n");
     printf("  -o <file>             Output path for emit operations\n");
     printf("  --verbose             Enable verbose output\n");
+    printf("  --heap-limit <size>   Soft heap limit for --jit runs (e.g. 256M)\n");
+    printf("  --pool-retain <size>  Empty pool memory kept before returning it to the OS\n");
+    printf("  --gc-slice-us <n>     Incremental cycle collection, at most n microseconds per slice\n");
+    printf("  --gc-slice-objects <n> Incremental cycle collection, at most n objects per slice\n");
+    printf("  --gc-threads <n>      Marking threads for large collections (default: CPU count, max %d)\n",
+           BREAD_GC_MAX_THREADS);
+    printf("  --alloc-profile <file> Report allocations per source line at exit (- for stderr)\n");
+    printf("  --alloc-sample <size> Sample about one allocation per <size> bytes (e.g. 512K)\n");
+    printf("\nCompiled executables read BREAD_HEAP_LIMIT, BREAD_POOL_RETAIN,\n");
+    printf("BREAD_GC_SLICE_US and BREAD_GC_SLICE_OBJECTS instead; profiling builds\n");
+    printf("also read BREAD_ALLOC_PROFILE and BREAD_ALLOC_SAMPLE.\n");
 }
 
 static int parse_arguments(int argc, char* argv[], CompilerConfig* config) {
@@ -119,6 +139,14 @@ static int parse_arguments(int argc, char* argv[], CompilerConfig* config) {
     config->input_file = NULL;
     config->output_file = NULL;
     config->verbose = 0;
+    config->heap_limit = 0;
+    config->pool_retain = 0;
+    config->has_pool_retain = 0;
+    config->gc_slice_us = 0;
+    config->gc_slice_objects = 0;
+    config->gc_threads = 0;
+    config->alloc_profile = NULL;
+    config->alloc_sample = 0;
     
     int mode_count = 0;
 
@@ -165,6 +193,69 @@ static int parse_arguments(int argc, char* argv[], CompilerConfig* config) {
             continue;
         }
         
+        if (strcmp(argv[i], "--heap-limit") == 0) {
+            if (i + 1 >= argc || !bread_memory_parse_size(argv[i + 1], &config->heap_limit)) {
+                fprintf(stderr, "Error: --heap-limit requires a size argument (e.g. 256M)\n");
+                return 1;
+            }
+            i++;
+            continue;
+        }
+        
+        if (strcmp(argv[i], "--pool-retain") == 0) {
+            if (i + 1 >= argc || !bread_memory_parse_size(argv[i + 1], &config->pool_retain)) {
+                fprintf(stderr, "Error: --pool-retain requires a size argument (e.g. 4M)\n");
+                return 1;
+            }
+            config->has_pool_retain = 1;
+            i++;
+            continue;
+        }
+        
+        if (strcmp(argv[i], "--gc-slice-us") == 0 || strcmp(argv[i], "--gc-slice-objects") == 0) {
+            if (i + 1 >= argc || !isdigit((unsigned char)argv[i + 1][0])) {
+                fprintf(stderr, "Error: %s requires a number\n", argv[i]);
+                return 1;
+            }
+            size_t budget = (size_t)strtoull(argv[i + 1], NULL, 10);
+            if (strcmp(argv[i], "--gc-slice-us") == 0) {
+                config->gc_slice_us = budget;
+            } else {
+                config->gc_slice_objects = budget;
+            }
+            i++;
+            continue;
+        }
+        
+        if (strcmp(argv[i], "--gc-threads") == 0) {
+            if (i + 1 >= argc || !isdigit((unsigned char)argv[i + 1][0])) {
+                fprintf(stderr, "Error: --gc-threads requires a number\n");
+                return 1;
+            }
+            config->gc_threads = atoi(argv[i + 1]);
+            i++;
+            continue;
+        }
+        
+        if (strcmp(argv[i], "--alloc-profile") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Error: --alloc-profile requires a file name\n");
+                return 1;
+            }
+            config->alloc_profile = argv[i + 1];
+            i++;
+            continue;
+        }
+        
+        if (strcmp(argv[i], "--alloc-sample") == 0) {
+            if (i + 1 >= argc || !bread_memory_parse_size(argv[i + 1], &config->alloc_sample)) {
+                fprintf(stderr, "Error: --alloc-sample requires a size argument (e.g. 512K)\n");
+                return 1;
+            }
+            i++;
+            continue;
+        }
+        
         if (argv[i][0] == '-') {
             fprintf(stderr, "Error: Unknown option '%s'\n", argv[i]);
             return 1;
@@ -280,9 +371,9 @@ static void cleanup_runtime(void) {
     bread_error_cleanup();
     bread_builtin_cleanup();
     bread_string_intern_cleanup();
-    bread_memory_cleanup();
     cleanup_functions();
     cleanup_variables();
+    bread_memory_cleanup();
 }
 
 static const char* get_default_output(CompilationMode mode) {
@@ -348,6 +439,11 @@ static int compile_or_execute(ASTStmtList* program, const CompilerConfig* config
         }
     }
     
+    if (config->verbose) {
+        printf("Collection literals allocated in call arenas: %d\n",
+               escape_analysis_arena_site_count());
+    }
+    
     if (result != 0 && bread_error_has_error()) {
         bread_error_print_current();
     }
@@ -379,6 +475,21 @@ int main(int argc, char* argv[]) {
     }
     
     init_runtime(config.verbose);
+    if (config.heap_limit) {
+        bread_memory_set_heap_limit(config.heap_limit);
+    }
+    if (config.has_pool_retain) {
+        bread_memory_set_pool_retention(config.pool_retain);
+    }
+    if (config.gc_slice_us || config.gc_slice_objects) {
+        bread_memory_set_incremental_gc(config.gc_slice_us, config.gc_slice_objects);
+    }
+    if (config.gc_threads) {
+        bread_memory_set_gc_threads(config.gc_threads);
+    }
+    if (config.alloc_profile || config.alloc_sample) {
+        bread_llvm_set_alloc_profile(config.alloc_profile ? config.alloc_profile : "-", config.alloc_sample);
+    }
     module_system_init();
 
      if (config.input_file) {
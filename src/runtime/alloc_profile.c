@@ -0,0 +1,300 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "runtime/alloc_profile.h"
+#include "runtime/memory.h"
+
+// Per-site totals are estimates under sampling, hence doubles
+typedef struct {
+    const char* file; // NULL for allocations made outside any statement
+    int32_t line;
+    int32_t column;
+    double alloc_objects;
+    double alloc_bytes;
+    double live_objects;
+    double live_bytes;
+} BreadAllocSite;
+
+// Sampled objects still alive, keyed by address
+typedef struct {
+    void* object;
+    uint32_t site;
+    double objects;
+    double bytes;
+} BreadAllocLive;
+
+typedef struct {
+    char* path;
+    size_t sample_bytes; // 0 records every allocation
+    int64_t countdown;
+    uint64_t rng;
+
+    BreadAllocSite* sites;
+    uint32_t site_count;
+    uint32_t site_capacity;
+    uint32_t* site_index; // open addressing, slot holds site + 1
+    uint32_t site_index_capacity;
+    uint32_t current;
+
+    BreadAllocLive* live;
+    size_t live_count;
+    size_t live_capacity;
+} BreadAllocProfile;
+
+int bread_alloc_profile_active = 0;
+static BreadAllocProfile g_prof;
+
+static inline uint64_t bread_alloc_hash_ptr(const void* p) {
+    uint64_t h = (uint64_t)(uintptr_t)p;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static inline uint64_t bread_alloc_hash_site(const char* file, int32_t line, int32_t column) {
+    return bread_alloc_hash_ptr(file) ^ ((uint64_t)(uint32_t)line * 0x9e3779b97f4a7c15ULL) ^
+           ((uint64_t)(uint32_t)column << 17);
+}
+
+// Exponentially distributed gap with mean sample_bytes, so periodic
+// allocation patterns cannot hide between samples.
+static int64_t bread_alloc_next_gap(void) {
+    g_prof.rng ^= g_prof.rng << 13;
+    g_prof.rng ^= g_prof.rng >> 7;
+    g_prof.rng ^= g_prof.rng << 17;
+    double u = ((double)(g_prof.rng >> 11) + 1.0) / 9007199254740993.0;
+    return (int64_t)(-log(u) * (double)g_prof.sample_bytes) + 1;
+}
+
+static int bread_alloc_grow_site_index(void) {
+    uint32_t capacity = g_prof.site_index_capacity ? g_prof.site_index_capacity * 2 : 256;
+    uint32_t* index = calloc(capacity, sizeof(uint32_t));
+    if (!index) return 0;
+
+    for (uint32_t i = 0; i < g_prof.site_count; i++) {
+        BreadAllocSite* s = &g_prof.sites[i];
+        uint32_t slot = (uint32_t)bread_alloc_hash_site(s->file, s->line, s->column) & (capacity - 1);
+        while (index[slot]) slot = (slot + 1) & (capacity - 1);
+        index[slot] = i + 1;
+    }
+    free(g_prof.site_index);
+    g_prof.site_index = index;
+    g_prof.site_index_capacity = capacity;
+    return 1;
+}
+
+static uint32_t bread_alloc_find_site(const char* file, int32_t line, int32_t column) {
+    uint32_t mask = g_prof.site_index_capacity - 1;
+    uint32_t slot = (uint32_t)bread_alloc_hash_site(file, line, column) & mask;
+    for (;;) {
+        uint32_t entry = g_prof.site_index[slot];
+        if (!entry) break;
+        BreadAllocSite* s = &g_prof.sites[entry - 1];
+        if (s->file == file && s->line == line && s->column == column) return entry - 1;
+        slot = (slot + 1) & mask;
+    }
+
+    if (g_prof.site_count >= g_prof.site_capacity) {
+        uint32_t capacity = g_prof.site_capacity * 2;
+        BreadAllocSite* sites = realloc(g_prof.sites, capacity * sizeof(BreadAllocSite));
+        if (!sites) return 0;
+        g_prof.sites = sites;
+        g_prof.site_capacity = capacity;
+    }
+    uint32_t id = g_prof.site_count++;
+    memset(&g_prof.sites[id], 0, sizeof(BreadAllocSite));
+    g_prof.sites[id].file = file;
+    g_prof.sites[id].line = line;
+    g_prof.sites[id].column = column;
+    g_prof.site_index[slot] = id + 1;
+
+    // keep the index at most half full
+    if (g_prof.site_count * 2 > g_prof.site_index_capacity) {
+        bread_alloc_grow_site_index();
+    }
+    return id;
+}
+
+static int bread_alloc_grow_live(void) {
+    size_t capacity = g_prof.live_capacity ? g_prof.live_capacity * 2 : 1024;
+    BreadAllocLive* live = calloc(capacity, sizeof(BreadAllocLive));
+    if (!live) return 0;
+
+    for (size_t i = 0; i < g_prof.live_capacity; i++) {
+        BreadAllocLive* e = &g_prof.live[i];
+        if (!e->object) continue;
+        size_t slot = bread_alloc_hash_ptr(e->object) & (capacity - 1);
+        while (live[slot].object) slot = (slot + 1) & (capacity - 1);
+        live[slot] = *e;
+    }
+    free(g_prof.live);
+    g_prof.live = live;
+    g_prof.live_capacity = capacity;
+    return 1;
+}
+
+void bread_alloc_profile_start(const char* path, size_t sample_bytes) {
+    if (bread_alloc_profile_active) return;
+
+    // compiled executables can be redirected without recompiling
+    const char* env = getenv("BREAD_ALLOC_PROFILE");
+    if (env && *env) path = env;
+    env = getenv("BREAD_ALLOC_SAMPLE");
+    size_t bytes = 0;
+    if (env && bread_memory_parse_size(env, &bytes)) sample_bytes = bytes;
+
+    memset(&g_prof, 0, sizeof(g_prof));
+    g_prof.path = strdup(path && *path ? path : "-");
+    g_prof.sample_bytes = sample_bytes > 1 ? sample_bytes : 0;
+    g_prof.rng = 0x2545f4914f6cdd1dULL ^ (uint64_t)(uintptr_t)&g_prof;
+    g_prof.site_capacity = 64;
+    g_prof.sites = malloc(g_prof.site_capacity * sizeof(BreadAllocSite));
+    if (!g_prof.path || !g_prof.sites || !bread_alloc_grow_site_index()) {
+        free(g_prof.path);
+        free(g_prof.sites);
+        free(g_prof.site_index);
+        return;
+    }
+    g_prof.current = bread_alloc_find_site(NULL, 0, 0);
+    if (g_prof.sample_bytes) g_prof.countdown = bread_alloc_next_gap();
+    bread_alloc_profile_active = 1;
+}
+
+void bread_alloc_profile_set_site(const char* file, int32_t line, int32_t column) {
+    if (!bread_alloc_profile_active) return;
+    g_prof.current = bread_alloc_find_site(file, line, column);
+}
+
+uint32_t bread_alloc_profile_site(void) {
+    return g_prof.current;
+}
+
+// Compiled functions save the site at entry and put it back on return, so
+// what the calling statement allocates after the call is charged to it and
+// not to the callee's last statement
+void bread_alloc_profile_restore_site(uint32_t site) {
+    if (!bread_alloc_profile_active || site >= g_prof.site_count) return;
+    g_prof.current = site;
+}
+
+void bread_alloc_profile_record(void* object, size_t size, int tracked) {
+    if (!bread_alloc_profile_active || !object) return;
+
+    double weight = 1.0;
+    if (g_prof.sample_bytes) {
+        g_prof.countdown -= (int64_t)size;
+        if (g_prof.countdown > 0) return;
+        g_prof.countdown = bread_alloc_next_gap();
+        // chance of sampling an allocation of this size, undone here
+        double p = 1.0 - exp(-(double)size / (double)g_prof.sample_bytes);
+        if (p > 0.0) weight = 1.0 / p;
+    }
+
+    BreadAllocSite* site = &g_prof.sites[g_prof.current];
+    site->alloc_objects += weight;
+    site->alloc_bytes += weight * (double)size;
+    if (!tracked) return; // nursery and arena memory is reclaimed in bulk
+
+    if ((g_prof.live_count + 1) * 2 > g_prof.live_capacity && !bread_alloc_grow_live()) return;
+    size_t mask = g_prof.live_capacity - 1;
+    size_t slot = bread_alloc_hash_ptr(object) & mask;
+    while (g_prof.live[slot].object) slot = (slot + 1) & mask;
+    g_prof.live[slot].object = object;
+    g_prof.live[slot].site = g_prof.current;
+    g_prof.live[slot].objects = weight;
+    g_prof.live[slot].bytes = weight * (double)size;
+    g_prof.live_count++;
+    site->live_objects += weight;
+    site->live_bytes += weight * (double)size;
+}
+
+void bread_alloc_profile_forget(void* object) {
+    if (!bread_alloc_profile_active || g_prof.live_count == 0) return;
+
+    size_t mask = g_prof.live_capacity - 1;
+    size_t slot = bread_alloc_hash_ptr(object) & mask;
+    while (g_prof.live[slot].object != object) {
+        if (!g_prof.live[slot].object) return; // not sampled
+        slot = (slot + 1) & mask;
+    }
+
+    BreadAllocSite* site = &g_prof.sites[g_prof.live[slot].site];
+    site->live_objects -= g_prof.live[slot].objects;
+    site->live_bytes -= g_prof.live[slot].bytes;
+    g_prof.live_count--;
+
+    // backward-shift deletion keeps probe chains intact
+    size_t hole = slot;
+    for (size_t next = (hole + 1) & mask; g_prof.live[next].object; next = (next + 1) & mask) {
+        size_t home = bread_alloc_hash_ptr(g_prof.live[next].object) & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            g_prof.live[hole] = g_prof.live[next];
+            hole = next;
+        }
+    }
+    memset(&g_prof.live[hole], 0, sizeof(BreadAllocLive));
+}
+
+static int bread_alloc_site_compare(const void* a, const void* b) {
+    const BreadAllocSite* x = (const BreadAllocSite*)a;
+    const BreadAllocSite* y = (const BreadAllocSite*)b;
+    if (x->live_bytes != y->live_bytes) return x->live_bytes < y->live_bytes ? 1 : -1;
+    if (x->alloc_bytes != y->alloc_bytes) return x->alloc_bytes < y->alloc_bytes ? 1 : -1;
+    return 0;
+}
+
+static void bread_alloc_profile_write(FILE* out) {
+    qsort(g_prof.sites, g_prof.site_count, sizeof(BreadAllocSite), bread_alloc_site_compare);
+
+    double live_bytes = 0, alloc_bytes = 0;
+    for (uint32_t i = 0; i < g_prof.site_count; i++) {
+        live_bytes += g_prof.sites[i].live_bytes;
+        alloc_bytes += g_prof.sites[i].alloc_bytes;
+    }
+
+    fprintf(out, "=== Allocation Profile ===\n");
+    if (g_prof.sample_bytes) {
+        fprintf(out, "Sampling 1 in %zu bytes; figures are estimates\n", g_prof.sample_bytes);
+    }
+    fprintf(out, "Total: %.0f bytes allocated, %.0f bytes live at exit\n\n", alloc_bytes, live_bytes);
+    fprintf(out, "%14s %10s %14s %10s  %s\n", "live bytes", "live objs", "alloc bytes", "alloc objs", "site");
+    for (uint32_t i = 0; i < g_prof.site_count; i++) {
+        BreadAllocSite* s = &g_prof.sites[i];
+        if (s->alloc_objects < 0.5) continue;
+        fprintf(out, "%14.0f %10.0f %14.0f %10.0f  ", s->live_bytes, s->live_objects,
+                s->alloc_bytes, s->alloc_objects);
+        if (s->file) {
+            fprintf(out, "%s:%d:%d\n", s->file, s->line, s->column);
+        } else {
+            fprintf(out, "<runtime>\n");
+        }
+    }
+}
+
+// Writes the report; objects still live are what the program leaks or
+// holds in globals at exit.
+void bread_alloc_profile_stop(void) {
+    if (!bread_alloc_profile_active) return;
+    bread_alloc_profile_active = 0;
+
+    if (strcmp(g_prof.path, "-") == 0) {
+        bread_alloc_profile_write(stderr);
+    } else {
+        FILE* out = fopen(g_prof.path, "w");
+        if (out) {
+            bread_alloc_profile_write(out);
+            fclose(out);
+        } else {
+            fprintf(stderr, "Warning: could not write allocation profile to %s\n", g_prof.path);
+        }
+    }
+
+    free(g_prof.path);
+    free(g_prof.sites);
+    free(g_prof.site_index);
+    free(g_prof.live);
+    memset(&g_prof, 0, sizeof(g_prof));
+}
@@ -0,0 +1,445 @@
+#include <math.h>
+#include <string.h>
+
+#include "runtime/array_reduce.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BREAD_REDUCE_X86 1
+#endif
+
+#define BREAD_REDUCE_LANES 16
+
+typedef struct {
+    const char* name;
+    int64_t (*sum_i64)(const int64_t* xs, size_t n);
+    double (*sum_f64)(const double* xs, size_t n);
+    int64_t (*prod_i64)(const int64_t* xs, size_t n);
+    double (*prod_f64)(const double* xs, size_t n);
+    int64_t (*min_i64)(const int64_t* xs, size_t n);
+    double (*min_f64)(const double* xs, size_t n);
+    int64_t (*max_i64)(const int64_t* xs, size_t n);
+    double (*max_f64)(const double* xs, size_t n);
+    double (*mean_i64)(const int64_t* xs, size_t n);
+    int64_t (*dot_i64)(const int64_t* a, const int64_t* b, size_t n);
+    double (*dot_f64)(const double* a, const double* b, size_t n);
+} BreadReduceKernels;
+
+// Lane l holds elements l, l + 16, l + 32, ... Both kernels fold the lanes
+// like four 4-wide vectors, so Double results match bit for bit.
+static double bread_fold_sum(const double acc[BREAD_REDUCE_LANES]) {
+    double v[4];
+    for (int l = 0; l < 4; l++) v[l] = (acc[l] + acc[4 + l]) + (acc[8 + l] + acc[12 + l]);
+    return (v[0] + v[1]) + (v[2] + v[3]);
+}
+
+static double bread_fold_prod(const double acc[BREAD_REDUCE_LANES]) {
+    double v[4];
+    for (int l = 0; l < 4; l++) v[l] = (acc[l] * acc[4 + l]) * (acc[8 + l] * acc[12 + l]);
+    return (v[0] * v[1]) * (v[2] * v[3]);
+}
+
+// unsigned, so overflow wraps instead of being undefined
+static int64_t bread_sum_i64_scalar(const int64_t* xs, size_t n) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < n; i++) total += (uint64_t)xs[i];
+    return (int64_t)total;
+}
+
+static double bread_sum_f64_scalar(const double* xs, size_t n) {
+    double acc[BREAD_REDUCE_LANES] = {0};
+    size_t i = 0;
+    for (; i + BREAD_REDUCE_LANES <= n; i += BREAD_REDUCE_LANES) {
+        for (int l = 0; l < BREAD_REDUCE_LANES; l++) acc[l] += xs[i + l];
+    }
+    for (size_t l = 0; i + l < n; l++) acc[l] += xs[i + l];
+    return bread_fold_sum(acc);
+}
+
+static int64_t bread_prod_i64_scalar(const int64_t* xs, size_t n) {
+    uint64_t total = 1;
+    for (size_t i = 0; i < n; i++) total *= (uint64_t)xs[i];
+    return (int64_t)total;
+}
+
+static double bread_prod_f64_scalar(const double* xs, size_t n) {
+    double acc[BREAD_REDUCE_LANES];
+    for (int l = 0; l < BREAD_REDUCE_LANES; l++) acc[l] = 1.0;
+    size_t i = 0;
+    for (; i + BREAD_REDUCE_LANES <= n; i += BREAD_REDUCE_LANES) {
+        for (int l = 0; l < BREAD_REDUCE_LANES; l++) acc[l] *= xs[i + l];
+    }
+    for (size_t l = 0; i + l < n; l++) acc[l] *= xs[i + l];
+    return bread_fold_prod(acc);
+}
+
+static int64_t bread_min_i64_scalar(const int64_t* xs, size_t n) {
+    int64_t m = xs[0];
+    for (size_t i = 1; i < n; i++) m = xs[i] < m ? xs[i] : m;
+    return m;
+}
+
+static int64_t bread_max_i64_scalar(const int64_t* xs, size_t n) {
+    int64_t m = xs[0];
+    for (size_t i = 1; i < n; i++) m = xs[i] > m ? xs[i] : m;
+    return m;
+}
+
+static double bread_min_f64_scalar(const double* xs, size_t n) {
+    double m = xs[0];
+    for (size_t i = 0; i < n; i++) {
+        if (xs[i] != xs[i]) return NAN;
+        m = xs[i] < m ? xs[i] : m;
+    }
+    return m;
+}
+
+static double bread_max_f64_scalar(const double* xs, size_t n) {
+    double m = xs[0];
+    for (size_t i = 0; i < n; i++) {
+        if (xs[i] != xs[i]) return NAN;
+        m = xs[i] > m ? xs[i] : m;
+    }
+    return m;
+}
+
+static double bread_mean_i64_scalar(const int64_t* xs, size_t n) {
+    __int128 total = 0;
+    for (size_t i = 0; i < n; i++) total += xs[i];
+    return (double)total / (double)n;
+}
+
+static int64_t bread_dot_i64_scalar(const int64_t* a, const int64_t* b, size_t n) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < n; i++) total += (uint64_t)a[i] * (uint64_t)b[i];
+    return (int64_t)total;
+}
+
+static double bread_dot_f64_scalar(const double* a, const double* b, size_t n) {
+    double acc[BREAD_REDUCE_LANES] = {0};
+    size_t i = 0;
+    for (; i + BREAD_REDUCE_LANES <= n; i += BREAD_REDUCE_LANES) {
+        for (int l = 0; l < BREAD_REDUCE_LANES; l++) acc[l] += a[i + l] * b[i + l];
+    }
+    for (size_t l = 0; i + l < n; l++) acc[l] += a[i + l] * b[i + l];
+    return bread_fold_sum(acc);
+}
+
+static const BreadReduceKernels bread_reduce_scalar = {
+    "scalar",
+    bread_sum_i64_scalar, bread_sum_f64_scalar,
+    bread_prod_i64_scalar, bread_prod_f64_scalar,
+    bread_min_i64_scalar, bread_min_f64_scalar,
+    bread_max_i64_scalar, bread_max_f64_scalar,
+    bread_mean_i64_scalar,
+    bread_dot_i64_scalar, bread_dot_f64_scalar,
+};
+
+#ifdef BREAD_REDUCE_X86
+#define BREAD_AVX2 __attribute__((target("avx2")))
+
+BREAD_AVX2 static inline void bread_store_lanes_pd(double acc[BREAD_REDUCE_LANES], __m256d v0, __m256d v1,
+                                                   __m256d v2, __m256d v3) {
+    _mm256_storeu_pd(acc, v0);
+    _mm256_storeu_pd(acc + 4, v1);
+    _mm256_storeu_pd(acc + 8, v2);
+    _mm256_storeu_pd(acc + 12, v3);
+}
+
+// AVX2 has no 64-bit multiply; this is the low half of the product from
+// three 32 x 32 multiplies
+BREAD_AVX2 static inline __m256i bread_mullo_epi64(__m256i a, __m256i b) {
+    __m256i lo = _mm256_mul_epu32(a, b);
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                     _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+}
+
+BREAD_AVX2 static int64_t bread_sum_i64_avx2(const int64_t* xs, size_t n) {
+    __m256i v0 = _mm256_setzero_si256(), v1 = v0, v2 = v0, v3 = v0;
+    size_t i = 0;
+    for (; i + BREAD_REDUCE_LANES <= n; i += BREAD_REDUCE_LANES) {
+        v0 = _mm256_add_epi64(v0, _mm256_loadu_si256((const __m256i*)(xs + i)));
+        v1 = _mm256_add_epi64(v1, _mm256_loadu_si256((const __m256i*)(xs + i + 4)));
+        v2 = _mm256_add_epi64(v2, _mm256_loadu_si256((const __m256i*)(xs + i + 8)));
+        v3 = _mm256_add_epi64(v3, _mm256_loadu_si256((const __m256i*)(xs + i + 12)));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, _mm256_add_epi64(_mm256_add_epi64(v0, v1), _mm256_add_epi64(v2, v3)));
+    uint64_t total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    return (int64_t)(total + (uint64_t)bread_sum_i64_scalar(xs + i, n - i));
+}
+
+BREAD_AVX2 static double bread_sum_f64_avx2(const double* xs, size_t n) {
+    __m256d v0 = _mm256_setzero_pd(), v1 = v0, v2 = v0, v3 = v0;
+    size_t i = 0;
+    for (; i + BREAD_REDUCE_LANES <= n; i += BREAD_REDUCE_LANES) {
+        v0 = _mm256_add_pd(v0, _mm256_loadu_pd(xs + i));
+        v1 = _mm256_add_pd(v1, _mm256_loadu_pd(xs + i + 4));
+        v2 = _mm256_add_pd(v2, _mm256_loadu_pd(xs + i + 8));
+        v3 = _mm256_add_pd(v3, _mm256_loadu_pd(xs + i + 12));
+    }
+    double acc[BREAD_REDUCE_LANES];
+    bread_store_lanes_pd(acc, v0, v1, v2, v3);
+    for (size_t l = 0; i + l < n; l++) acc[l] += xs[i + l];
+    return bread_fold_sum(acc);
+}
+
+BREAD_AVX2 static int64_t bread_prod_i64_avx2(const int64_t* xs, size_t n) {
+    __m256i v0 = _mm256_set1_epi64x(1), v1 = v0, v2 = v0, v3 = v0;
+    size_t i = 0;
+    for (; i + BREAD_REDUCE_LANES <= n; i += BREAD_REDUCE_LANES) {
+        v0 = bread_mullo_epi64(v0, _mm256_loadu_si256((const __m256i*)(xs + i)));
+        v1 = bread_mullo_epi64(v1, _mm256_loadu_si256((const __m256i*)(xs + i + 4)));
+        v2 = bread_mullo_epi64(v2, _mm256_loadu_si256((const __m256i*)(xs + i + 8)));
+        v3 = bread_mullo_epi64(v3, _mm256_loadu_si256((const __m256i*)(xs + i + 12)));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, bread_mullo_epi64(bread_mullo_epi64(v0, v1), bread_mullo_epi64(v2, v3)));
+    uint64_t total = lanes[0] * lanes[1] * lanes[2] * lanes[3];
+    return (int64_t)(total * (uint64_t)bread_prod_i64_scalar(xs + i, n - i));
+}
+
+BREAD_AVX2 static double bread_prod_f64_avx2(const double* xs, size_t n) {
+    __m256d v0 = _mm256_set1_pd(1.0), v1 = v0, v2 = v0, v3 = v0;
+    size_t i = 0;
+    for (; i + BREAD_REDUCE_LANES <= n; i += BREAD_REDUCE_LANES) {
+        v0 = _mm256_mul_pd(v0, _mm256_loadu_pd(xs + i));
+        v1 = _mm256_mul_pd(v1, _mm256_loadu_pd(xs + i + 4));
+        v2 = _mm256_mul_pd(v2, _mm256_loadu_pd(xs + i + 8));
+        v3 = _mm256_mul_pd(v3, _mm256_loadu_pd(xs + i + 12));
+    }
+    double acc[BREAD_REDUCE_LANES];
+    bread_store_lanes_pd(acc, v0, v1, v2, v3);
+    for (size_t l = 0; i + l < n; l++) acc[l] *= xs[i + l];
+    return bread_fold_prod(acc);
+}
+
+// want_max picks the larger of each pair instead of the smaller
+BREAD_AVX2 static int64_t bread_minmax_i64_avx2(const int64_t* xs, size_t n, int want_max) {
+    __m256i v0 = _mm256_set1_epi64x(xs[0]), v1 = v0, v2 = v0, v3 = v0;
+    size_t i = 0;
+    for (; i + BREAD_REDUCE_LANES <= n; i += BREAD_REDUCE_LANES) {
+        __m256i x0 = _mm256_loadu_si256((const __m256i*)(xs + i));
+        __m256i x1 = _mm256_loadu_si256((const __m256i*)(xs + i + 4));
+        __m256i x2 = _mm256_loadu_si256((const __m256i*)(xs + i + 8));
+        __m256i x3 = _mm256_loadu_si256((const __m256i*)(xs + i + 12));
+        if (want_max) {
+            v0 = _mm256_blendv_epi8(v0, x0, _mm256_cmpgt_epi64(x0, v0));
+            v1 = _mm256_blendv_epi8(v1, x1, _mm256_cmpgt_epi64(x1, v1));
+            v2 = _mm256_blendv_epi8(v2, x2, _mm256_cmpgt_epi64(x2, v2));
+            v3 = _mm256_blendv_epi8(v3, x3, _mm256_cmpgt_epi64(x3, v3));
+        } else {
+            v0 = _mm256_blendv_epi8(v0, x0, _mm256_cmpgt_epi64(v0, x0));
+            v1 = _mm256_blendv_epi8(v1, x1, _mm256_cmpgt_epi64(v1, x1));
+            v2 = _mm256_blendv_epi8(v2, x2, _mm256_cmpgt_epi64(v2, x2));
+            v3 = _mm256_blendv_epi8(v3, x3, _mm256_cmpgt_epi64(v3, x3));
+        }
+    }
+    int64_t lanes[BREAD_REDUCE_LANES];
+    _mm256_storeu_si256((__m256i*)lanes, v0);
+    _mm256_storeu_si256((__m256i*)(lanes + 4), v1);
+    _mm256_storeu_si256((__m256i*)(lanes + 8), v2);
+    _mm256_storeu_si256((__m256i*)(lanes + 12), v3);
+    int64_t m = want_max ? bread_max_i64_scalar(lanes, BREAD_REDUCE_LANES) : bread_min_i64_scalar(lanes, BREAD_REDUCE_LANES);
+    if (i == n) return m;
+    int64_t rest = want_max ? bread_max_i64_scalar(xs + i, n - i) : bread_min_i64_scalar(xs + i, n - i);
+    return want_max ? (rest > m ? rest : m) : (rest < m ? rest : m);
+}
+
+BREAD_AVX2 static int64_t bread_min_i64_avx2(const int64_t* xs, size_t n) {
+    return bread_minmax_i64_avx2(xs, n, 0);
+}
+
+BREAD_AVX2 static int64_t bread_max_i64_avx2(const int64_t* xs, size_t n) {
+    return bread_minmax_i64_avx2(xs, n, 1);
+}
+
+// min_pd and max_pd drop a NaN in the first operand, so NaNs are tracked
+// on the side and win at the end
+BREAD_AVX2 static double bread_minmax_f64_avx2(const double* xs, size_t n, int want_max) {
+    __m256d v0 = _mm256_set1_pd(xs[0]), v1 = v0, v2 = v0, v3 = v0;
+    __m256d nan = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + BREAD_REDUCE_LANES <= n; i += BREAD_REDUCE_LANES) {
+        __m256d x0 = _mm256_loadu_pd(xs + i);
+        __m256d x1 = _mm256_loadu_pd(xs + i + 4);
+        __m256d x2 = _mm256_loadu_pd(xs + i + 8);
+        __m256d x3 = _mm256_loadu_pd(xs + i + 12);
+        nan = _mm256_or_pd(nan, _mm256_or_pd(_mm256_cmp_pd(x0, x1, _CMP_UNORD_Q), _mm256_cmp_pd(x2, x3, _CMP_UNORD_Q)));
+        if (want_max) {
+            v0 = _mm256_max_pd(x0, v0);
+            v1 = _mm256_max_pd(x1, v1);
+            v2 = _mm256_max_pd(x2, v2);
+            v3 = _mm256_max_pd(x3, v3);
+        } else {
+            v0 = _mm256_min_pd(x0, v0);
+            v1 = _mm256_min_pd(x1, v1);
+            v2 = _mm256_min_pd(x2, v2);
+            v3 = _mm256_min_pd(x3, v3);
+        }
+    }
+    if (_mm256_movemask_pd(nan)) return NAN;
+
+    double lanes[BREAD_REDUCE_LANES];
+    bread_store_lanes_pd(lanes, v0, v1, v2, v3);
+    double m = want_max ? bread_max_f64_scalar(lanes, BREAD_REDUCE_LANES) : bread_min_f64_scalar(lanes, BREAD_REDUCE_LANES);
+    if (i == n) return m;
+    double rest = want_max ? bread_max_f64_scalar(xs + i, n - i) : bread_min_f64_scalar(xs + i, n - i);
+    if (rest != rest) return NAN;
+    return want_max ? (rest > m ? rest : m) : (rest < m ? rest : m);
+}
+
+BREAD_AVX2 static double bread_min_f64_avx2(const double* xs, size_t n) {
+    return bread_minmax_f64_avx2(xs, n, 0);
+}
+
+BREAD_AVX2 static double bread_max_f64_avx2(const double* xs, size_t n) {
+    return bread_minmax_f64_avx2(xs, n, 1);
+}
+
+// Splits each element into its unsigned low and high 32 bits and counts
+// the negative ones; none of the three sums can overflow below 2^32
+// elements, and together they give the exact total.
+BREAD_AVX2 static double bread_mean_i64_avx2(const int64_t* xs, size_t n) {
+    const __m256i low_mask = _mm256_set1_epi64x(0xffffffff);
+    __m256i lo = _mm256_setzero_si256(), hi = lo, neg = lo;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(xs + i));
+        lo = _mm256_add_epi64(lo, _mm256_and_si256(x, low_mask));
+        hi = _mm256_add_epi64(hi, _mm256_srli_epi64(x, 32));
+        neg = _mm256_add_epi64(neg, _mm256_srli_epi64(x, 63));
+    }
+    uint64_t l[4], h[4], s[4];
+    _mm256_storeu_si256((__m256i*)l, lo);
+    _mm256_storeu_si256((__m256i*)h, hi);
+    _mm256_storeu_si256((__m256i*)s, neg);
+    __int128 total = 0;
+    for (int k = 0; k < 4; k++) {
+        total += ((__int128)h[k] << 32) + (__int128)l[k] - ((__int128)s[k] << 64);
+    }
+    for (; i < n; i++) total += xs[i];
+    return (double)total / (double)n;
+}
+
+BREAD_AVX2 static int64_t bread_dot_i64_avx2(const int64_t* a, const int64_t* b, size_t n) {
+    __m256i v0 = _mm256_setzero_si256(), v1 = v0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        v0 = _mm256_add_epi64(v0, bread_mullo_epi64(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                                     _mm256_loadu_si256((const __m256i*)(b + i))));
+        v1 = _mm256_add_epi64(v1, bread_mullo_epi64(_mm256_loadu_si256((const __m256i*)(a + i + 4)),
+                                                     _mm256_loadu_si256((const __m256i*)(b + i + 4))));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, _mm256_add_epi64(v0, v1));
+    uint64_t total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    return (int64_t)(total + (uint64_t)bread_dot_i64_scalar(a + i, b + i, n - i));
+}
+
+BREAD_AVX2 static double bread_dot_f64_avx2(const double* a, const double* b, size_t n) {
+    __m256d v0 = _mm256_setzero_pd(), v1 = v0, v2 = v0, v3 = v0;
+    size_t i = 0;
+    for (; i + BREAD_REDUCE_LANES <= n; i += BREAD_REDUCE_LANES) {
+        v0 = _mm256_add_pd(v0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        v1 = _mm256_add_pd(v1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+        v2 = _mm256_add_pd(v2, _mm256_mul_pd(_mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8)));
+        v3 = _mm256_add_pd(v3, _mm256_mul_pd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12)));
+    }
+    double acc[BREAD_REDUCE_LANES];
+    bread_store_lanes_pd(acc, v0, v1, v2, v3);
+    for (size_t l = 0; i + l < n; l++) acc[l] += a[i + l] * b[i + l];
+    return bread_fold_sum(acc);
+}
+
+static const BreadReduceKernels bread_reduce_avx2 = {
+    "avx2",
+    bread_sum_i64_avx2, bread_sum_f64_avx2,
+    bread_prod_i64_avx2, bread_prod_f64_avx2,
+    bread_min_i64_avx2, bread_min_f64_avx2,
+    bread_max_i64_avx2, bread_max_f64_avx2,
+    bread_mean_i64_avx2,
+    bread_dot_i64_avx2, bread_dot_f64_avx2,
+};
+#endif
+
+static const BreadReduceKernels* bread_reduce_impl = NULL;
+
+static const BreadReduceKernels* bread_reduce_kernels(void) {
+    if (bread_reduce_impl) return bread_reduce_impl;
+    bread_reduce_impl = &bread_reduce_scalar;
+#ifdef BREAD_REDUCE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) bread_reduce_impl = &bread_reduce_avx2;
+#endif
+    return bread_reduce_impl;
+}
+
+const char* bread_reduce_kernel(void) {
+    return bread_reduce_kernels()->name;
+}
+
+int bread_reduce_set_kernel(const char* name) {
+    if (!name) return 0;
+    if (strcmp(name, "scalar") == 0) {
+        bread_reduce_impl = &bread_reduce_scalar;
+        return 1;
+    }
+#ifdef BREAD_REDUCE_X86
+    __builtin_cpu_init();
+    if (strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2")) {
+        bread_reduce_impl = &bread_reduce_avx2;
+        return 1;
+    }
+#endif
+    return 0;
+}
+
+int64_t bread_reduce_sum_i64(const int64_t* xs, size_t n) {
+    return bread_reduce_kernels()->sum_i64(xs, n);
+}
+
+double bread_reduce_sum_f64(const double* xs, size_t n) {
+    return bread_reduce_kernels()->sum_f64(xs, n);
+}
+
+int64_t bread_reduce_prod_i64(const int64_t* xs, size_t n) {
+    return bread_reduce_kernels()->prod_i64(xs, n);
+}
+
+double bread_reduce_prod_f64(const double* xs, size_t n) {
+    return bread_reduce_kernels()->prod_f64(xs, n);
+}
+
+int64_t bread_reduce_min_i64(const int64_t* xs, size_t n) {
+    return bread_reduce_kernels()->min_i64(xs, n);
+}
+
+double bread_reduce_min_f64(const double* xs, size_t n) {
+    return bread_reduce_kernels()->min_f64(xs, n);
+}
+
+int64_t bread_reduce_max_i64(const int64_t* xs, size_t n) {
+    return bread_reduce_kernels()->max_i64(xs, n);
+}
+
+double bread_reduce_max_f64(const double* xs, size_t n) {
+    return bread_reduce_kernels()->max_f64(xs, n);
+}
+
+double bread_reduce_mean_i64(const int64_t* xs, size_t n) {
+    return bread_reduce_kernels()->mean_i64(xs, n);
+}
+
+double bread_reduce_mean_f64(const double* xs, size_t n) {
+    return bread_reduce_kernels()->sum_f64(xs, n) / (double)n;
+}
+
+int64_t bread_reduce_dot_i64(const int64_t* a, const int64_t* b, size_t n) {
+    return bread_reduce_kernels()->dot_i64(a, b, n);
+}
+
+double bread_reduce_dot_f64(const double* a, const double* b, size_t n) {
+    return bread_reduce_kernels()->dot_f64(a, b, n);
+}
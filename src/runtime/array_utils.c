@@ -5,35 +5,67 @@
 
 #include "runtime/runtime.h"
 #include "runtime/error.h"
+#include "runtime/number_parse.h"
 #include "core/value.h"
 
-// Built-in range function implementation
+// Built-in range function implementation; the array stays lazy until written to
 BreadArray* bread_range_create(int64_t start, int64_t end, int64_t step) {
-    if (step == 0) return NULL;
-    if (step > 0 && start >= end) return bread_array_new_typed(TYPE_INT);
-    if (step < 0 && start <= end) return bread_array_new_typed(TYPE_INT);
-    
-    BreadArray* arr = bread_array_new_typed(TYPE_INT);
-    if (!arr) return NULL;
-    
-    for (int i = start; (step > 0) ? (i < end) : (i > end); i += step) {
-        BreadValue val;
-        bread_value_set_int(&val, i);
-        if (!bread_array_append(arr, val)) {
-            bread_value_release(&val);
-            bread_array_release(arr);
+    return bread_array_new_range(start, end, step);
+}
+
+BreadArray* bread_range(int64_t n) {
+    return bread_range_create(0, n, 1);
+}
+
+// Shared by toInts()/toDoubles(): the result is sized once and filled in a
+// single pass. The first element that is not a number fails the whole call.
+static BreadArray* bread_array_parse_numbers(BreadArray* strings, VarType type) {
+    const char* method = type == TYPE_INT ? "toInts" : "toDoubles";
+    int count = strings ? strings->count : 0;
+    BreadArray* out = bread_array_new_with_capacity(count, type);
+    if (!out) return NULL;
+    int64_t* ints = bread_array_int_data(out);
+    double* doubles = bread_array_double_data(out);
+
+    for (int i = 0; i < count; i++) {
+        BreadValue item = bread_array_at(strings, i);
+        if (item.type != TYPE_STRING) {
+            char error_msg[128];
+            snprintf(error_msg, sizeof(error_msg), "%s() expects an array of String", method);
+            BREAD_ERROR_SET_TYPE_MISMATCH(error_msg);
+            bread_array_release(out);
             return NULL;
         }
-        bread_value_release(&val);
+
+        BreadString* text = item.value.string_val;
+        const char* data = bread_string_data(text);
+        size_t len = bread_string_len(text);
+        int ok;
+        if (type == TYPE_INT) {
+            ok = bread_parse_int(data, len, &ints[i]);
+        } else {
+            ok = bread_parse_double(data, len, &doubles[i]);
+        }
+        if (!ok) {
+            char error_msg[256];
+            snprintf(error_msg, sizeof(error_msg), "%s(): element %d ('%.64s') is not a number",
+                     method, i, bread_string_cstr(text));
+            BREAD_ERROR_SET_RUNTIME(error_msg);
+            bread_array_release(out);
+            return NULL;
+        }
+        out->count++;
     }
-    
-    return arr;
+    return out;
 }
 
-BreadArray* bread_range(int64_t n) {
-    return bread_range_create(0, n, 1);
+BreadArray* bread_array_parse_ints(BreadArray* strings) {
+    return bread_array_parse_numbers(strings, TYPE_INT);
 }
 
+BreadArray* bread_array_parse_doubles(BreadArray* strings) {
+    return bread_array_parse_numbers(strings, TYPE_DOUBLE);
+}
 
 int bread_array_get_value(BreadArray* a, int idx, BreadValue* out) {
     if (!out) return 0;
@@ -52,14 +84,21 @@ int bread_array_get_value(BreadArray* a, int idx, BreadValue* out) {
         return 0;
     }
     
-    *out = bread_value_clone(a->items[idx]);
+    *out = bread_value_clone(bread_array_at(a, idx));
     return 1;
 }
 
+// For-in loops also walk strings through these two, one character at a time
 int bread_value_array_get(BreadValue* array_val, int idx, BreadValue* out) {
     if (!array_val || !out) return 0;
     bread_value_set_nil(out);
     
+    if (array_val->type == TYPE_STRING) {
+        if (idx < 0 || (size_t)idx >= bread_string_len(array_val->value.string_val)) return 0;
+        out->type = TYPE_STRING;
+        out->value.string_val = bread_string_slice(array_val->value.string_val, (size_t)idx, (size_t)idx + 1);
+        return 1;
+    }
     if (array_val->type != TYPE_ARRAY) {
         BREAD_ERROR_SET_TYPE_MISMATCH("Expected array type for indexing operation");
         return 0;
@@ -69,6 +108,7 @@ int bread_value_array_get(BreadValue* array_val, int idx, BreadValue* out) {
 }
 
 int bread_value_array_length(BreadValue* array_val) {
+    if (array_val && array_val->type == TYPE_STRING) return (int)bread_string_len(array_val->value.string_val);
     if (!array_val || array_val->type != TYPE_ARRAY) return 0;
     return bread_array_length(array_val->value.array_val);
 }
@@ -5,6 +5,8 @@
 
 #include "runtime/runtime.h"
 #include "runtime/error.h"
+#include "runtime/number_parse.h"
+#include "runtime/array_reduce.h"
 #include "core/value.h"
 
 #define MAX_BUILTINS 64
@@ -213,6 +215,15 @@ BreadValue bread_builtin_type(BreadValue* args, int arg_count) {
     return result;
 }
 
+static void bread_str_result(BreadValue* result, BreadString* s) {
+    if (!s) {
+        BREAD_ERROR_SET_MEMORY_ALLOCATION("Out of memory creating string");
+        return;
+    }
+    result->type = TYPE_STRING;
+    result->value.string_val = s;
+}
+
 // str() function - converts any value to string representation
 BreadValue bread_builtin_str(BreadValue* args, int arg_count) {
     BreadValue result;
@@ -224,7 +235,6 @@ BreadValue bread_builtin_str(BreadValue* args, int arg_count) {
     }
     
     BreadValue* arg = &args[0];
-    char buffer[256];
     
     switch (arg->type) {
         case TYPE_NIL:
@@ -234,22 +244,19 @@ BreadValue bread_builtin_str(BreadValue* args, int arg_count) {
             bread_value_set_string(&result, arg->value.bool_val ? "true" : "false");
             break;
         case TYPE_INT:
-            snprintf(buffer, sizeof(buffer), "%lld", arg->value.int_val);
-            bread_value_set_string(&result, buffer);
+            bread_str_result(&result, bread_string_from_int(arg->value.int_val));
             break;
         case TYPE_FLOAT:
-            snprintf(buffer, sizeof(buffer), "%.6g", (double)arg->value.float_val);
-            bread_value_set_string(&result, buffer);
+            bread_str_result(&result, bread_string_from_double((double)arg->value.float_val, 6));
             break;
         case TYPE_DOUBLE: {
             double val = arg->value.double_val;
             if (val == (int)val && val >= -2147483648.0 && val <= 2147483647.0) {
                 // woahh... big nuuumberss
-                snprintf(buffer, sizeof(buffer), "%d", (int)val);
+                bread_str_result(&result, bread_string_from_int((int)val));
             } else {
-                snprintf(buffer, sizeof(buffer), "%.6g", val);
+                bread_str_result(&result, bread_string_from_double(val, 6));
             }
-            bread_value_set_string(&result, buffer);
             break;
         }
         case TYPE_STRING:
@@ -321,15 +328,16 @@ BreadValue bread_builtin_int(BreadValue* args, int arg_count) {
             bread_value_set_int(&result, arg->value.bool_val ? 1 : 0);
             break;
         case TYPE_STRING: {
-            const char* str = bread_string_cstr(arg->value.string_val);
-            char* endptr;
-            long val = strtol(str, &endptr, 10);
-            if (*endptr == '\0' && val >= INT_MIN && val <= INT_MAX) {
+            BreadString* str = arg->value.string_val;
+            int64_t val = 0;
+            // strtol used to accept "" as 0
+            if ((bread_string_len(str) == 0 || bread_parse_int(bread_string_data(str), bread_string_len(str), &val)) &&
+                val >= INT_MIN && val <= INT_MAX) {
                 bread_value_set_int(&result, (int)val);
             } else {
                 char error_msg[256];
                 snprintf(error_msg, sizeof(error_msg), 
-                        "Cannot convert string '%s' to int", str);
+                        "Cannot convert string '%s' to int", bread_string_cstr(str));
                 BREAD_ERROR_SET_RUNTIME(error_msg);
             }
             break;
@@ -398,15 +406,14 @@ BreadValue bread_builtin_float(BreadValue* args, int arg_count) {
             bread_value_set_float(&result, arg->value.bool_val ? 1.0f : 0.0f);
             break;
         case TYPE_STRING: {
-            const char* str = bread_string_cstr(arg->value.string_val);
-            char* endptr;
-            double val = strtod(str, &endptr);
-            if (*endptr == '\0') {
+            BreadString* str = arg->value.string_val;
+            double val = 0.0;
+            if (bread_string_len(str) == 0 || bread_parse_double(bread_string_data(str), bread_string_len(str), &val)) {
                 bread_value_set_float(&result, (float)val);
             } else {
                 char error_msg[256];
                 snprintf(error_msg, sizeof(error_msg),
-                        "Cannot convert string '%s' to float", str);
+                        "Cannot convert string '%s' to float", bread_string_cstr(str));
                 BREAD_ERROR_SET_RUNTIME(error_msg);
             }
             break;
@@ -443,15 +450,14 @@ BreadValue bread_builtin_double(BreadValue* args, int arg_count) {
             bread_value_set_double(&result, arg->value.bool_val ? 1.0 : 0.0);
             break;
         case TYPE_STRING: {
-            const char* str = bread_string_cstr(arg->value.string_val);
-            char* endptr;
-            double val = strtod(str, &endptr);
-            if (*endptr == '\0') {
+            BreadString* str = arg->value.string_val;
+            double val = 0.0;
+            if (bread_string_len(str) == 0 || bread_parse_double(bread_string_data(str), bread_string_len(str), &val)) {
                 bread_value_set_double(&result, val);
             } else {
                 char error_msg[256];
                 snprintf(error_msg, sizeof(error_msg), 
-                        "Cannot convert string '%s' to double", str);
+                        "Cannot convert string '%s' to double", bread_string_cstr(str));
                 BREAD_ERROR_SET_RUNTIME(error_msg);
             }
             break;
@@ -464,6 +470,140 @@ BreadValue bread_builtin_double(BreadValue* args, int arg_count) {
     return result;
 }
 
+// Elements of an [Int] or [Double] as one contiguous run for the
+// reduction kernels. Lazy ranges and arrays boxed by bread_array_get have
+// no such run, so theirs is copied into `scratch`.
+typedef struct {
+    VarType type;
+    size_t count;
+    const int64_t* ints;
+    const double* doubles;
+    void* scratch;
+} BreadNumbers;
+
+static int bread_numbers_from(const char* fn, const BreadValue* arg, BreadNumbers* out) {
+    memset(out, 0, sizeof(*out));
+    BreadArray* a = arg->type == TYPE_ARRAY ? arg->value.array_val : NULL;
+    VarType type = a ? a->element_type : TYPE_NIL;
+    if (a && type == TYPE_NIL && a->count == 0) type = TYPE_INT;
+    if (type != TYPE_INT && type != TYPE_DOUBLE) {
+        char error_msg[128];
+        snprintf(error_msg, sizeof(error_msg), "%s() expects an [Int] or [Double] array", fn);
+        BREAD_ERROR_SET_TYPE_MISMATCH(error_msg);
+        return 0;
+    }
+
+    out->type = type;
+    out->count = (size_t)a->count;
+    out->ints = bread_array_int_data(a);
+    out->doubles = bread_array_double_data(a);
+    if (out->count == 0 || out->ints || out->doubles) return 1;
+
+    out->scratch = malloc(out->count * sizeof(int64_t));
+    if (!out->scratch) {
+        BREAD_ERROR_SET_MEMORY_ALLOCATION("Failed to allocate memory for array elements");
+        return 0;
+    }
+    for (int i = 0; i < a->count; i++) {
+        BreadValue v = bread_array_at(a, i);
+        if (type == TYPE_INT) {
+            ((int64_t*)out->scratch)[i] = v.value.int_val;
+        } else {
+            ((double*)out->scratch)[i] = v.value.double_val;
+        }
+    }
+    out->ints = type == TYPE_INT ? out->scratch : NULL;
+    out->doubles = type == TYPE_DOUBLE ? out->scratch : NULL;
+    return 1;
+}
+
+// op is '+' for sum, '*' for prod, '<' for min, '>' for max and 'm' for mean
+static BreadValue bread_builtin_reduce(const char* fn, char op, BreadValue* args, int arg_count) {
+    BreadValue result;
+    bread_value_set_nil(&result);
+    if (arg_count != 1) {
+        char error_msg[64];
+        snprintf(error_msg, sizeof(error_msg), "%s() expects 1 argument", fn);
+        BREAD_ERROR_SET_RUNTIME(error_msg);
+        return result;
+    }
+
+    BreadNumbers xs;
+    if (!bread_numbers_from(fn, &args[0], &xs)) return result;
+    if (xs.count == 0 && (op == '<' || op == '>' || op == 'm')) {
+        char error_msg[64];
+        snprintf(error_msg, sizeof(error_msg), "%s() of an empty array", fn);
+        BREAD_ERROR_SET_RUNTIME(error_msg);
+        return result;
+    }
+
+    if (xs.type == TYPE_INT) {
+        switch (op) {
+            case '+': bread_value_set_int(&result, bread_reduce_sum_i64(xs.ints, xs.count)); break;
+            case '*': bread_value_set_int(&result, bread_reduce_prod_i64(xs.ints, xs.count)); break;
+            case '<': bread_value_set_int(&result, bread_reduce_min_i64(xs.ints, xs.count)); break;
+            case '>': bread_value_set_int(&result, bread_reduce_max_i64(xs.ints, xs.count)); break;
+            default: bread_value_set_double(&result, bread_reduce_mean_i64(xs.ints, xs.count)); break;
+        }
+    } else {
+        switch (op) {
+            case '+': bread_value_set_double(&result, bread_reduce_sum_f64(xs.doubles, xs.count)); break;
+            case '*': bread_value_set_double(&result, bread_reduce_prod_f64(xs.doubles, xs.count)); break;
+            case '<': bread_value_set_double(&result, bread_reduce_min_f64(xs.doubles, xs.count)); break;
+            case '>': bread_value_set_double(&result, bread_reduce_max_f64(xs.doubles, xs.count)); break;
+            default: bread_value_set_double(&result, bread_reduce_mean_f64(xs.doubles, xs.count)); break;
+        }
+    }
+    free(xs.scratch);
+    return result;
+}
+
+BreadValue bread_builtin_sum(BreadValue* args, int arg_count) {
+    return bread_builtin_reduce("sum", '+', args, arg_count);
+}
+
+BreadValue bread_builtin_prod(BreadValue* args, int arg_count) {
+    return bread_builtin_reduce("prod", '*', args, arg_count);
+}
+
+BreadValue bread_builtin_min(BreadValue* args, int arg_count) {
+    return bread_builtin_reduce("min", '<', args, arg_count);
+}
+
+BreadValue bread_builtin_max(BreadValue* args, int arg_count) {
+    return bread_builtin_reduce("max", '>', args, arg_count);
+}
+
+BreadValue bread_builtin_mean(BreadValue* args, int arg_count) {
+    return bread_builtin_reduce("mean", 'm', args, arg_count);
+}
+
+BreadValue bread_builtin_dot(BreadValue* args, int arg_count) {
+    BreadValue result;
+    bread_value_set_nil(&result);
+    if (arg_count != 2) {
+        BREAD_ERROR_SET_RUNTIME("dot() expects 2 arguments");
+        return result;
+    }
+
+    BreadNumbers a, b;
+    if (!bread_numbers_from("dot", &args[0], &a)) return result;
+    if (!bread_numbers_from("dot", &args[1], &b)) {
+        free(a.scratch);
+        return result;
+    }
+    if (a.type != b.type || a.count != b.count) {
+        BREAD_ERROR_SET_TYPE_MISMATCH("dot() expects two arrays of the same type and length");
+    } else if (a.type == TYPE_INT) {
+        bread_value_set_int(&result, bread_reduce_dot_i64(a.ints, b.ints, a.count));
+    } else {
+        bread_value_set_double(&result, bread_reduce_dot_f64(a.doubles, b.doubles, a.count));
+    }
+    free(a.scratch);
+    free(b.scratch);
+    return result;
+}
+
 // Register
 static void register_builtin_functions(void) {
     // len() function
@@ -554,4 +694,33 @@ static void register_builtin_functions(void) {
         };
         bread_builtin_register(&input_fn);
     }
+
+    // sum(), prod(), min(), max(), mean() and dot() over [Int] and [Double];
+    // all but mean give back the element type, see cg_builtin_return_type
+    {
+        VarType array_params[] = {TYPE_ARRAY, TYPE_ARRAY};
+        const struct {
+            const char* name;
+            int param_count;
+            VarType return_type;
+            BreadValue (*implementation)(BreadValue* args, int arg_count);
+        } reductions[] = {
+            {"sum", 1, TYPE_NIL, bread_builtin_sum},
+            {"prod", 1, TYPE_NIL, bread_builtin_prod},
+            {"min", 1, TYPE_NIL, bread_builtin_min},
+            {"max", 1, TYPE_NIL, bread_builtin_max},
+            {"mean", 1, TYPE_DOUBLE, bread_builtin_mean},
+            {"dot", 2, TYPE_NIL, bread_builtin_dot},
+        };
+        for (size_t i = 0; i < sizeof(reductions) / sizeof(reductions[0]); i++) {
+            BuiltinFunction reduce_fn = {
+                .name = (char*)reductions[i].name,
+                .param_count = reductions[i].param_count,
+                .param_types = array_params,
+                .return_type = reductions[i].return_type,
+                .implementation = reductions[i].implementation
+            };
+            bread_builtin_register(&reduce_fn);
+        }
+    }
 }
@@ -1,51 +1,143 @@
+#define _DEFAULT_SOURCE // MAP_ANONYMOUS under -std=c11
+
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <assert.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
 
 #include "runtime/memory.h"
+#include "runtime/alloc_profile.h"
 #include "runtime/error.h"
 #include "core/value.h"
 
 #define BREAD_DEFAULT_GC_THRESHOLD 1000
 #define BREAD_GC_GROWTH_FACTOR 2
-#define BREAD_MAX_STACK_DEPTH 8192
 #define BREAD_LEAK_REPORT_LIMIT 100
-#define BREAD_POOL_BLOCK_SIZE 64
-#define BREAD_POOL_BLOCKS_PER_CHUNK 256
-
-typedef struct BreadMemoryChunk {
-    uint8_t blocks[BREAD_POOL_BLOCKS_PER_CHUNK][BREAD_POOL_BLOCK_SIZE];
-    uint64_t free_bitmap[BREAD_POOL_BLOCKS_PER_CHUNK / 64];
+#define BREAD_POOL_CHUNK_SIZE (64 * 1024)
+#define BREAD_POOL_CHUNK_HEADER_SIZE 64
+#define BREAD_DEFAULT_POOL_RETAIN (1024 * 1024)
+#define BREAD_GC_SLICE_INTERVAL 64 // allocations between slices while work is pending
+#define BREAD_GC_PARALLEL_MIN_OBJECTS 65536 // live objects before marking goes parallel
+#define BREAD_NURSERY_RESERVE ((size_t)256 * 1024 * 1024) // address space; pages are touched on demand
+#define BREAD_NURSERY_MAX_OBJECT 1024
+#define BREAD_NURSERY_RETAIN (1024 * 1024) // touched bytes kept across resets
+#define BREAD_NURSERY_DEPTH_SHIFT 40 // marks carry the depth above the offset
+#define BREAD_ARENA_RESERVE ((size_t)256 * 1024 * 1024)
+
+static const uint32_t bread_pool_class_sizes[BREAD_POOL_CLASS_COUNT] = {
+    32, 48, 64, 96, 128, 192, 256, 384, 512
+};
+
+// Chunks are BREAD_POOL_CHUNK_SIZE aligned, so a block's owner is found by
+// masking its address. Blocks are handed out from the bump index first and
+// from the intrusive free list once they have been recycled.
+struct BreadMemoryChunk {
+    struct BreadMemoryChunk* prev;
     struct BreadMemoryChunk* next;
-    size_t free_count;
-} BreadMemoryChunk;
-
+    void* free_list;
+    BreadMemoryPool* pool;
+    uint32_t capacity;
+    uint32_t used;
+    uint32_t bump;
+};
+
+_Static_assert(sizeof(struct BreadMemoryChunk) <= BREAD_POOL_CHUNK_HEADER_SIZE,
+               "chunk header does not fit its reserved space");
+_Static_assert(BREAD_NURSERY_RESERVE <= ((size_t)1 << BREAD_NURSERY_DEPTH_SHIFT),
+               "nursery offsets overlap the depth bits of a mark");
 
 static BreadMemoryManager g_mem = {0};
 static int g_mem_initialized = 0;
 
+static int bread_memory_clamp_gc_threads(long threads) {
+    if (threads < 1) return 1;
+    return threads > BREAD_GC_MAX_THREADS ? BREAD_GC_MAX_THREADS : (int)threads;
+}
+
 static inline void bread_memory_ensure_init(void) {
     if (g_mem_initialized) return;
 
     memset(&g_mem, 0, sizeof(g_mem));
-    g_mem.cycle_collection_enabled = 0;
+    g_mem.cycle_collection_enabled = 1;
     g_mem.gc_threshold = BREAD_DEFAULT_GC_THRESHOLD;
     g_mem.bytes_threshold = 1024 * 1024; /* 1MB default */
     g_mem.auto_gc_enabled = 1;
     g_mem.debug_mode = 0;
+    g_mem.pool_retain_bytes = BREAD_DEFAULT_POOL_RETAIN;
+    g_mem.all_objects.prev = &g_mem.all_objects;
+    g_mem.all_objects.next = &g_mem.all_objects;
+    for (int i = 0; i < BREAD_POOL_CLASS_COUNT; i++) {
+        g_mem.pools[i].block_size = bread_pool_class_sizes[i];
+    }
+
+    // AOT binaries take their limits from the environment
+    size_t bytes = 0;
+    const char* env = getenv("BREAD_HEAP_LIMIT");
+    if (env && bread_memory_parse_size(env, &bytes)) {
+        g_mem.heap_limit = bytes;
+    }
+    env = getenv("BREAD_POOL_RETAIN");
+    if (env && bread_memory_parse_size(env, &bytes)) {
+        g_mem.pool_retain_bytes = bytes;
+    }
+    env = getenv("BREAD_GC_SLICE_US");
+    if (env) {
+        g_mem.gc_slice_budget_us = strtoull(env, NULL, 10);
+    }
+    env = getenv("BREAD_GC_SLICE_OBJECTS");
+    if (env) {
+        g_mem.gc_slice_budget_objects = strtoull(env, NULL, 10);
+    }
+    env = getenv("BREAD_GC_THREADS");
+    g_mem.gc_threads = bread_memory_clamp_gc_threads(env ? strtol(env, NULL, 10)
+                                                         : sysconf(_SC_NPROCESSORS_ONLN));
 
     g_mem_initialized = 1;
 }
 
-static BreadObjectNode* bread_memory_find_node(const void* object) {
+static inline BreadObjectNode* bread_memory_find_node(const void* object) {
     if (!object) return NULL;
-    
-    for (BreadObjectNode* n = g_mem.all_objects; n; n = n->next) {
-        if (n->object == object) return n;
-    }
-    return NULL;
+    return (BreadObjectNode*)object - 1;
+}
+
+static inline void* bread_memory_node_object(BreadObjectNode* node) {
+    return (void*)(node + 1);
+}
+
+static inline int bread_memory_node_is_tracked(const BreadObjectNode* node) {
+    return node->next != node;
+}
+
+static inline int bread_memory_is_immortal(const void* object) {
+    return ((const BreadObjHeader*)object)->refcount == BREAD_REFCOUNT_IMMORTAL;
+}
+
+// Nursery, arena and immortal objects have no tracking node in front of them
+static inline int bread_memory_is_untracked(const void* object) {
+    return bread_memory_is_young(object) || bread_memory_is_arena(object) ||
+           bread_memory_is_immortal(object);
+}
+
+static inline void bread_memory_node_link(BreadObjectNode* node) {
+    BreadObjectNode* head = &g_mem.all_objects;
+    node->prev = head;
+    node->next = head->next;
+    head->next->prev = node;
+    head->next = node;
+}
+
+static inline void bread_memory_node_unlink(BreadObjectNode* node) {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->prev = node;
+    node->next = node;
 }
 
 static inline int bread_memory_should_trigger_gc(void) {
@@ -53,104 +145,237 @@ static inline int bread_memory_should_trigger_gc(void) {
         return 0;
     }
     
+    if (g_mem.gc_slice_pending && g_mem.allocations_since_gc >= BREAD_GC_SLICE_INTERVAL) {
+        return 1;
+    }
+    
     return (g_mem.allocations_since_gc >= g_mem.gc_threshold) ||
-           (g_mem.bytes_since_gc >= g_mem.bytes_threshold);
+           (g_mem.bytes_since_gc >= g_mem.bytes_threshold) ||
+           (g_mem.cycle_root_count >= g_mem.gc_threshold);
 }
 
-static BreadMemoryChunk* bread_pool_alloc_chunk(void) {
-    BreadMemoryChunk* chunk = calloc(1, sizeof(BreadMemoryChunk));
-    if (!chunk) return NULL;
+static inline int bread_memory_gc_is_incremental(void) {
+    return g_mem.gc_slice_budget_us || g_mem.gc_slice_budget_objects;
+}
+
+static BreadMemoryPool* bread_pool_for_size(size_t size) {
+    if (size > BREAD_POOL_MAX_BLOCK_SIZE) return NULL;
     
-    // mark all blocks as free
-    memset(chunk->free_bitmap, 0xFF, sizeof(chunk->free_bitmap));
-    chunk->free_count = BREAD_POOL_BLOCKS_PER_CHUNK;
+    // classes are 16-byte multiples, indexed by size in 16-byte steps
+    static const uint8_t class_by_step[BREAD_POOL_MAX_BLOCK_SIZE / 16 + 1] = {
+        0, 0, 0, 1, 2, 3, 3, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6,
+        7, 7, 7, 7, 7, 7, 7, 7, 8, 8, 8, 8, 8, 8, 8, 8
+    };
+    return &g_mem.pools[class_by_step[(size + 15) / 16]];
+}
+
+static inline BreadMemoryChunk* bread_pool_chunk_of(const void* ptr) {
+    return (BreadMemoryChunk*)((uintptr_t)ptr & ~(uintptr_t)(BREAD_POOL_CHUNK_SIZE - 1));
+}
+
+static void bread_pool_list_remove(BreadMemoryChunk** list, BreadMemoryChunk* chunk) {
+    if (chunk->prev) chunk->prev->next = chunk->next;
+    else *list = chunk->next;
+    if (chunk->next) chunk->next->prev = chunk->prev;
+    chunk->prev = NULL;
     chunk->next = NULL;
+}
+
+static void bread_pool_list_push(BreadMemoryChunk** list, BreadMemoryChunk* chunk) {
+    chunk->prev = NULL;
+    chunk->next = *list;
+    if (*list) (*list)->prev = chunk;
+    *list = chunk;
+}
+
+// Maps twice the chunk size and trims both ends to get an aligned chunk.
+static BreadMemoryChunk* bread_pool_map_chunk(void) {
+    size_t span = 2 * BREAD_POOL_CHUNK_SIZE;
+    uint8_t* raw = mmap(NULL, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return NULL;
+    
+    uintptr_t aligned = ((uintptr_t)raw + BREAD_POOL_CHUNK_SIZE - 1) & ~(uintptr_t)(BREAD_POOL_CHUNK_SIZE - 1);
+    size_t head = aligned - (uintptr_t)raw;
+    size_t tail = span - head - BREAD_POOL_CHUNK_SIZE;
+    if (head) munmap(raw, head);
+    if (tail) munmap((uint8_t*)aligned + BREAD_POOL_CHUNK_SIZE, tail);
+    
+    return (BreadMemoryChunk*)aligned;
+}
+
+static void bread_pool_unmap_chunk(BreadMemoryChunk* chunk) {
+    munmap(chunk, BREAD_POOL_CHUNK_SIZE);
+}
+
+static BreadMemoryChunk* bread_pool_alloc_chunk(BreadMemoryPool* pool) {
+    BreadMemoryChunk* chunk = bread_pool_map_chunk();
+    if (!chunk) return NULL;
+    
+    memset(chunk, 0, sizeof(BreadMemoryChunk));
+    chunk->pool = pool;
+    chunk->capacity = (uint32_t)((BREAD_POOL_CHUNK_SIZE - BREAD_POOL_CHUNK_HEADER_SIZE) / pool->block_size);
     
     return chunk;
 }
 
 static void* bread_pool_alloc(BreadMemoryPool* pool) {
-    if (!pool->chunks || pool->chunks->free_count == 0) {
-        BreadMemoryChunk* new_chunk = bread_pool_alloc_chunk();
-        if (!new_chunk) return NULL;
+    BreadMemoryChunk* chunk = pool->available;
+    if (!chunk) {
+        chunk = bread_pool_alloc_chunk(pool);
+        if (!chunk) return NULL;
         
-        new_chunk->next = pool->chunks;
-        pool->chunks = new_chunk;
+        bread_pool_list_push(&pool->available, chunk);
         pool->total_chunks++;
     }
     
-    BreadMemoryChunk* chunk = pool->chunks;
+    if (chunk->used == 0 && chunk->bump > 0) {
+        g_mem.empty_chunks--;
+    }
     
-    // find the first tree block
-    for (size_t i = 0; i < BREAD_POOL_BLOCKS_PER_CHUNK / 64; i++) {
-        if (chunk->free_bitmap[i] == 0) continue;
-        uint64_t bitmap = chunk->free_bitmap[i];
-        int bit = __builtin_ctzll(bitmap);
-        
-        chunk->free_bitmap[i] &= ~(1ULL << bit);
-        chunk->free_count--;
-        
-        size_t block_idx = i * 64 + bit;
-        return &chunk->blocks[block_idx][0];
+    void* block;
+    if (chunk->free_list) {
+        block = chunk->free_list;
+        chunk->free_list = *(void**)block;
+    } else {
+        block = (uint8_t*)chunk + BREAD_POOL_CHUNK_HEADER_SIZE + (size_t)chunk->bump * pool->block_size;
+        chunk->bump++;
+    }
+    
+    if (++chunk->used == chunk->capacity) {
+        bread_pool_list_remove(&pool->available, chunk);
+        bread_pool_list_push(&pool->full, chunk);
     }
     
-    return NULL; // SHOULD NEVER HAPPEN
+    return block;
 }
 
-static int bread_pool_free(BreadMemoryPool* pool, void* ptr) {
-    if (!ptr || !pool->chunks) return 0;
+static void bread_pool_free(void* ptr) {
+    BreadMemoryChunk* chunk = bread_pool_chunk_of(ptr);
+    BreadMemoryPool* pool = chunk->pool;
     
-    for (BreadMemoryChunk* chunk = pool->chunks; chunk; chunk = chunk->next) {
-        uintptr_t chunk_start = (uintptr_t)&chunk->blocks[0][0];
-        uintptr_t chunk_end = chunk_start + sizeof(chunk->blocks);
-        uintptr_t ptr_addr = (uintptr_t)ptr;
-        
-        if (ptr_addr >= chunk_start && ptr_addr < chunk_end) {
-            size_t offset = ptr_addr - chunk_start;
-            size_t block_idx = offset / BREAD_POOL_BLOCK_SIZE;
-            
-            if (block_idx >= BREAD_POOL_BLOCKS_PER_CHUNK) return 0;
-            
-            size_t bitmap_idx = block_idx / 64;
-            size_t bit_idx = block_idx % 64;
-            
-            chunk->free_bitmap[bitmap_idx] |= (1ULL << bit_idx);
-            chunk->free_count++;
-            
-            return 1;
-        }
+    if (chunk->used == chunk->capacity) {
+        bread_pool_list_remove(&pool->full, chunk);
+        bread_pool_list_push(&pool->available, chunk);
     }
     
-    return 0;
+    *(void**)ptr = chunk->free_list;
+    chunk->free_list = ptr;
+    chunk->used--;
+    
+    if (chunk->used > 0) return;
+    
+    // keep a few empty chunks for the next spike, hand the rest back
+    if ((g_mem.empty_chunks + 1) * BREAD_POOL_CHUNK_SIZE > g_mem.pool_retain_bytes) {
+        bread_pool_list_remove(&pool->available, chunk);
+        bread_pool_unmap_chunk(chunk);
+        pool->total_chunks--;
+        g_mem.stats.chunks_released++;
+    } else {
+        g_mem.empty_chunks++;
+    }
+}
+
+static void bread_pool_trim(void) {
+    for (int i = 0; i < BREAD_POOL_CLASS_COUNT; i++) {
+        BreadMemoryPool* pool = &g_mem.pools[i];
+        BreadMemoryChunk* chunk = pool->available;
+        while (chunk && g_mem.empty_chunks * BREAD_POOL_CHUNK_SIZE > g_mem.pool_retain_bytes) {
+            BreadMemoryChunk* next = chunk->next;
+            if (chunk->used == 0 && chunk->bump > 0) {
+                bread_pool_list_remove(&pool->available, chunk);
+                bread_pool_unmap_chunk(chunk);
+                pool->total_chunks--;
+                g_mem.empty_chunks--;
+                g_mem.stats.chunks_released++;
+            }
+            chunk = next;
+        }
+    }
 }
 
 static void bread_pool_cleanup(BreadMemoryPool* pool) {
-    BreadMemoryChunk* chunk = pool->chunks;
-    while (chunk) {
-        BreadMemoryChunk* next = chunk->next;
-        free(chunk);
-        chunk = next;
+    BreadMemoryChunk* lists[] = {pool->available, pool->full};
+    for (size_t i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+        BreadMemoryChunk* chunk = lists[i];
+        while (chunk) {
+            BreadMemoryChunk* next = chunk->next;
+            bread_pool_unmap_chunk(chunk);
+            chunk = next;
+        }
     }
-    pool->chunks = NULL;
+    pool->available = NULL;
+    pool->full = NULL;
     pool->total_chunks = 0;
 }
 
+static size_t bread_pool_total_chunks(void) {
+    size_t total = 0;
+    for (int i = 0; i < BREAD_POOL_CLASS_COUNT; i++) {
+        total += g_mem.pools[i].total_chunks;
+    }
+    return total;
+}
+
+static void bread_memory_run_collection(void);
+static void bread_memory_collect_slice(uint64_t budget_ns, size_t budget_objects);
+
+// Object bytes plus collection backing stores
+static inline size_t bread_memory_live_bytes(void) {
+    return g_mem.stats.bytes_allocated - g_mem.stats.bytes_freed + g_mem.stats.backing_bytes;
+}
+
+static void bread_memory_maybe_collect(void) {
+    if (!bread_memory_should_trigger_gc()) return;
+    if (bread_memory_gc_is_incremental()) {
+        bread_memory_gc_safepoint();
+    } else {
+        bread_memory_collect_cycles();
+    }
+}
+
+// Enforces the soft heap limit: collects once when `bytes` more would cross
+// it, then fails if they still do not fit.
+static int bread_memory_reserve(size_t bytes) {
+    if (!g_mem.heap_limit) return 1;
+    
+    size_t live = bread_memory_live_bytes();
+    if (live + bytes <= g_mem.heap_limit) return 1;
+    
+    bread_memory_run_collection();
+    live = bread_memory_live_bytes();
+    if (live + bytes <= g_mem.heap_limit) return 1;
+    
+    char msg[128];
+    snprintf(msg, sizeof(msg), "Heap limit of %zu bytes exceeded", g_mem.heap_limit);
+    BREAD_ERROR_SET_MEMORY_ALLOCATION(msg);
+    return 0;
+}
+
+// Returns a block of at least `size` bytes from the matching slab class,
+// falling back to malloc for large blocks.
+static BreadObjectNode* bread_memory_block_alloc(size_t size, int* pooled) {
+    BreadMemoryPool* pool = bread_pool_for_size(size);
+    if (pool) {
+        void* block = bread_pool_alloc(pool);
+        if (block) {
+            *pooled = 1;
+            return block;
+        }
+    }
+    *pooled = 0;
+    return malloc(size);
+}
+
 static void bread_memory_track_object_internal(void* object, size_t size, BreadObjKind kind) {
     if (!object) return;
     
-    BreadObjectNode* node = malloc(sizeof(BreadObjectNode));
-    if (!node) {
-        // tracking failed but obj allocated. no good. 
-        fprintf(stderr, "CRITICAL: Failed to track object %p\n", object);
-        return;
-    }
+    BreadObjectNode* node = bread_memory_find_node(object);
+    if (bread_memory_node_is_tracked(node)) return;
 
-    node->object = object;
     node->size = size;
     node->kind = kind;
     node->marked = 0;
-    node->next = g_mem.all_objects;
-    g_mem.all_objects = node;
+    bread_memory_node_link(node);
 
     g_mem.stats.total_allocations++;
     g_mem.stats.current_objects++;
@@ -163,27 +388,29 @@ static void bread_memory_track_object_internal(void* object, size_t size, BreadO
 static void bread_memory_untrack_object_internal(void* object) {
     if (!object) return;
 
-    BreadObjectNode** cur = &g_mem.all_objects;
-    while (*cur) {
-        if ((*cur)->object == object) {
-            BreadObjectNode* dead = *cur;
-            *cur = dead->next;
-
-            g_mem.stats.bytes_freed += dead->size;
-            g_mem.stats.total_deallocations++;
-            
-            if (g_mem.stats.current_objects > 0) {
-                g_mem.stats.current_objects--;
-            }
-
-            free(dead);
-            return;
+    BreadObjectNode* node = bread_memory_find_node(object);
+    if (!bread_memory_node_is_tracked(node)) {
+        if (g_mem.debug_mode) {
+            fprintf(stderr, "Warning: Untracking unknown object %p\n", object);
         }
-        cur = &(*cur)->next;
+        return;
     }
+
+    bread_memory_node_unlink(node);
+
+    g_mem.stats.bytes_freed += node->size;
+    g_mem.stats.total_deallocations++;
     
-    if (g_mem.debug_mode) {
-        fprintf(stderr, "Warning: Untracking unknown object %p\n", object);
+    if (g_mem.stats.current_objects > 0) {
+        g_mem.stats.current_objects--;
+    }
+}
+
+static void bread_memory_release_block(BreadObjectNode* node) {
+    if (node->pooled) {
+        bread_pool_free(node);
+    } else {
+        free(node);
     }
 }
 
@@ -194,36 +421,58 @@ void bread_memory_init(void) {
 void bread_memory_cleanup(void) {
     if (!g_mem_initialized) return;
 
+    // before teardown, so leaked objects still show as live
+    bread_alloc_profile_stop();
+
     if (g_mem.debug_mode) {
         bread_memory_print_stats();
         bread_memory_print_leak_report();
     }
 
-    // free all
-    BreadObjectNode* n = g_mem.all_objects;
-    while (n) {
-        BreadObjectNode* next = n->next;
-        
-        if (g_mem.debug_mode && n->object) {
-            BreadObjHeader* hdr = (BreadObjHeader*)n->object;
+    // forget all; objects released after shutdown are left to the OS
+    BreadObjectNode* head = &g_mem.all_objects;
+    if (g_mem.debug_mode) {
+        for (BreadObjectNode* n = head->next; n != head; n = n->next) {
+            BreadObjHeader* hdr = (BreadObjHeader*)bread_memory_node_object(n);
             if (hdr->refcount > 0) {
                 fprintf(stderr, "Cleanup: freeing object %p with refcount %u\n", 
-                        n->object, hdr->refcount);
+                        (void*)hdr, hdr->refcount);
             }
         }
-        
-        free(n);
-        n = next;
     }
 
-    g_mem.all_objects = NULL;
+    head->prev = head;
+    head->next = head;
     
-    // cleanup pool
-    bread_pool_cleanup(&g_mem.small_pool);
+    // cleanup pools
+    for (int i = 0; i < BREAD_POOL_CLASS_COUNT; i++) {
+        bread_pool_cleanup(&g_mem.pools[i]);
+    }
+    g_mem.empty_chunks = 0;
+    free(g_mem.cycle_roots);
+    g_mem.cycle_roots = NULL;
+    g_mem.cycle_root_count = 0;
+    g_mem.cycle_root_capacity = 0;
     free(g_mem.gc_roots);
     g_mem.gc_roots = NULL;
     g_mem.gc_root_count = 0;
     g_mem.gc_root_capacity = 0;
+    if (g_mem.nursery_base) {
+        munmap(g_mem.nursery_base, BREAD_NURSERY_RESERVE);
+        g_mem.nursery_base = NULL;
+    }
+    g_mem.nursery_depth = 0;
+    free(g_mem.nursery_finalizers);
+    g_mem.nursery_finalizers = NULL;
+    g_mem.nursery_finalizer_count = 0;
+    g_mem.nursery_finalizer_capacity = 0;
+    if (g_mem.arena_base) {
+        munmap(g_mem.arena_base, BREAD_ARENA_RESERVE);
+        g_mem.arena_base = NULL;
+    }
+    g_mem.arena_top = 0;
+    g_mem.arena_high_water = 0;
+    g_mem.arena_depth = 0;
     
     g_mem_initialized = 0;
 }
@@ -241,23 +490,21 @@ void bread_memory_untrack_object(void* object) {
 void* bread_memory_alloc(size_t size, BreadObjKind kind) {
     bread_memory_ensure_init();
     
-    void* ptr = NULL;
-    if (size <= BREAD_POOL_BLOCK_SIZE) {
-        ptr = bread_pool_alloc(&g_mem.small_pool);
-        if (ptr) {
-            memset(ptr, 0, size);
-        }
-    }
+    if (!bread_memory_reserve(size)) return NULL;
     
-    if (!ptr) {
-        ptr = malloc(size);
-        if (!ptr) {
-            BREAD_ERROR_SET_MEMORY_ALLOCATION("Out of memory");
-            return NULL;
-        }
-        memset(ptr, 0, size);
+    size_t total = sizeof(BreadObjectNode) + size;
+    int pooled = 0;
+    BreadObjectNode* node = bread_memory_block_alloc(total, &pooled);
+    if (!node) {
+        BREAD_ERROR_SET_MEMORY_ALLOCATION("Out of memory");
+        return NULL;
     }
+    memset(node, 0, total);
+    node->prev = node;
+    node->next = node;
+    node->pooled = (uint16_t)pooled;
 
+    void* ptr = bread_memory_node_object(node);
     BreadObjHeader* hdr = (BreadObjHeader*)ptr;
     hdr->kind = (uint32_t)kind;
     hdr->refcount = 1;
@@ -265,14 +512,73 @@ void* bread_memory_alloc(size_t size, BreadObjKind kind) {
     g_mem.allocations_since_gc++;
     g_mem.bytes_since_gc += size;
     bread_memory_track_object_internal(ptr, size, kind);
+    if (bread_alloc_profile_active) {
+        bread_alloc_profile_record(ptr, size, 1);
+    }
 
-    if (bread_memory_should_trigger_gc()) {
-        bread_memory_collect_cycles();
+    bread_memory_maybe_collect();
+    return ptr;
+}
+
+// Charges `bytes` of backing store growth. Any collection runs before the
+// caller touches its buffer, while the owning object is still consistent.
+static int bread_memory_backing_grow(size_t bytes) {
+    if (!bread_memory_reserve(bytes)) return 0;
+    g_mem.bytes_since_gc += bytes;
+    bread_memory_maybe_collect();
+    return 1;
+}
+
+static void bread_memory_backing_account(size_t old_size, size_t new_size) {
+    g_mem.stats.backing_bytes += new_size;
+    g_mem.stats.backing_bytes -= old_size;
+    if (g_mem.stats.backing_bytes > g_mem.stats.peak_backing_bytes) {
+        g_mem.stats.peak_backing_bytes = g_mem.stats.backing_bytes;
+    }
+}
+
+void* bread_memory_alloc_backing(size_t size, int zeroed) {
+    bread_memory_ensure_init();
+    if (!bread_memory_backing_grow(size)) return NULL;
+
+    void* ptr = zeroed ? calloc(1, size) : malloc(size);
+    if (!ptr) {
+        BREAD_ERROR_SET_MEMORY_ALLOCATION("Out of memory");
+        return NULL;
+    }
+    bread_memory_backing_account(0, size);
+    if (bread_alloc_profile_active) {
+        bread_alloc_profile_record(ptr, size, 1);
     }
-    
     return ptr;
 }
 
+void* bread_memory_realloc_backing(void* ptr, size_t old_size, size_t new_size) {
+    bread_memory_ensure_init();
+    if (new_size > old_size && !bread_memory_backing_grow(new_size - old_size)) return NULL;
+
+    void* new_ptr = realloc(ptr, new_size);
+    if (!new_ptr) {
+        BREAD_ERROR_SET_MEMORY_ALLOCATION("Out of memory");
+        return NULL;
+    }
+    bread_memory_backing_account(ptr ? old_size : 0, new_size);
+    if (bread_alloc_profile_active) {
+        if (ptr) bread_alloc_profile_forget(ptr);
+        bread_alloc_profile_record(new_ptr, new_size, 1);
+    }
+    return new_ptr;
+}
+
+void bread_memory_free_backing(void* ptr, size_t size) {
+    if (!ptr) return;
+    if (bread_alloc_profile_active) {
+        bread_alloc_profile_forget(ptr);
+    }
+    free(ptr);
+    if (g_mem_initialized) bread_memory_backing_account(size, 0);
+}
+
 void* bread_memory_realloc(void* ptr, size_t new_size) {
     bread_memory_ensure_init();
 
@@ -281,37 +587,45 @@ void* bread_memory_realloc(void* ptr, size_t new_size) {
     }
 
     BreadObjectNode* node = bread_memory_find_node(ptr);
-    size_t old_size = node ? node->size : 0;
-    int was_pooled = bread_pool_free(&g_mem.small_pool, ptr);
-    void* new_ptr = NULL;
-    
-    if (new_size <= BREAD_POOL_BLOCK_SIZE) {
-        new_ptr = bread_pool_alloc(&g_mem.small_pool);
-        if (new_ptr && ptr) {
-            memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
-            if (!was_pooled) {
-                free(ptr);
-            }
-        }
+    size_t old_size = node->size;
+    if (new_size > old_size && !bread_memory_reserve(new_size - old_size)) {
+        return NULL;
     }
-    
-    if (!new_ptr) {
-        if (was_pooled) {
-            // pool to heap
-            new_ptr = malloc(new_size);
-            if (new_ptr && ptr) {
-                memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
-            }
-        } else {
-            new_ptr = realloc(ptr, new_size);
+    size_t total = sizeof(BreadObjectNode) + new_size;
+    int tracked = bread_memory_node_is_tracked(node);
+    BreadObjectNode* new_node = NULL;
+
+    if (node->pooled && total <= bread_pool_chunk_of(node)->pool->block_size) {
+        // still fits in its block
+        new_node = node;
+    } else if (node->pooled || bread_pool_for_size(total)) {
+        int pooled = 0;
+        new_node = bread_memory_block_alloc(total, &pooled);
+        if (new_node) {
+            memcpy(new_node, node, sizeof(BreadObjectNode) + (old_size < new_size ? old_size : new_size));
+            bread_memory_release_block(node);
+            new_node->pooled = (uint16_t)pooled;
         }
+    } else {
+        new_node = realloc(node, total);
     }
-    
-    if (!new_ptr) {
+
+    if (!new_node) {
         BREAD_ERROR_SET_MEMORY_ALLOCATION("Out of memory");
         return NULL;
     }
 
+    // the block may have moved, so repoint the neighbours
+    if (tracked) {
+        new_node->prev->next = new_node;
+        new_node->next->prev = new_node;
+    } else {
+        new_node->prev = new_node;
+        new_node->next = new_node;
+    }
+
+    void* new_ptr = bread_memory_node_object(new_node);
+
     // zero new memory
     if (new_size > old_size) {
         memset((char*)new_ptr + old_size, 0, new_size - old_size);
@@ -321,22 +635,32 @@ void* bread_memory_realloc(void* ptr, size_t new_size) {
         g_mem.stats.bytes_freed += (old_size - new_size);
     }
 
-    if (node) {
-        node->object = new_ptr;
-        node->size = new_size;
+    new_node->size = new_size;
+    if (bread_alloc_profile_active) {
+        bread_alloc_profile_forget(ptr);
+        bread_alloc_profile_record(new_ptr, new_size, 1);
     }
-
     return new_ptr;
 }
 
+size_t bread_memory_object_size(const void* object) {
+    if (!object || !g_mem_initialized || bread_memory_is_untracked(object)) return 0;
+    return bread_memory_find_node(object)->size;
+}
+
 void bread_memory_free(void* ptr) {
-    if (!ptr) return;
+    if (!ptr || !g_mem_initialized || bread_memory_is_untracked(ptr)) return;
     
     bread_memory_untrack_object_internal(ptr);
+    if (bread_alloc_profile_active) {
+        bread_alloc_profile_forget(ptr);
+    }
     
-    // try pool first
-    if (!bread_pool_free(&g_mem.small_pool, ptr)) {
-        free(ptr);
+    // a buffered root keeps its block until the collector drops it
+    BreadObjectNode* node = bread_memory_find_node(ptr);
+    node->color = BREAD_GC_BLACK;
+    if (!node->buffered) {
+        bread_memory_release_block(node);
     }
 }
 
@@ -345,12 +669,16 @@ void bread_object_retain(void* object) {
 
     BreadObjHeader* hdr = (BreadObjHeader*)object;
     
-    if (hdr->refcount == UINT32_MAX) {
+    if (hdr->refcount == BREAD_REFCOUNT_IMMORTAL) return;
+    if (hdr->refcount == BREAD_REFCOUNT_IMMORTAL - 1) {
         BREAD_ERROR_SET_MEMORY_ALLOCATION("Refcount overflow");
         return;
     }
 
     hdr->refcount++;
+    if (!bread_memory_is_untracked(object)) {
+        bread_memory_find_node(object)->color = BREAD_GC_BLACK;
+    }
 }
 
 void bread_object_release(void* object) {
@@ -358,6 +686,7 @@ void bread_object_release(void* object) {
 
     BreadObjHeader* hdr = (BreadObjHeader*)object;
     
+    if (hdr->refcount == BREAD_REFCOUNT_IMMORTAL) return;
     if (hdr->refcount == 0) {
         if (g_mem.debug_mode) {
             fprintf(stderr, "ERROR: Double free detected on object %p\n", object);
@@ -367,9 +696,12 @@ void bread_object_release(void* object) {
     }
 
     hdr->refcount--;
+    if (bread_memory_is_untracked(object)) return; // reclaimed by a nursery reset or arena leave
     
     if (hdr->refcount == 0) {
         bread_memory_free(object);
+    } else {
+        bread_memory_possible_cycle_root(object);
     }
 }
 
@@ -378,6 +710,232 @@ uint32_t bread_object_get_refcount(void* object) {
     return ((BreadObjHeader*)object)->refcount;
 }
 
+// Nursery. Compiled code brackets every statement with mark/reset, and
+// temporaries created in between are bump-allocated from one reserved
+// range with no tracking node. A reset drops everything allocated since
+// its mark at once, so young objects must never outlive their statement:
+// stores into variables, collections, fields and optionals go through
+// bread_memory_promote, which copies a young object to the tracked heap.
+// Marks nest, so a callee's statements never reset its caller's
+// temporaries, and a return value stays in the caller's region. Only
+// strings are allocated young; a string view, which references its parent,
+// registers itself with bread_memory_nursery_finalize so the reset that
+// drops it also drops its references.
+//
+// Young allocation is only on while a statement is open. A mark records
+// the depth it was taken at alongside the offset, and a reset restores
+// both, so the depth returns to zero after the outermost statement even
+// though a return, break or continue skips the resets of the statements
+// it leaves. Outside every statement bread_memory_alloc_young hands out
+// tracked objects, so runtime code called from C never gets a young one.
+
+typedef struct {
+    size_t size;
+    size_t kind;
+} BreadNurseryHeader; // keeps young objects 16-byte aligned
+
+int bread_memory_is_young(const void* object) {
+    return g_mem.nursery_base &&
+           (uintptr_t)object - (uintptr_t)g_mem.nursery_base < BREAD_NURSERY_RESERVE;
+}
+
+static int bread_memory_nursery_map(void) {
+    void* base = mmap(NULL, BREAD_NURSERY_RESERVE, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED) return 0;
+    g_mem.nursery_base = base;
+    g_mem.nursery_top = 0;
+    g_mem.nursery_high_water = 0;
+    return 1;
+}
+
+// Falls back to the tracked heap outside compiled code, for large
+// objects and once the reserved range is used up.
+void* bread_memory_alloc_young(size_t size, BreadObjKind kind) {
+    bread_memory_ensure_init();
+    
+    if (!g_mem.nursery_depth || size > BREAD_NURSERY_MAX_OBJECT) {
+        return bread_memory_alloc(size, kind);
+    }
+    if (!g_mem.nursery_base && !bread_memory_nursery_map()) {
+        return bread_memory_alloc(size, kind);
+    }
+    
+    size_t total = (sizeof(BreadNurseryHeader) + size + 15) & ~(size_t)15;
+    if (total > BREAD_NURSERY_RESERVE - g_mem.nursery_top) {
+        return bread_memory_alloc(size, kind);
+    }
+    
+    BreadNurseryHeader* block = (BreadNurseryHeader*)(g_mem.nursery_base + g_mem.nursery_top);
+    g_mem.nursery_top += total;
+    if (g_mem.nursery_top > g_mem.nursery_high_water) {
+        g_mem.nursery_high_water = g_mem.nursery_top;
+    }
+    
+    block->size = size;
+    block->kind = kind;
+    void* ptr = block + 1;
+    memset(ptr, 0, size);
+    BreadObjHeader* hdr = (BreadObjHeader*)ptr;
+    hdr->kind = (uint32_t)kind;
+    hdr->refcount = 1;
+    g_mem.stats.nursery_allocations++;
+    if (bread_alloc_profile_active) {
+        bread_alloc_profile_record(ptr, size, 0);
+    }
+    return ptr;
+}
+
+// Returns a retained reference that may outlive the current statement:
+// the object itself unless it is young, otherwise a tracked copy.
+void* bread_memory_promote(void* object) {
+    if (!object) return NULL;
+    if (!bread_memory_is_young(object)) {
+        bread_object_retain(object);
+        return object;
+    }
+    
+    BreadNurseryHeader* block = (BreadNurseryHeader*)object - 1;
+    void* copy = bread_memory_alloc(block->size, (BreadObjKind)block->kind);
+    if (!copy) return NULL;
+    memcpy(copy, object, block->size);
+    ((BreadObjHeader*)copy)->refcount = 1;
+    g_mem.stats.nursery_promotions++;
+    return copy;
+}
+
+size_t bread_memory_nursery_mark(void) {
+    bread_memory_ensure_init();
+    size_t mark = (g_mem.nursery_depth << BREAD_NURSERY_DEPTH_SHIFT) | g_mem.nursery_top;
+    g_mem.nursery_depth++;
+    return mark;
+}
+
+int bread_memory_nursery_finalize(void* object) {
+    if (g_mem.nursery_finalizer_count == g_mem.nursery_finalizer_capacity) {
+        size_t capacity = g_mem.nursery_finalizer_capacity ? g_mem.nursery_finalizer_capacity * 2 : 64;
+        void** list = realloc(g_mem.nursery_finalizers, capacity * sizeof(void*));
+        if (!list) return 0;
+        g_mem.nursery_finalizers = list;
+        g_mem.nursery_finalizer_capacity = capacity;
+    }
+    g_mem.nursery_finalizers[g_mem.nursery_finalizer_count++] = object;
+    return 1;
+}
+
+void bread_memory_nursery_reset(size_t mark) {
+    size_t depth = mark >> BREAD_NURSERY_DEPTH_SHIFT;
+    mark &= ((size_t)1 << BREAD_NURSERY_DEPTH_SHIFT) - 1;
+    if (!g_mem_initialized || mark > g_mem.nursery_top) return;
+    g_mem.nursery_top = mark;
+    g_mem.nursery_depth = depth;
+    
+    while (g_mem.nursery_finalizer_count) {
+        void* object = g_mem.nursery_finalizers[g_mem.nursery_finalizer_count - 1];
+        if ((uint8_t*)object < g_mem.nursery_base + mark) break;
+        g_mem.nursery_finalizer_count--;
+        bread_string_finalize_young((BreadString*)object);
+    }
+    
+    // hand back pages a burst of temporaries touched
+    size_t keep = (mark + BREAD_NURSERY_RETAIN + 4095) & ~(size_t)4095;
+    if (g_mem.nursery_high_water > keep) {
+        madvise(g_mem.nursery_base + keep, g_mem.nursery_high_water - keep, MADV_DONTNEED);
+        g_mem.nursery_high_water = keep;
+    }
+}
+
+// Call arena. Functions whose collection literals the escape analysis
+// proved never leave the call open a frame on entry and close it before
+// returning. Those collections are bump-allocated untracked, so refcount
+// traffic on them never reaches the cycle collector. Leaving a frame
+// releases the contents of every arena object still alive in it and
+// drops the memory wholesale. Arena objects are never stored anywhere
+// else, so nothing can reference them once their frame is gone.
+
+static VarType bread_memory_kind_to_type(uint32_t kind);
+
+int bread_memory_is_arena(const void* object) {
+    return g_mem.arena_base &&
+           (uintptr_t)object - (uintptr_t)g_mem.arena_base < BREAD_ARENA_RESERVE;
+}
+
+// Falls back to the tracked heap outside a frame and once the reserved
+// range is used up.
+void* bread_memory_alloc_arena(size_t size, BreadObjKind kind) {
+    bread_memory_ensure_init();
+
+    if (g_mem.arena_depth == 0) {
+        return bread_memory_alloc(size, kind);
+    }
+    if (!g_mem.arena_base) {
+        void* base = mmap(NULL, BREAD_ARENA_RESERVE, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (base == MAP_FAILED) return bread_memory_alloc(size, kind);
+        g_mem.arena_base = base;
+    }
+
+    size_t total = (sizeof(BreadNurseryHeader) + size + 15) & ~(size_t)15;
+    if (total > BREAD_ARENA_RESERVE - g_mem.arena_top) {
+        return bread_memory_alloc(size, kind);
+    }
+
+    BreadNurseryHeader* block = (BreadNurseryHeader*)(g_mem.arena_base + g_mem.arena_top);
+    g_mem.arena_top += total;
+    if (g_mem.arena_top > g_mem.arena_high_water) {
+        g_mem.arena_high_water = g_mem.arena_top;
+    }
+
+    block->size = size;
+    block->kind = kind;
+    void* ptr = block + 1;
+    memset(ptr, 0, size);
+    BreadObjHeader* hdr = (BreadObjHeader*)ptr;
+    hdr->kind = (uint32_t)kind;
+    hdr->refcount = 1;
+    g_mem.stats.arena_allocations++;
+    if (bread_alloc_profile_active) {
+        bread_alloc_profile_record(ptr, size, 0);
+    }
+    return ptr;
+}
+
+size_t bread_memory_arena_enter(void) {
+    bread_memory_ensure_init();
+    g_mem.arena_depth++;
+    return g_mem.arena_top;
+}
+
+void bread_memory_arena_leave(size_t mark) {
+    if (!g_mem_initialized || g_mem.arena_depth == 0 || mark > g_mem.arena_top) return;
+
+    // objects whose count already reached zero freed their contents then
+    size_t offset = mark;
+    while (offset < g_mem.arena_top) {
+        BreadNurseryHeader* block = (BreadNurseryHeader*)(g_mem.arena_base + offset);
+        offset += (sizeof(BreadNurseryHeader) + block->size + 15) & ~(size_t)15;
+
+        BreadObjHeader* hdr = (BreadObjHeader*)(block + 1);
+        if (hdr->refcount == 0) continue;
+        hdr->refcount = 1;
+
+        BreadValue v;
+        memset(&v, 0, sizeof(v));
+        v.type = bread_memory_kind_to_type(hdr->kind);
+        v.value.string_val = (BreadString*)hdr;
+        bread_value_release(&v);
+    }
+
+    g_mem.arena_top = mark;
+    g_mem.arena_depth--;
+
+    size_t keep = (mark + BREAD_NURSERY_RETAIN + 4095) & ~(size_t)4095;
+    if (g_mem.arena_high_water > keep) {
+        madvise(g_mem.arena_base + keep, g_mem.arena_high_water - keep, MADV_DONTNEED);
+        g_mem.arena_high_water = keep;
+    }
+}
+
 int bread_memory_add_root(void* root) {
     bread_memory_ensure_init();
     
@@ -409,115 +967,662 @@ void bread_memory_remove_root(void* root) {
     }
 }
 
-static void bread_memory_mark_value(BreadValue* v, void** stack, int* top, int max_depth) {
-    if (!v || *top >= max_depth) return;
-    
-    void* child = NULL;
-    
+static inline void* bread_memory_value_object(const BreadValue* v) {
     switch (v->type) {
-        case TYPE_STRING:   child = v->value.string_val;   break;
-        case TYPE_ARRAY:    child = v->value.array_val;    break;
-        case TYPE_DICT:     child = v->value.dict_val;     break;
-        case TYPE_OPTIONAL: child = v->value.optional_val; break;
-        case TYPE_STRUCT:   child = v->value.struct_val;   break;
-        case TYPE_CLASS:    child = v->value.class_val;    break;
-        default: return;
-    }
-    
-    if (child) {
-        BreadObjectNode* cn = bread_memory_find_node(child);
-        if (cn && !cn->marked) {
-            stack[(*top)++] = cn;
-        }
+        case TYPE_STRING:
+            // immortal strings sit outside the collector's graph
+            if (v->value.string_val && bread_memory_is_immortal(v->value.string_val)) return NULL;
+            return v->value.string_val;
+        case TYPE_ARRAY:    return v->value.array_val;
+        case TYPE_DICT:     return v->value.dict_val;
+        case TYPE_OPTIONAL: return v->value.optional_val;
+        case TYPE_STRUCT:   return v->value.struct_val;
+        case TYPE_CLASS:    return v->value.class_val;
+        default:            return NULL;
     }
 }
 
-void bread_memory_mark_reachable(void* root) {
-    bread_memory_ensure_init();
-    if (!root) return;
-
-    BreadObjectNode* start = bread_memory_find_node(root);
-    if (!start || start->marked) return;
-    void** stack = malloc(BREAD_MAX_STACK_DEPTH * sizeof(void*));
-    if (!stack) {
-        fprintf(stderr, "ERROR: Failed to allocate GC stack\n");
-        return;
+typedef void (*BreadChildVisitor)(BreadValue* slot, void* ctx);
+
+// Calls `visit` for every value slot of an object that can reference
+// another managed object.
+static void bread_memory_visit_children(BreadObjHeader* hdr, BreadChildVisitor visit, void* ctx) {
+    switch ((BreadObjKind)hdr->kind) {
+        case BREAD_OBJ_ARRAY: {
+            BreadArray* a = (BreadArray*)hdr;
+            if (a->base) {
+                // a sliced array and its slices hold the hidden owner of the
+                // storage they share, and the elements are the owner's
+                BreadValue base = {.type = TYPE_ARRAY};
+                base.value.array_val = a->base;
+                visit(&base, ctx);
+                if (base.type != TYPE_ARRAY) {
+                    // cleared by the collector: let go of the shared storage
+                    // without releasing or freeing any of it
+                    a->base = NULL;
+                    a->items = NULL;
+                    a->unboxed = NULL;
+                    a->count = 0;
+                    a->capacity = 0;
+                    a->head = 0;
+                }
+            } else if (a->items) {
+                for (int i = 0; i < a->count; i++) {
+                    visit(&a->items[i], ctx);
+                }
+            }
+            break;
+        }
+        
+        case BREAD_OBJ_DICT: {
+            BreadDict* d = (BreadDict*)hdr;
+            if (d->entries) {
+                for (int i = 0; i < d->capacity; i++) {
+                    if (d->entries[i].is_occupied && !d->entries[i].is_deleted) {
+                        visit(&d->entries[i].key, ctx);
+                        visit(&d->entries[i].value, ctx);
+                    }
+                }
+            }
+            break;
+        }
+        
+        case BREAD_OBJ_OPTIONAL: {
+            BreadOptional* o = (BreadOptional*)hdr;
+            if (o->is_some) {
+                visit(&o->value, ctx);
+            }
+            break;
+        }
+        
+        case BREAD_OBJ_STRUCT: {
+            BreadStruct* s = (BreadStruct*)hdr;
+            if (s->field_values) {
+                for (int i = 0; i < s->field_count; i++) {
+                    visit(&s->field_values[i], ctx);
+                }
+            }
+            break;
+        }
+        
+        case BREAD_OBJ_CLASS: {
+            BreadClass* c = (BreadClass*)hdr;
+            if (c->field_values) {
+                for (int i = 0; i < c->field_count; i++) {
+                    visit(&c->field_values[i], ctx);
+                }
+            }
+            break;
+        }
+        
+        case BREAD_OBJ_STRING:
+        case BREAD_OBJ_UNKNOWN:
+        default:
+            break;
+    }
+}
+
+static inline int bread_memory_kind_has_children(uint32_t kind) {
+    return kind == BREAD_OBJ_ARRAY || kind == BREAD_OBJ_DICT || kind == BREAD_OBJ_OPTIONAL ||
+           kind == BREAD_OBJ_STRUCT || kind == BREAD_OBJ_CLASS;
+}
+
+typedef struct {
+    BreadObjectNode** items;
+    size_t count;
+    size_t capacity;
+} BreadNodeStack;
+
+static void bread_node_stack_push(BreadNodeStack* s, BreadObjectNode* node) {
+    if (s->count >= s->capacity) {
+        size_t new_capacity = s->capacity == 0 ? 64 : s->capacity * 2;
+        BreadObjectNode** items = realloc(s->items, new_capacity * sizeof(BreadObjectNode*));
+        if (!items) {
+            // bailing out halfway would leave marks or trial counts behind
+            fprintf(stderr, "CRITICAL: Out of memory during garbage collection\n");
+            abort();
+        }
+        s->items = items;
+        s->capacity = new_capacity;
+    }
+    s->items[s->count++] = node;
+}
+
+static inline BreadObjectNode* bread_node_stack_pop(BreadNodeStack* s) {
+    return s->count > 0 ? s->items[--s->count] : NULL;
+}
+
+static void bread_memory_mark_value(BreadValue* v, void* ctx) {
+    void* child = bread_memory_value_object(v);
+    if (child) {
+        BreadObjectNode* cn = bread_memory_find_node(child);
+        if (!cn->marked) {
+            bread_node_stack_push((BreadNodeStack*)ctx, cn);
+        }
+    }
+}
+
+typedef enum {
+    BREAD_PMARK_REACHABLE, // set mark bits
+    BREAD_PMARK_GRAY,      // trial deletion: colour gray, discount edges
+    BREAD_PMARK_SCAN       // trial deletion: colour white or restore black
+} BreadParallelPhase;
+
+static int bread_memory_use_parallel_mark(void);
+static size_t bread_memory_parallel_mark(BreadParallelPhase phase, BreadObjectNode** seeds, size_t count);
+
+void bread_memory_mark_reachable(void* root) {
+    bread_memory_ensure_init();
+    if (!root) return;
+
+    BreadObjectNode* start = bread_memory_find_node(root);
+    if (start->marked) return;
+    if (bread_memory_use_parallel_mark()) {
+        bread_memory_parallel_mark(BREAD_PMARK_REACHABLE, &start, 1);
+        return;
     }
     
-    int top = 0;
-    stack[top++] = start;
+    BreadNodeStack stack = {0};
+    bread_node_stack_push(&stack, start);
 
-    while (top > 0) {
-        BreadObjectNode* cur = (BreadObjectNode*)stack[--top];
+    while (stack.count > 0) {
+        BreadObjectNode* cur = bread_node_stack_pop(&stack);
         
-        if (!cur || cur->marked) continue;
+        if (cur->marked) continue;
         cur->marked = 1;
 
-        BreadObjHeader* hdr = (BreadObjHeader*)cur->object;
-        if (!hdr) continue;
+        bread_memory_visit_children((BreadObjHeader*)bread_memory_node_object(cur),
+                                    bread_memory_mark_value, &stack);
+    }
+    
+    free(stack.items);
+}
 
-        switch ((BreadObjKind)hdr->kind) {
-            case BREAD_OBJ_ARRAY: {
-                BreadArray* a = (BreadArray*)cur->object;
-                if (a && a->items) {
-                    for (int i = 0; i < a->count; i++) {
-                        bread_memory_mark_value(&a->items[i], (void**)stack, &top, BREAD_MAX_STACK_DEPTH);
-                    }
-                }
-                break;
-            }
+// Synchronous trial-deletion cycle collector (Bacon & Rajan, "Concurrent
+// Cycle Collection in Reference Counted Systems", section 3). Containers
+// whose count drops to a non-zero value are buffered as possible roots;
+// a collection only walks the subgraphs reachable from those roots.
+
+static BreadNodeStack g_gc_work = {0};
+
+static void bread_gc_gray_child(BreadValue* v, void* ctx) {
+    (void)ctx;
+    void* child = bread_memory_value_object(v);
+    if (!child) return;
+    
+    ((BreadObjHeader*)child)->refcount--;
+    BreadObjectNode* cn = bread_memory_find_node(child);
+    if (cn->color != BREAD_GC_GRAY) {
+        bread_node_stack_push(&g_gc_work, cn);
+    }
+}
+
+// Returns the number of objects newly coloured gray.
+static size_t bread_gc_mark_gray(BreadObjectNode* node) {
+    size_t visited = 0;
+    bread_node_stack_push(&g_gc_work, node);
+    while (g_gc_work.count > 0) {
+        BreadObjectNode* cur = bread_node_stack_pop(&g_gc_work);
+        if (cur->color == BREAD_GC_GRAY) continue;
+        cur->color = BREAD_GC_GRAY;
+        visited++;
+        bread_memory_visit_children((BreadObjHeader*)bread_memory_node_object(cur),
+                                    bread_gc_gray_child, NULL);
+    }
+    return visited;
+}
+
+static void bread_gc_black_child(BreadValue* v, void* ctx) {
+    BreadNodeStack* stack = (BreadNodeStack*)ctx;
+    void* child = bread_memory_value_object(v);
+    if (!child) return;
+    
+    ((BreadObjHeader*)child)->refcount++;
+    BreadObjectNode* cn = bread_memory_find_node(child);
+    if (cn->color != BREAD_GC_BLACK) {
+        cn->color = BREAD_GC_BLACK;
+        bread_node_stack_push(stack, cn);
+    }
+}
+
+static void bread_gc_scan_black(BreadObjectNode* node) {
+    static BreadNodeStack stack = {0};
+    node->color = BREAD_GC_BLACK;
+    bread_node_stack_push(&stack, node);
+    while (stack.count > 0) {
+        BreadObjectNode* cur = bread_node_stack_pop(&stack);
+        bread_memory_visit_children((BreadObjHeader*)bread_memory_node_object(cur),
+                                    bread_gc_black_child, &stack);
+    }
+}
+
+static void bread_gc_push_child(BreadValue* v, void* ctx) {
+    void* child = bread_memory_value_object(v);
+    if (child) {
+        bread_node_stack_push((BreadNodeStack*)ctx, bread_memory_find_node(child));
+    }
+}
+
+static void bread_gc_scan(BreadObjectNode* node) {
+    bread_node_stack_push(&g_gc_work, node);
+    while (g_gc_work.count > 0) {
+        BreadObjectNode* cur = bread_node_stack_pop(&g_gc_work);
+        if (cur->color != BREAD_GC_GRAY) continue;
+        
+        BreadObjHeader* hdr = (BreadObjHeader*)bread_memory_node_object(cur);
+        if (hdr->refcount > 0) {
+            bread_gc_scan_black(cur);
+        } else {
+            cur->color = BREAD_GC_WHITE;
+            bread_memory_visit_children(hdr, bread_gc_push_child, &g_gc_work);
+        }
+    }
+}
+
+static void bread_gc_collect_white(BreadObjectNode* node, BreadNodeStack* garbage) {
+    bread_node_stack_push(&g_gc_work, node);
+    while (g_gc_work.count > 0) {
+        BreadObjectNode* cur = bread_node_stack_pop(&g_gc_work);
+        if (cur->color != BREAD_GC_WHITE) continue;
+        
+        cur->color = BREAD_GC_BLACK;
+        bread_node_stack_push(garbage, cur);
+        bread_memory_visit_children((BreadObjHeader*)bread_memory_node_object(cur),
+                                    bread_gc_push_child, &g_gc_work);
+    }
+}
+
+// Parallel marking. Full collections over a large heap spread the gray
+// and scan phases (and mark_reachable) across gc_threads workers. Each
+// worker owns a Chase-Lev work-stealing deque (memory orders as in Le et
+// al., "Correct and Efficient Work-Stealing for Weak Memory Models"); a
+// full deque grows rather than dropping work, and retired buffers are
+// freed once the phase is over. Every node moves to a given colour (or
+// mark) through a CAS, so each node is expanded exactly once and the
+// outcome matches the sequential phases.
+
+#define BREAD_MARK_DEQUE_INITIAL 1024
+#define BREAD_MARK_TASK_BLACKEN ((uintptr_t)1) // scan phase: restore a node's children
+
+typedef struct BreadMarkBuffer {
+    struct BreadMarkBuffer* retired;
+    int64_t mask;
+    uintptr_t slots[];
+} BreadMarkBuffer;
+
+typedef struct {
+    _Alignas(64) int64_t top;
+    int64_t bottom;
+    BreadMarkBuffer* buffer;
+} BreadMarkDeque;
+
+typedef struct BreadParallelMark BreadParallelMark;
+
+typedef struct {
+    BreadMarkDeque deque;
+    BreadParallelMark* shared;
+    int id;
+    size_t visited;
+} BreadMarkWorker;
+
+struct BreadParallelMark {
+    BreadParallelPhase phase;
+    int thread_count;
+    int idle;
+    int started;
+    BreadMarkWorker workers[BREAD_GC_MAX_THREADS];
+};
+
+static BreadMarkBuffer* bread_mark_buffer_new(int64_t capacity, BreadMarkBuffer* retired) {
+    BreadMarkBuffer* buffer = malloc(sizeof(BreadMarkBuffer) + (size_t)capacity * sizeof(uintptr_t));
+    if (!buffer) {
+        fprintf(stderr, "CRITICAL: Out of memory during garbage collection\n");
+        abort();
+    }
+    buffer->retired = retired;
+    buffer->mask = capacity - 1;
+    return buffer;
+}
+
+static void bread_mark_deque_init(BreadMarkDeque* d) {
+    d->top = 0;
+    d->bottom = 0;
+    d->buffer = bread_mark_buffer_new(BREAD_MARK_DEQUE_INITIAL, NULL);
+}
+
+static void bread_mark_deque_destroy(BreadMarkDeque* d) {
+    BreadMarkBuffer* buffer = d->buffer;
+    while (buffer) {
+        BreadMarkBuffer* retired = buffer->retired;
+        free(buffer);
+        buffer = retired;
+    }
+    d->buffer = NULL;
+}
+
+// Owner only.
+static void bread_mark_deque_push(BreadMarkDeque* d, uintptr_t item) {
+    int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED);
+    int64_t t = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+    BreadMarkBuffer* buffer = __atomic_load_n(&d->buffer, __ATOMIC_RELAXED);
+    
+    if (b - t > buffer->mask) {
+        // thieves may still read the old buffer, so it is only retired
+        BreadMarkBuffer* grown = bread_mark_buffer_new((buffer->mask + 1) * 2, buffer);
+        for (int64_t i = t; i < b; i++) {
+            grown->slots[i & grown->mask] = buffer->slots[i & buffer->mask];
+        }
+        __atomic_store_n(&d->buffer, grown, __ATOMIC_RELEASE);
+        buffer = grown;
+    }
+    
+    __atomic_store_n(&buffer->slots[b & buffer->mask], item, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+}
+
+// Owner only. Returns 0 when empty.
+static uintptr_t bread_mark_deque_take(BreadMarkDeque* d) {
+    int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_RELAXED) - 1;
+    BreadMarkBuffer* buffer = __atomic_load_n(&d->buffer, __ATOMIC_RELAXED);
+    __atomic_store_n(&d->bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t t = __atomic_load_n(&d->top, __ATOMIC_RELAXED);
+    
+    if (t > b) {
+        __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+        return 0;
+    }
+    
+    uintptr_t item = __atomic_load_n(&buffer->slots[b & buffer->mask], __ATOMIC_RELAXED);
+    if (t == b) {
+        // last item: race the thieves for it
+        if (!__atomic_compare_exchange_n(&d->top, &t, t + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            item = 0;
+        }
+        __atomic_store_n(&d->bottom, b + 1, __ATOMIC_RELAXED);
+    }
+    return item;
+}
+
+// Any thread. Returns 0 when empty or when another thief won.
+static uintptr_t bread_mark_deque_steal(BreadMarkDeque* d) {
+    int64_t t = __atomic_load_n(&d->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t b = __atomic_load_n(&d->bottom, __ATOMIC_ACQUIRE);
+    if (t >= b) return 0;
+    
+    BreadMarkBuffer* buffer = __atomic_load_n(&d->buffer, __ATOMIC_ACQUIRE);
+    uintptr_t item = __atomic_load_n(&buffer->slots[t & buffer->mask], __ATOMIC_RELAXED);
+    if (!__atomic_compare_exchange_n(&d->top, &t, t + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+    return item;
+}
+
+static inline int bread_mark_deque_has_work(BreadMarkDeque* d) {
+    return __atomic_load_n(&d->top, __ATOMIC_ACQUIRE) < __atomic_load_n(&d->bottom, __ATOMIC_ACQUIRE);
+}
+
+// Moves *field to `value`; returns 1 for the one thread that did so.
+static inline int bread_pmark_claim(uint8_t* field, uint8_t value) {
+    uint8_t current = __atomic_load_n(field, __ATOMIC_RELAXED);
+    while (current != value) {
+        if (__atomic_compare_exchange_n(field, &current, value, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void bread_pmark_child(BreadValue* v, void* ctx) {
+    BreadMarkWorker* worker = (BreadMarkWorker*)ctx;
+    void* child = bread_memory_value_object(v);
+    if (!child) return;
+    
+    BreadObjectNode* cn = bread_memory_find_node(child);
+    switch (worker->shared->phase) {
+        case BREAD_PMARK_REACHABLE:
+            if (__atomic_load_n(&cn->marked, __ATOMIC_RELAXED)) return;
+            break;
+        case BREAD_PMARK_GRAY:
+            __atomic_fetch_sub(&((BreadObjHeader*)child)->refcount, 1, __ATOMIC_RELAXED);
+            if (__atomic_load_n(&cn->color, __ATOMIC_RELAXED) == BREAD_GC_GRAY) return;
+            break;
+        case BREAD_PMARK_SCAN:
+            break;
+    }
+    bread_mark_deque_push(&worker->deque, (uintptr_t)cn);
+}
+
+static void bread_pmark_black_child(BreadValue* v, void* ctx) {
+    BreadMarkWorker* worker = (BreadMarkWorker*)ctx;
+    void* child = bread_memory_value_object(v);
+    if (!child) return;
+    
+    __atomic_fetch_add(&((BreadObjHeader*)child)->refcount, 1, __ATOMIC_RELAXED);
+    BreadObjectNode* cn = bread_memory_find_node(child);
+    if (bread_pmark_claim(&cn->color, BREAD_GC_BLACK)) {
+        bread_mark_deque_push(&worker->deque, (uintptr_t)cn | BREAD_MARK_TASK_BLACKEN);
+    }
+}
+
+static void bread_pmark_process(BreadMarkWorker* worker, uintptr_t item) {
+    BreadObjectNode* node = (BreadObjectNode*)(item & ~BREAD_MARK_TASK_BLACKEN);
+    BreadObjHeader* hdr = (BreadObjHeader*)bread_memory_node_object(node);
+    
+    if (item & BREAD_MARK_TASK_BLACKEN) {
+        bread_memory_visit_children(hdr, bread_pmark_black_child, worker);
+        return;
+    }
+    
+    switch (worker->shared->phase) {
+        case BREAD_PMARK_REACHABLE:
+            if (!bread_pmark_claim(&node->marked, 1)) return;
+            worker->visited++;
+            bread_memory_visit_children(hdr, bread_pmark_child, worker);
+            break;
             
-            case BREAD_OBJ_DICT: {
-                BreadDict* d = (BreadDict*)cur->object;
-                if (d && d->entries) {
-                    for (int i = 0; i < d->capacity; i++) {
-                        if (d->entries[i].is_occupied && !d->entries[i].is_deleted) {
-                            bread_memory_mark_value(&d->entries[i].key, (void**)stack, &top, BREAD_MAX_STACK_DEPTH);
-                            bread_memory_mark_value(&d->entries[i].value, (void**)stack, &top, BREAD_MAX_STACK_DEPTH);
-                        }
-                    }
-                }
-                break;
-            }
+        case BREAD_PMARK_GRAY:
+            if (!bread_pmark_claim(&node->color, BREAD_GC_GRAY)) return;
+            worker->visited++;
+            bread_memory_visit_children(hdr, bread_pmark_child, worker);
+            break;
             
-            case BREAD_OBJ_OPTIONAL: {
-                BreadOptional* o = (BreadOptional*)cur->object;
-                if (o && o->is_some) {
-                    bread_memory_mark_value(&o->value, (void**)stack, &top, BREAD_MAX_STACK_DEPTH);
+        case BREAD_PMARK_SCAN: {
+            // Counts only grow during the scan, and whoever raises one also
+            // blackens the node, so losing either CAS below is harmless.
+            uint8_t gray = BREAD_GC_GRAY;
+            if (__atomic_load_n(&hdr->refcount, __ATOMIC_RELAXED) > 0) {
+                if (__atomic_compare_exchange_n(&node->color, &gray, BREAD_GC_BLACK, 0,
+                                                __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+                    bread_memory_visit_children(hdr, bread_pmark_black_child, worker);
                 }
-                break;
+            } else if (__atomic_compare_exchange_n(&node->color, &gray, BREAD_GC_WHITE, 0,
+                                                   __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+                bread_memory_visit_children(hdr, bread_pmark_child, worker);
             }
-            
-            case BREAD_OBJ_STRUCT: {
-                BreadStruct* s = (BreadStruct*)cur->object;
-                if (s && s->field_values) {
-                    for (int i = 0; i < s->field_count; i++) {
-                        bread_memory_mark_value(&s->field_values[i], (void**)stack, &top, BREAD_MAX_STACK_DEPTH);
-                    }
-                }
-                break;
+            break;
+        }
+    }
+}
+
+static uintptr_t bread_pmark_steal(BreadMarkWorker* worker) {
+    BreadParallelMark* pm = worker->shared;
+    for (int i = 1; i < pm->thread_count; i++) {
+        BreadMarkWorker* victim = &pm->workers[(worker->id + i) % pm->thread_count];
+        uintptr_t item = bread_mark_deque_steal(&victim->deque);
+        if (item) return item;
+    }
+    return 0;
+}
+
+static int bread_pmark_work_visible(BreadParallelMark* pm) {
+    for (int i = 0; i < pm->thread_count; i++) {
+        if (bread_mark_deque_has_work(&pm->workers[i].deque)) return 1;
+    }
+    return 0;
+}
+
+// Workers only push to their own deque and only go idle with it empty, so
+// once every worker is idle there is nothing left anywhere. An idle worker
+// leaves the idle count before it tries to steal again.
+static void* bread_pmark_worker(void* arg) {
+    BreadMarkWorker* worker = (BreadMarkWorker*)arg;
+    BreadParallelMark* pm = worker->shared;
+    
+    while (!__atomic_load_n(&pm->started, __ATOMIC_ACQUIRE)) {
+        sched_yield();
+    }
+    
+    for (;;) {
+        uintptr_t item = bread_mark_deque_take(&worker->deque);
+        if (!item) item = bread_pmark_steal(worker);
+        if (item) {
+            bread_pmark_process(worker, item);
+            continue;
+        }
+        
+        __atomic_fetch_add(&pm->idle, 1, __ATOMIC_SEQ_CST);
+        for (;;) {
+            if (__atomic_load_n(&pm->idle, __ATOMIC_SEQ_CST) == pm->thread_count) {
+                return NULL;
             }
-            
-            case BREAD_OBJ_CLASS: {
-                BreadClass* c = (BreadClass*)cur->object;
-                if (c && c->field_values) {
-                    for (int i = 0; i < c->field_count; i++) {
-                        bread_memory_mark_value(&c->field_values[i], (void**)stack, &top, BREAD_MAX_STACK_DEPTH);
-                    }
-                }
+            if (bread_pmark_work_visible(pm)) {
+                __atomic_fetch_sub(&pm->idle, 1, __ATOMIC_SEQ_CST);
                 break;
             }
-            
-            case BREAD_OBJ_STRING:
-            case BREAD_OBJ_UNKNOWN:
-            default:
-                break;
+            sched_yield();
         }
     }
+}
+
+static int bread_memory_use_parallel_mark(void) {
+    return g_mem.gc_threads > 1 && g_mem.stats.current_objects >= BREAD_GC_PARALLEL_MIN_OBJECTS;
+}
+
+// Runs one phase to completion over the given seeds on up to gc_threads
+// threads, the caller included. Returns the number of nodes expanded.
+static size_t bread_memory_parallel_mark(BreadParallelPhase phase, BreadObjectNode** seeds, size_t count) {
+    static BreadParallelMark pm;
+    pthread_t threads[BREAD_GC_MAX_THREADS];
     
-    free(stack);
+    memset(&pm, 0, sizeof(pm));
+    pm.phase = phase;
+    pm.thread_count = g_mem.gc_threads;
+    for (int i = 0; i < pm.thread_count; i++) {
+        pm.workers[i].shared = &pm;
+        pm.workers[i].id = i;
+    }
+    
+    // workers wait for `started`, so a failed spawn just shrinks the team
+    int spawned = 1;
+    while (spawned < pm.thread_count) {
+        if (pthread_create(&threads[spawned], NULL, bread_pmark_worker, &pm.workers[spawned]) != 0) {
+            break;
+        }
+        spawned++;
+    }
+    pm.thread_count = spawned;
+    
+    for (int i = 0; i < pm.thread_count; i++) {
+        bread_mark_deque_init(&pm.workers[i].deque);
+    }
+    for (size_t i = 0; i < count; i++) {
+        bread_mark_deque_push(&pm.workers[i % pm.thread_count].deque, (uintptr_t)seeds[i]);
+    }
+    
+    __atomic_store_n(&pm.started, 1, __ATOMIC_RELEASE);
+    bread_pmark_worker(&pm.workers[0]);
+    
+    size_t visited = pm.workers[0].visited;
+    for (int i = 1; i < pm.thread_count; i++) {
+        pthread_join(threads[i], NULL);
+        visited += pm.workers[i].visited;
+    }
+    for (int i = 0; i < pm.thread_count; i++) {
+        bread_mark_deque_destroy(&pm.workers[i].deque);
+    }
+    return visited;
+}
+
+static VarType bread_memory_kind_to_type(uint32_t kind) {
+    switch ((BreadObjKind)kind) {
+        case BREAD_OBJ_STRING:   return TYPE_STRING;
+        case BREAD_OBJ_ARRAY:    return TYPE_ARRAY;
+        case BREAD_OBJ_DICT:     return TYPE_DICT;
+        case BREAD_OBJ_OPTIONAL: return TYPE_OPTIONAL;
+        case BREAD_OBJ_STRUCT:   return TYPE_STRUCT;
+        case BREAD_OBJ_CLASS:    return TYPE_CLASS;
+        default:                 return TYPE_NIL;
+    }
 }
 
+static void bread_gc_clear_slot(BreadValue* v, void* ctx) {
+    (void)ctx;
+    if (bread_memory_value_object(v)) {
+        memset(v, 0, sizeof(BreadValue));
+        v->type = TYPE_NIL;
+    }
+}
+
+// Frees a garbage object through its normal release path. Its outgoing
+// references were already discounted by the trial deletion, so the slots
+// are cleared first and nothing is released twice.
+static void bread_gc_free_garbage(BreadObjectNode* node) {
+    BreadObjHeader* hdr = (BreadObjHeader*)bread_memory_node_object(node);
+    bread_memory_visit_children(hdr, bread_gc_clear_slot, NULL);
+    hdr->refcount = 1;
+    
+    VarType type = bread_memory_kind_to_type(hdr->kind);
+    if (type == TYPE_NIL) {
+        bread_object_release(hdr);
+        return;
+    }
+    
+    BreadValue v;
+    memset(&v, 0, sizeof(v));
+    v.type = type;
+    v.value.string_val = (BreadString*)hdr;
+    bread_value_release(&v);
+}
+
+// Drops a buffered root whose object died while it sat in the buffer.
+static void bread_gc_unbuffer(BreadObjectNode* node) {
+    node->buffered = 0;
+    if (((BreadObjHeader*)bread_memory_node_object(node))->refcount == 0) {
+        bread_memory_release_block(node);
+    }
+}
+
+static void bread_memory_drop_cycle_roots(void) {
+    for (size_t i = 0; i < g_mem.cycle_root_count; i++) {
+        bread_gc_unbuffer(g_mem.cycle_roots[i]);
+    }
+    g_mem.cycle_root_count = 0;
+}
+
+void bread_memory_possible_cycle_root(void* object) {
+    if (!object || !g_mem_initialized || !g_mem.cycle_collection_enabled) return;
+    if (bread_memory_is_untracked(object)) return;
+    
+    BreadObjectNode* node = bread_memory_find_node(object);
+    if (!bread_memory_kind_has_children(((BreadObjHeader*)object)->kind)) return;
+    
+    node->color = BREAD_GC_PURPLE;
+    if (node->buffered) return;
+    
+    if (g_mem.cycle_root_count >= g_mem.cycle_root_capacity) {
+        size_t new_capacity = g_mem.cycle_root_capacity == 0 ? 256 : g_mem.cycle_root_capacity * 2;
+        BreadObjectNode** roots = realloc(g_mem.cycle_roots, new_capacity * sizeof(BreadObjectNode*));
+        if (!roots) return;
+        g_mem.cycle_roots = roots;
+        g_mem.cycle_root_capacity = new_capacity;
+    }
+    
+    node->buffered = 1;
+    g_mem.cycle_roots[g_mem.cycle_root_count++] = node;
+}
 
 void bread_memory_collect_cycles(void) {
     bread_memory_ensure_init();
@@ -526,23 +1631,98 @@ void bread_memory_collect_cycles(void) {
         return;
     }
     
-    size_t objects_before = g_mem.stats.current_objects;
-    for (BreadObjectNode* n = g_mem.all_objects; n; n = n->next) {
-        n->marked = 0;
+    bread_memory_run_collection();
+}
+
+static inline uint64_t bread_memory_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void bread_memory_record_pause(uint64_t pause_ns) {
+    uint64_t us = pause_ns / 1000;
+    int bucket = 0;
+    while (bucket < BREAD_GC_PAUSE_BUCKETS - 1 && us >= (1ULL << bucket)) {
+        bucket++;
+    }
+    
+    g_mem.stats.gc_collections++;
+    g_mem.stats.gc_pause_total_ns += pause_ns;
+    if (pause_ns > g_mem.stats.gc_pause_max_ns) {
+        g_mem.stats.gc_pause_max_ns = pause_ns;
     }
+    g_mem.stats.gc_pause_histogram[bucket]++;
+}
 
-    for (BreadObjectNode* n = g_mem.all_objects; n; n = n->next) {
-        BreadObjHeader* hdr = (BreadObjHeader*)n->object;
-        if (hdr && hdr->refcount > 0) {
-            bread_memory_mark_reachable(n->object);
+static void bread_memory_run_collection(void) {
+    bread_memory_collect_slice(0, 0);
+}
+
+// Runs trial deletion over the newest candidate roots until either budget
+// is spent (0 = unbounded), leaving older candidates for the next slice.
+// Each slice is a complete trial deletion over the roots it picked, so
+// mutator activity between slices cannot invalidate it. A white object
+// that still sits in the buffer is freed like any other; its block is
+// kept until a later slice drops the buffer entry.
+static void bread_memory_collect_slice(uint64_t budget_ns, size_t budget_objects) {
+    uint64_t start = bread_memory_now_ns();
+    size_t objects_before = g_mem.stats.current_objects;
+    
+    // explicit roots count as external references for the duration
+    for (size_t i = 0; i < g_mem.gc_root_count; i++) {
+        ((BreadObjHeader*)g_mem.gc_roots[i])->refcount++;
+    }
+    
+    // mark roots: keep purple candidates, drop the rest
+    size_t kept = 0;
+    for (size_t i = 0; i < g_mem.cycle_root_count; i++) {
+        BreadObjectNode* node = g_mem.cycle_roots[i];
+        BreadObjHeader* hdr = (BreadObjHeader*)bread_memory_node_object(node);
+        if (node->color == BREAD_GC_PURPLE && hdr->refcount > 0) {
+            g_mem.cycle_roots[kept++] = node;
+        } else {
+            bread_gc_unbuffer(node);
+        }
+    }
+    g_mem.cycle_root_count = kept;
+    
+    size_t first = g_mem.cycle_root_count;
+    if (!budget_ns && !budget_objects && bread_memory_use_parallel_mark()) {
+        bread_memory_parallel_mark(BREAD_PMARK_GRAY, g_mem.cycle_roots, first);
+        first = 0;
+        bread_memory_parallel_mark(BREAD_PMARK_SCAN, g_mem.cycle_roots, g_mem.cycle_root_count);
+    } else {
+        size_t visited = 0;
+        while (first > 0) {
+            visited += bread_gc_mark_gray(g_mem.cycle_roots[--first]);
+            if (budget_objects && visited >= budget_objects) break;
+            if (budget_ns && bread_memory_now_ns() - start >= budget_ns) break;
+        }
+        
+        for (size_t i = first; i < g_mem.cycle_root_count; i++) {
+            bread_gc_scan(g_mem.cycle_roots[i]);
         }
     }
     
+    BreadNodeStack garbage = {0};
+    for (size_t i = first; i < g_mem.cycle_root_count; i++) {
+        g_mem.cycle_roots[i]->buffered = 0;
+    }
+    for (size_t i = first; i < g_mem.cycle_root_count; i++) {
+        bread_gc_collect_white(g_mem.cycle_roots[i], &garbage);
+    }
+    g_mem.cycle_root_count = first;
+    g_mem.gc_slice_pending = first > 0;
+    
     for (size_t i = 0; i < g_mem.gc_root_count; i++) {
-        bread_memory_mark_reachable(g_mem.gc_roots[i]);
+        ((BreadObjHeader*)g_mem.gc_roots[i])->refcount--;
     }
-
-    bread_memory_sweep_unreachable();
+    
+    for (size_t i = 0; i < garbage.count; i++) {
+        bread_gc_free_garbage(garbage.items[i]);
+    }
+    free(garbage.items);
     
     g_mem.allocations_since_gc = 0;
     g_mem.bytes_since_gc = 0;
@@ -550,47 +1730,51 @@ void bread_memory_collect_cycles(void) {
     size_t objects_freed = objects_before > g_mem.stats.current_objects ? 
                           objects_before - g_mem.stats.current_objects : 0;
     
-    if (objects_freed < g_mem.gc_threshold / 10) {
+    // only full passes say anything about how much garbage there is
+    if (!budget_ns && !budget_objects && objects_freed < g_mem.gc_threshold / 10) {
         g_mem.gc_threshold = (g_mem.gc_threshold * 3) / 2;
     }
     
+    bread_memory_record_pause(bread_memory_now_ns() - start);
+    
     if (g_mem.debug_mode) {
-        fprintf(stderr, "GC: freed %zu objects, %zu remaining, threshold now %zu\n",
-                objects_freed, g_mem.stats.current_objects, g_mem.gc_threshold);
+        fprintf(stderr, "GC: freed %zu objects, %zu remaining, %zu candidates pending, threshold now %zu\n",
+                objects_freed, g_mem.stats.current_objects, first, g_mem.gc_threshold);
     }
 }
 
+// Runs one bounded slice if incremental collection has work pending.
+void bread_memory_gc_safepoint(void) {
+    if (!g_mem_initialized || !g_mem.cycle_collection_enabled) return;
+    if (!bread_memory_gc_is_incremental()) return;
+    if (g_mem.cycle_root_count == 0) {
+        g_mem.allocations_since_gc = 0;
+        g_mem.bytes_since_gc = 0;
+        return;
+    }
+    
+    bread_memory_collect_slice((uint64_t)g_mem.gc_slice_budget_us * 1000, g_mem.gc_slice_budget_objects);
+}
+
 void bread_memory_sweep_unreachable(void) {
     bread_memory_ensure_init();
     
-    BreadObjectNode** cur = &g_mem.all_objects;
+    BreadObjectNode* head = &g_mem.all_objects;
+    BreadObjectNode* node = head->next;
     
-    while (*cur) {
-        BreadObjectNode* node = *cur;
+    while (node != head) {
+        BreadObjectNode* next = node->next;
         
         if (!node->marked) {
-            BreadObjHeader* hdr = (BreadObjHeader*)node->object;
+            BreadObjHeader* hdr = (BreadObjHeader*)bread_memory_node_object(node);
             
-            if (hdr && hdr->refcount == 0) {
-                *cur = node->next;
-                
-                if (!bread_pool_free(&g_mem.small_pool, node->object)) {
-                    free(node->object);
-                }
-                
-                g_mem.stats.bytes_freed += node->size;
-                g_mem.stats.total_deallocations++;
-                
-                if (g_mem.stats.current_objects > 0) {
-                    g_mem.stats.current_objects--;
-                }
-                
-                free(node);
-                continue;
+            if (hdr->refcount == 0) {
+                bread_memory_untrack_object_internal(hdr);
+                bread_memory_release_block(node);
             }
         }
         
-        cur = &(*cur)->next;
+        node = next;
     }
 }
 
@@ -599,6 +1783,23 @@ BreadMemoryStats bread_memory_get_stats(void) {
     return g_mem.stats;
 }
 
+static void bread_memory_print_pause_histogram(void) {
+    fprintf(stderr,
+        "GC pauses:       %zu (avg %.1f us, max %.1f us)\n",
+        g_mem.stats.gc_collections,
+        (double)g_mem.stats.gc_pause_total_ns / 1000.0 / (double)g_mem.stats.gc_collections,
+        (double)g_mem.stats.gc_pause_max_ns / 1000.0);
+    for (int i = 0; i < BREAD_GC_PAUSE_BUCKETS; i++) {
+        size_t count = g_mem.stats.gc_pause_histogram[i];
+        if (count == 0) continue;
+        if (i == BREAD_GC_PAUSE_BUCKETS - 1) {
+            fprintf(stderr, "  >= %6llu us: %zu\n", 1ULL << (i - 1), count);
+        } else {
+            fprintf(stderr, "  <  %6llu us: %zu\n", 1ULL << i, count);
+        }
+    }
+}
+
 void bread_memory_print_stats(void) {
     if (!g_mem_initialized) return;
 
@@ -611,9 +1812,10 @@ void bread_memory_print_stats(void) {
         "Bytes allocated: %zu\n"
         "Bytes freed:     %zu\n"
         "Net memory:      %zu bytes\n"
+        "Backing bytes:   %zu (peak %zu)\n"
         "Pool chunks:     %zu\n"
-        "GC threshold:    %zu\n"
-        "================================\n",
+        "Chunks released: %zu\n"
+        "GC threshold:    %zu\n",
         g_mem.stats.total_allocations,
         g_mem.stats.total_deallocations,
         g_mem.stats.current_objects,
@@ -622,8 +1824,29 @@ void bread_memory_print_stats(void) {
         g_mem.stats.bytes_freed,
         g_mem.stats.bytes_allocated > g_mem.stats.bytes_freed ?
             g_mem.stats.bytes_allocated - g_mem.stats.bytes_freed : 0,
-        g_mem.small_pool.total_chunks,
+        g_mem.stats.backing_bytes,
+        g_mem.stats.peak_backing_bytes,
+        bread_pool_total_chunks(),
+        g_mem.stats.chunks_released,
         g_mem.gc_threshold);
+
+    if (g_mem.stats.nursery_allocations > 0) {
+        fprintf(stderr, "Nursery allocs:  %zu (%zu promoted)\n",
+                g_mem.stats.nursery_allocations, g_mem.stats.nursery_promotions);
+    }
+    if (g_mem.stats.arena_allocations > 0) {
+        fprintf(stderr, "Arena allocs:    %zu\n", g_mem.stats.arena_allocations);
+    }
+    size_t interned = 0, intern_lookups = 0, intern_hits = 0;
+    bread_string_intern_stats(&interned, &intern_lookups, &intern_hits);
+    if (intern_lookups > 0) {
+        fprintf(stderr, "Interned:        %zu strings, %zu/%zu literal lookups hit (%.1f%%)\n",
+                interned, intern_hits, intern_lookups, 100.0 * (double)intern_hits / (double)intern_lookups);
+    }
+    if (g_mem.stats.gc_collections > 0) {
+        bread_memory_print_pause_histogram();
+    }
+    fprintf(stderr, "================================\n");
 }
 
 int bread_memory_check_leaks(void) {
@@ -654,15 +1877,16 @@ void bread_memory_print_leak_report(void) {
         "OPTIONAL", "STRUCT", "CLASS"
     };
     
-    for (BreadObjectNode* n = g_mem.all_objects; n; n = n->next) {
-        BreadObjHeader* hdr = (BreadObjHeader*)n->object;
+    BreadObjectNode* head = &g_mem.all_objects;
+    for (BreadObjectNode* n = head->next; n != head; n = n->next) {
+        BreadObjHeader* hdr = (BreadObjHeader*)bread_memory_node_object(n);
         const char* kind_name = (n->kind < sizeof(kind_names)/sizeof(kind_names[0])) ?
                                kind_names[n->kind] : "INVALID";
         
         fprintf(stderr,
             "  [%zu] %p: kind=%s size=%zu refcount=%u marked=%d\n",
-            shown + 1, n->object, kind_name, n->size,
-            hdr ? hdr->refcount : 0, n->marked);
+            shown + 1, (void*)hdr, kind_name, n->size,
+            hdr->refcount, n->marked);
         
         if (++shown >= BREAD_LEAK_REPORT_LIMIT) {
             fprintf(stderr, "  ... (%zu more objects not shown)\n",
@@ -687,6 +1911,7 @@ void bread_memory_set_cycle_collection_threshold(int threshold) {
     bread_memory_ensure_init();
     
     if (threshold <= 0) {
+        bread_memory_drop_cycle_roots();
         g_mem.cycle_collection_enabled = 0;
         g_mem.gc_threshold = 0;
         return;
@@ -711,9 +1936,59 @@ void bread_memory_set_bytes_threshold(size_t bytes) {
     g_mem.bytes_threshold = bytes;
 }
 
+void bread_memory_set_incremental_gc(size_t budget_us, size_t budget_objects) {
+    bread_memory_ensure_init();
+    g_mem.gc_slice_budget_us = budget_us;
+    g_mem.gc_slice_budget_objects = budget_objects;
+}
+
+void bread_memory_set_gc_threads(int threads) {
+    bread_memory_ensure_init();
+    g_mem.gc_threads = bread_memory_clamp_gc_threads(threads);
+}
+
+void bread_memory_set_heap_limit(size_t bytes) {
+    bread_memory_ensure_init();
+    g_mem.heap_limit = bytes;
+}
+
+size_t bread_memory_get_heap_limit(void) {
+    bread_memory_ensure_init();
+    return g_mem.heap_limit;
+}
+
+void bread_memory_set_pool_retention(size_t bytes) {
+    bread_memory_ensure_init();
+    g_mem.pool_retain_bytes = bytes;
+    bread_pool_trim();
+}
+
+// Parses sizes such as "4096", "512K", "64M" or "2G".
+int bread_memory_parse_size(const char* text, size_t* out_bytes) {
+    if (!text || !out_bytes || !isdigit((unsigned char)*text)) return 0;
+    
+    char* end = NULL;
+    unsigned long long value = strtoull(text, &end, 10);
+    unsigned long long scale = 1;
+    
+    switch (toupper((unsigned char)*end)) {
+        case '\0': break;
+        case 'K': scale = 1024ULL; end++; break;
+        case 'M': scale = 1024ULL * 1024; end++; break;
+        case 'G': scale = 1024ULL * 1024 * 1024; end++; break;
+        default: return 0;
+    }
+    if (*end == 'B' || *end == 'b') end++;
+    if (*end != '\0' || value > SIZE_MAX / scale) return 0;
+    
+    *out_bytes = (size_t)(value * scale);
+    return 1;
+}
+
 void bread_memory_cleanup_all(void) {
-    bread_memory_cleanup();
+    // the intern table holds references into the heap
     bread_string_intern_cleanup();
+    bread_memory_cleanup();
 }
 
 void bread_memory_cleanup_on_error(void) {
@@ -0,0 +1,345 @@
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "runtime/number_format.h"
+
+static const char bread_digit_pairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const uint64_t bread_pow10_u64[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL,
+};
+
+static size_t bread_u64_digits(uint64_t v) {
+    size_t n = 1;
+    for (;;) {
+        if (v < 10) return n;
+        if (v < 100) return n + 1;
+        if (v < 1000) return n + 2;
+        if (v < 10000) return n + 3;
+        v /= 10000;
+        n += 4;
+    }
+}
+
+// Writes v backwards so that its last digit lands just before `end`
+static void bread_u64_write(char* end, uint64_t v) {
+    while (v >= 100) {
+        unsigned i = (unsigned)(v % 100) * 2;
+        v /= 100;
+        *--end = bread_digit_pairs[i + 1];
+        *--end = bread_digit_pairs[i];
+    }
+    if (v >= 10) {
+        unsigned i = (unsigned)v * 2;
+        *--end = bread_digit_pairs[i + 1];
+        *--end = bread_digit_pairs[i];
+    } else {
+        *--end = (char)('0' + v);
+    }
+}
+
+size_t bread_format_int_length(int64_t value) {
+    uint64_t mag = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    return bread_u64_digits(mag) + (value < 0);
+}
+
+size_t bread_format_int(char* buf, int64_t value) {
+    uint64_t mag = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    size_t len = bread_u64_digits(mag) + (value < 0);
+    bread_u64_write(buf + len, mag);
+    if (value < 0) buf[0] = '-';
+    buf[len] = '\0';
+    return len;
+}
+
+// Grisu2 (Loitsch, "Printing Floating-Point Numbers Quickly and Accurately
+// with Integers"): scale the value and its rounding boundaries by a cached
+// power of ten so the digits fall out of 64-bit integer arithmetic.
+
+typedef struct {
+    uint64_t f;
+    int e;
+} BreadDiyFp;
+
+#define BREAD_DP_SIGNIFICAND_MASK 0x000FFFFFFFFFFFFFULL
+#define BREAD_DP_HIDDEN_BIT 0x0010000000000000ULL
+
+// 10^k for k = -348, -340, ..., 340, normalized
+static const BreadDiyFp bread_cached_powers[87] = {
+    {0xfa8fd5a0081c0288ULL, -1220}, {0xbaaee17fa23ebf76ULL, -1193}, {0x8b16fb203055ac76ULL, -1166},
+    {0xcf42894a5dce35eaULL, -1140}, {0x9a6bb0aa55653b2dULL, -1113}, {0xe61acf033d1a45dfULL, -1087},
+    {0xab70fe17c79ac6caULL, -1060}, {0xff77b1fcbebcdc4fULL, -1034}, {0xbe5691ef416bd60cULL, -1007},
+    {0x8dd01fad907ffc3cULL, -980}, {0xd3515c2831559a83ULL, -954}, {0x9d71ac8fada6c9b5ULL, -927},
+    {0xea9c227723ee8bcbULL, -901}, {0xaecc49914078536dULL, -874}, {0x823c12795db6ce57ULL, -847},
+    {0xc21094364dfb5637ULL, -821}, {0x9096ea6f3848984fULL, -794}, {0xd77485cb25823ac7ULL, -768},
+    {0xa086cfcd97bf97f4ULL, -741}, {0xef340a98172aace5ULL, -715}, {0xb23867fb2a35b28eULL, -688},
+    {0x84c8d4dfd2c63f3bULL, -661}, {0xc5dd44271ad3cdbaULL, -635}, {0x936b9fcebb25c996ULL, -608},
+    {0xdbac6c247d62a584ULL, -582}, {0xa3ab66580d5fdaf6ULL, -555}, {0xf3e2f893dec3f126ULL, -529},
+    {0xb5b5ada8aaff80b8ULL, -502}, {0x87625f056c7c4a8bULL, -475}, {0xc9bcff6034c13053ULL, -449},
+    {0x964e858c91ba2655ULL, -422}, {0xdff9772470297ebdULL, -396}, {0xa6dfbd9fb8e5b88fULL, -369},
+    {0xf8a95fcf88747d94ULL, -343}, {0xb94470938fa89bcfULL, -316}, {0x8a08f0f8bf0f156bULL, -289},
+    {0xcdb02555653131b6ULL, -263}, {0x993fe2c6d07b7facULL, -236}, {0xe45c10c42a2b3b06ULL, -210},
+    {0xaa242499697392d3ULL, -183}, {0xfd87b5f28300ca0eULL, -157}, {0xbce5086492111aebULL, -130},
+    {0x8cbccc096f5088ccULL, -103}, {0xd1b71758e219652cULL, -77}, {0x9c40000000000000ULL, -50},
+    {0xe8d4a51000000000ULL, -24}, {0xad78ebc5ac620000ULL, 3}, {0x813f3978f8940984ULL, 30},
+    {0xc097ce7bc90715b3ULL, 56}, {0x8f7e32ce7bea5c70ULL, 83}, {0xd5d238a4abe98068ULL, 109},
+    {0x9f4f2726179a2245ULL, 136}, {0xed63a231d4c4fb27ULL, 162}, {0xb0de65388cc8ada8ULL, 189},
+    {0x83c7088e1aab65dbULL, 216}, {0xc45d1df942711d9aULL, 242}, {0x924d692ca61be758ULL, 269},
+    {0xda01ee641a708deaULL, 295}, {0xa26da3999aef774aULL, 322}, {0xf209787bb47d6b85ULL, 348},
+    {0xb454e4a179dd1877ULL, 375}, {0x865b86925b9bc5c2ULL, 402}, {0xc83553c5c8965d3dULL, 428},
+    {0x952ab45cfa97a0b3ULL, 455}, {0xde469fbd99a05fe3ULL, 481}, {0xa59bc234db398c25ULL, 508},
+    {0xf6c69a72a3989f5cULL, 534}, {0xb7dcbf5354e9beceULL, 561}, {0x88fcf317f22241e2ULL, 588},
+    {0xcc20ce9bd35c78a5ULL, 614}, {0x98165af37b2153dfULL, 641}, {0xe2a0b5dc971f303aULL, 667},
+    {0xa8d9d1535ce3b396ULL, 694}, {0xfb9b7cd9a4a7443cULL, 720}, {0xbb764c4ca7a44410ULL, 747},
+    {0x8bab8eefb6409c1aULL, 774}, {0xd01fef10a657842cULL, 800}, {0x9b10a4e5e9913129ULL, 827},
+    {0xe7109bfba19c0c9dULL, 853}, {0xac2820d9623bf429ULL, 880}, {0x80444b5e7aa7cf85ULL, 907},
+    {0xbf21e44003acdd2dULL, 933}, {0x8e679c2f5e44ff8fULL, 960}, {0xd433179d9c8cb841ULL, 986},
+    {0x9e19db92b4e31ba9ULL, 1013}, {0xeb96bf6ebadf77d9ULL, 1039}, {0xaf87023b9bf0ee6bULL, 1066},
+};
+
+static inline BreadDiyFp bread_diy_mul(BreadDiyFp a, BreadDiyFp b) {
+    unsigned __int128 p = (unsigned __int128)a.f * b.f;
+    uint64_t hi = (uint64_t)(p >> 64);
+    if ((uint64_t)p & (1ULL << 63)) hi++; // round
+    return (BreadDiyFp){hi, a.e + b.e + 64};
+}
+
+static inline BreadDiyFp bread_diy_normalize(BreadDiyFp v) {
+    int shift = __builtin_clzll(v.f);
+    v.f <<= shift;
+    v.e -= shift;
+    return v;
+}
+
+// Moves the last digit towards w while the result stays inside the interval
+static void bread_grisu_round(char* buf, int len, uint64_t delta, uint64_t rest, uint64_t ten_kappa,
+                              uint64_t wp_w) {
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+        buf[len - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+static int bread_grisu_digits(BreadDiyFp w, BreadDiyFp mp, uint64_t delta, char* buf, int* k) {
+    const BreadDiyFp one = {1ULL << -mp.e, mp.e};
+    const uint64_t wp_w = mp.f - w.f;
+    uint32_t p1 = (uint32_t)(mp.f >> -one.e);
+    uint64_t p2 = mp.f & (one.f - 1);
+    int kappa = (int)bread_u64_digits(p1);
+    int len = 0;
+
+    while (kappa > 0) {
+        uint32_t d;
+        // constant divisors compile to multiplications
+        switch (kappa) {
+            case 10: d = p1 / 1000000000; p1 %= 1000000000; break;
+            case 9: d = p1 / 100000000; p1 %= 100000000; break;
+            case 8: d = p1 / 10000000; p1 %= 10000000; break;
+            case 7: d = p1 / 1000000; p1 %= 1000000; break;
+            case 6: d = p1 / 100000; p1 %= 100000; break;
+            case 5: d = p1 / 10000; p1 %= 10000; break;
+            case 4: d = p1 / 1000; p1 %= 1000; break;
+            case 3: d = p1 / 100; p1 %= 100; break;
+            case 2: d = p1 / 10; p1 %= 10; break;
+            case 1: d = p1; p1 = 0; break;
+            default: d = 0;
+        }
+        if (d || len) buf[len++] = (char)('0' + d);
+        kappa--;
+        uint64_t rest = ((uint64_t)p1 << -one.e) + p2;
+        if (rest <= delta) {
+            *k += kappa;
+            bread_grisu_round(buf, len, delta, rest, bread_pow10_u64[kappa] << -one.e, wp_w);
+            return len;
+        }
+    }
+
+    for (;;) {
+        p2 *= 10;
+        delta *= 10;
+        char d = (char)(p2 >> -one.e);
+        if (d || len) buf[len++] = (char)('0' + d);
+        p2 &= one.f - 1;
+        kappa--;
+        if (p2 < delta) {
+            *k += kappa;
+            int index = -kappa;
+            bread_grisu_round(buf, len, delta, p2, one.f, wp_w * (index < 20 ? bread_pow10_u64[index] : 0));
+            return len;
+        }
+    }
+}
+
+// Shortest digits (usually; always round-tripping) for a positive finite
+// value: value == digits * 10^*k. Returns the digit count.
+static int bread_grisu2(double value, char* buf, int* k) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    int biased = (int)((bits >> 52) & 0x7FF);
+    uint64_t significand = bits & BREAD_DP_SIGNIFICAND_MASK;
+    BreadDiyFp v = biased ? (BreadDiyFp){significand | BREAD_DP_HIDDEN_BIT, biased - 1075}
+                          : (BreadDiyFp){significand, -1074};
+
+    BreadDiyFp plus = bread_diy_normalize((BreadDiyFp){(v.f << 1) + 1, v.e - 1});
+    BreadDiyFp minus = (v.f == BREAD_DP_HIDDEN_BIT) ? (BreadDiyFp){(v.f << 2) - 1, v.e - 2}
+                                                    : (BreadDiyFp){(v.f << 1) - 1, v.e - 1};
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    double dk = (-61 - plus.e) * 0.30102999566398114 + 347;
+    int kk = (int)dk;
+    if (dk - kk > 0.0) kk++;
+    unsigned index = (unsigned)((kk >> 3) + 1);
+    *k = -(-348 + (int)(index << 3));
+    BreadDiyFp c = bread_cached_powers[index];
+
+    BreadDiyFp w = bread_diy_mul(bread_diy_normalize(v), c);
+    BreadDiyFp wp = bread_diy_mul(plus, c);
+    BreadDiyFp wm = bread_diy_mul(minus, c);
+    wm.f++;
+    wp.f--;
+    return bread_grisu_digits(w, wp, wp.f - wm.f, buf, k);
+}
+
+static const double bread_pow10_double[20] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,
+    1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+};
+
+// Rounds the n digits in d to at most `keep` significant digits, dropping
+// trailing zeros; *x is the decimal exponent of the first digit. The digits
+// are within half an ulp of the exact value, which is under 2^-53 * 10^keep
+// units of the last kept digit, so with keep <= 15 they round the same way
+// the exact value does unless they sit that close to a halfway point. That
+// case returns -1 and the caller asks snprintf instead.
+static int bread_round_digits(char* d, int n, int keep, int* x) {
+    if (keep <= 0 || keep > 15) return -1;
+    if (n > keep) {
+        uint64_t rest = 0;
+        for (int i = keep; i < n; i++) rest = rest * 10 + (uint64_t)(d[i] - '0');
+        double tail = (double)rest / bread_pow10_double[n - keep];
+        if (fabs(tail - 0.5) <= 2.3e-16 * bread_pow10_double[keep]) return -1;
+
+        n = keep;
+        if (tail > 0.5) {
+            int i = n - 1;
+            while (i >= 0 && d[i] == '9') i--;
+            if (i < 0) {
+                d[0] = '1';
+                n = 1;
+                (*x)++;
+            } else {
+                d[i]++;
+                n = i + 1;
+            }
+        }
+    }
+    while (n > 1 && d[n - 1] == '0') n--;
+    return n;
+}
+
+// Digits of |value| for a finite, normal, non-zero value
+static int bread_decimal_digits(double value, char* d, int* x) {
+    int k;
+    int n = bread_grisu2(fabs(value), d, &k);
+    *x = n + k - 1;
+    return n;
+}
+
+size_t bread_format_double(char* buf, double value, int precision) {
+    if (precision == 0) precision = 1;
+    if (!isfinite(value) || precision < 0 || precision > 15 || (value != 0.0 && fabs(value) < DBL_MIN)) {
+        return (size_t)snprintf(buf, BREAD_FORMAT_MAX, "%.*g", precision, value);
+    }
+
+    char* p = buf;
+    if (signbit(value)) *p++ = '-';
+    if (value == 0.0) {
+        *p++ = '0';
+        *p = '\0';
+        return (size_t)(p - buf);
+    }
+
+    char d[32];
+    int x;
+    int n = bread_decimal_digits(value, d, &x);
+    n = bread_round_digits(d, n, precision, &x);
+    if (n < 0) return (size_t)snprintf(buf, BREAD_FORMAT_MAX, "%.*g", precision, value);
+
+    if (x < -4 || x >= precision) {
+        *p++ = d[0];
+        if (n > 1) {
+            *p++ = '.';
+            memcpy(p, d + 1, (size_t)(n - 1));
+            p += n - 1;
+        }
+        *p++ = 'e';
+        *p++ = x < 0 ? '-' : '+';
+        int ex = abs(x);
+        if (ex >= 100) {
+            *p++ = (char)('0' + ex / 100);
+            ex %= 100;
+        }
+        *p++ = bread_digit_pairs[ex * 2];
+        *p++ = bread_digit_pairs[ex * 2 + 1];
+    } else if (x >= 0) {
+        for (int i = 0; i <= x; i++) *p++ = i < n ? d[i] : '0';
+        if (n > x + 1) {
+            *p++ = '.';
+            memcpy(p, d + x + 1, (size_t)(n - x - 1));
+            p += n - x - 1;
+        }
+    } else {
+        *p++ = '0';
+        *p++ = '.';
+        for (int i = 0; i < -x - 1; i++) *p++ = '0';
+        memcpy(p, d, (size_t)n);
+        p += n;
+    }
+    *p = '\0';
+    return (size_t)(p - buf);
+}
+
+size_t bread_format_double_fixed(char* buf, double value, int decimals) {
+    if (!isfinite(value) || decimals < 0 || decimals > 15 || (value != 0.0 && fabs(value) < DBL_MIN)) {
+        return (size_t)snprintf(buf, BREAD_FORMAT_MAX, "%.*f", decimals, value);
+    }
+
+    char d[32];
+    int x = 0;
+    int n = 0;
+    if (value != 0.0) {
+        n = bread_decimal_digits(value, d, &x);
+        n = bread_round_digits(d, n, x + 1 + decimals, &x);
+        if (n < 0) return (size_t)snprintf(buf, BREAD_FORMAT_MAX, "%.*f", decimals, value);
+    }
+
+    char* p = buf;
+    if (signbit(value)) *p++ = '-';
+    if (n == 0 || x < 0) {
+        *p++ = '0';
+    } else {
+        for (int i = 0; i <= x; i++) *p++ = i < n ? d[i] : '0';
+    }
+    if (decimals > 0) {
+        *p++ = '.';
+        for (int j = 1; j <= decimals; j++) {
+            int i = x + j; // index of the 10^-j digit
+            *p++ = (n > 0 && i >= 0 && i < n) ? d[i] : '0';
+        }
+    }
+    *p = '\0';
+    return (size_t)(p - buf);
+}
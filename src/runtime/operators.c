@@ -1,10 +1,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <limits.h>
 
 #include "runtime/runtime.h"
 #include "runtime/error.h"
 #include "core/value.h"
+#include "runtime/string_search.h"
 
 static int unwrap_optional(const BreadValue* value, BreadValue* unwrapped, int* owned) {
     if (!value || !unwrapped || !owned) return 0;
@@ -75,9 +77,9 @@ int bread_index_op(const BreadValue* target, const BreadValue* idx, BreadValue*
                 break;
             }
             
-            char ch = bread_string_get_char(real_target.value.string_val, (size_t)index);
-            char ch_str[2] = {ch, '\0'};
-            bread_value_set_string(out, ch_str);
+            // one-byte strings are static, so this never allocates
+            out->type = TYPE_STRING;
+            out->value.string_val = bread_string_slice(real_target.value.string_val, (size_t)index, (size_t)index + 1);
             result = 1;
             break;
         }
@@ -104,13 +106,8 @@ int bread_index_op(const BreadValue* target, const BreadValue* idx, BreadValue*
                 break;
             }
             
-            BreadValue* at = bread_array_get(real_target.value.array_val, index);
-            if (at) {
-                *out = bread_value_clone(*at);
-                result = 1;
-            } else {
-                BREAD_ERROR_SET_RUNTIME("Failed to retrieve array element");
-            }
+            *out = bread_value_clone(bread_array_at(real_target.value.array_val, index));
+            result = 1;
             break;
         }
 
@@ -121,7 +118,7 @@ int bread_index_op(const BreadValue* target, const BreadValue* idx, BreadValue*
             }
             
             const char* key = bread_string_cstr(idx->value.string_val);
-            BreadValue* v = bread_dict_get(real_target.value.dict_val, key);
+            BreadValue* v = bread_dict_get_string(real_target.value.dict_val, idx->value.string_val);
             
             if (v) {
                 *out = bread_value_clone(*v);
@@ -354,7 +351,7 @@ int bread_member_set_op(BreadValue* target, const char* member, const BreadValue
 
 // Helper for toString conversion
 static int convert_to_string(const BreadValue* value, BreadValue* out) {
-    char buf[256];
+    BreadString* s;
     
     switch (value->type) {
         case TYPE_STRING:
@@ -362,30 +359,148 @@ static int convert_to_string(const BreadValue* value, BreadValue* out) {
             return 1;
             
         case TYPE_INT:
-            snprintf(buf, sizeof(buf), "%lld", value->value.int_val);
+            s = bread_string_from_int(value->value.int_val);
             break;
             
         case TYPE_BOOL:
-            snprintf(buf, sizeof(buf), "%s", value->value.bool_val ? "true" : "false");
-            break;
+            bread_value_set_string(out, value->value.bool_val ? "true" : "false");
+            return 1;
             
         case TYPE_FLOAT:
-            snprintf(buf, sizeof(buf), "%g", value->value.float_val);
+            s = bread_string_from_double(value->value.float_val, 6);
             break;
             
         case TYPE_DOUBLE:
-            snprintf(buf, sizeof(buf), "%g", value->value.double_val);
+            s = bread_string_from_double(value->value.double_val, 6);
             break;
             
         case TYPE_NIL:
-            snprintf(buf, sizeof(buf), "nil");
-            break;
+            bread_value_set_string(out, "nil");
+            return 1;
             
         default:
             return 0;
     }
     
-    bread_value_set_string(out, buf);
+    memset(out, 0, sizeof(*out));
+    if (!s) {
+        BREAD_ERROR_SET_MEMORY_ALLOCATION("Out of memory creating string");
+        out->type = TYPE_NIL;
+        return 1;
+    }
+    out->type = TYPE_STRING;
+    out->value.string_val = s;
+    return 1;
+}
+
+// Resolves a possibly negative position against `len`, clamping to [0, len]
+static size_t bread_string_position(int64_t pos, size_t len) {
+    if (pos < 0) pos += (int64_t)len;
+    if (pos < 0) return 0;
+    return (size_t)pos > len ? len : (size_t)pos;
+}
+
+static int bread_method_args(const char* name, int min, int max, VarType type, int argc, const BreadValue* args) {
+    if (argc < min || argc > max || (argc > 0 && !args)) {
+        char error_msg[128];
+        if (min == max) {
+            snprintf(error_msg, sizeof(error_msg), "%s() expects %d argument%s", name, min, min == 1 ? "" : "s");
+        } else {
+            snprintf(error_msg, sizeof(error_msg), "%s() expects %d to %d arguments", name, min, max);
+        }
+        BREAD_ERROR_SET_RUNTIME(error_msg);
+        return 0;
+    }
+    for (int i = 0; i < argc; i++) {
+        if (args[i].type != type) {
+            char error_msg[128];
+            snprintf(error_msg, sizeof(error_msg), "%s() arguments must be %s", name, type == TYPE_INT ? "Int" : "String");
+            BREAD_ERROR_SET_TYPE_MISMATCH(error_msg);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Searching methods; bread_bytes_find does the scanning
+static int bread_string_search_method(BreadString* s, const char* name, int argc, const BreadValue* args,
+                                      BreadValue* out) {
+    const char* data = bread_string_data(s);
+    size_t len = bread_string_len(s);
+
+    if (strcmp(name, "contains") == 0 || strcmp(name, "indexOf") == 0 || strcmp(name, "count") == 0 ||
+        strcmp(name, "startsWith") == 0) {
+        if (!bread_method_args(name, 1, 1, TYPE_STRING, argc, args)) return 0;
+        BreadString* sub = args[0].value.string_val;
+        const char* sub_data = bread_string_data(sub);
+        size_t sub_len = bread_string_len(sub);
+
+        if (name[0] == 'c' && name[1] == 'o' && name[2] == 'n') {
+            bread_value_set_bool(out, bread_bytes_find(data, len, sub_data, sub_len) >= 0);
+        } else if (name[0] == 'i') {
+            bread_value_set_int(out, bread_bytes_find(data, len, sub_data, sub_len));
+        } else if (name[0] == 'c') {
+            bread_value_set_int(out, (int64_t)bread_bytes_count(data, len, sub_data, sub_len));
+        } else {
+            bread_value_set_bool(out, sub_len <= len && memcmp(data, sub_data, sub_len) == 0);
+        }
+        return 1;
+    }
+
+    if (strcmp(name, "split") == 0) {
+        if (!bread_method_args(name, 1, 1, TYPE_STRING, argc, args)) return 0;
+        BreadArray* parts = bread_string_split(s, args[0].value.string_val);
+        if (!parts) return 0;
+        bread_value_set_array(out, parts);
+        bread_array_release(parts); // set_array took its own reference
+        return 1;
+    }
+
+    if (strcmp(name, "replace") == 0) {
+        if (!bread_method_args(name, 2, 2, TYPE_STRING, argc, args)) return 0;
+        BreadString* result = bread_string_replace(s, args[0].value.string_val, args[1].value.string_val);
+        if (!result) {
+            BREAD_ERROR_SET_MEMORY_ALLOCATION("Out of memory during string replace");
+            return 0;
+        }
+        out->type = TYPE_STRING;
+        out->value.string_val = result;
+        return 1;
+    }
+
+    return -1;
+}
+
+// String methods. Returns -1 when `name` is not one of them.
+// slice/prefix/suffix return views that share the receiver's bytes.
+static int bread_string_method(BreadString* s, const char* name, int argc, const BreadValue* args, BreadValue* out) {
+    size_t len = bread_string_len(s);
+    size_t start, end;
+
+    if (strcmp(name, "slice") == 0) {
+        if (!bread_method_args(name, 1, 2, TYPE_INT, argc, args)) return 0;
+        start = bread_string_position(args[0].value.int_val, len);
+        end = argc > 1 ? bread_string_position(args[1].value.int_val, len) : len;
+    } else if (strcmp(name, "prefix") == 0) {
+        if (!bread_method_args(name, 1, 1, TYPE_INT, argc, args)) return 0;
+        start = 0;
+        end = args[0].value.int_val < 0 ? 0 : bread_string_position(args[0].value.int_val, len);
+    } else if (strcmp(name, "suffix") == 0) {
+        if (!bread_method_args(name, 1, 1, TYPE_INT, argc, args)) return 0;
+        int64_t n = args[0].value.int_val;
+        start = n <= 0 ? len : ((size_t)n >= len ? 0 : len - (size_t)n);
+        end = len;
+    } else {
+        return bread_string_search_method(s, name, argc, args, out);
+    }
+
+    BreadString* result = bread_string_slice(s, start, end);
+    if (!result) {
+        BREAD_ERROR_SET_MEMORY_ALLOCATION("Out of memory during string slice");
+        return 0;
+    }
+    out->type = TYPE_STRING;
+    out->value.string_val = result;
     return 1;
 }
 
@@ -448,6 +563,100 @@ int bread_method_call_op(const BreadValue* target, const char* name, int argc,
         return result;
     }
 
+    if (real_target.type == TYPE_ARRAY && name &&
+        (strcmp(name, "toInts") == 0 || strcmp(name, "toDoubles") == 0)) {
+        if (argc != 0) {
+            char error_msg[64];
+            snprintf(error_msg, sizeof(error_msg), "%s() expects 0 arguments", name);
+            BREAD_ERROR_SET_RUNTIME(error_msg);
+        } else {
+            BreadArray* numbers = name[2] == 'I' ? bread_array_parse_ints(real_target.value.array_val)
+                                                 : bread_array_parse_doubles(real_target.value.array_val);
+            if (numbers) {
+                bread_value_set_array(out, numbers);
+                bread_array_release(numbers);
+                result = 1;
+            }
+        }
+        cleanup_if_owned(&real_target, target_owned);
+        return result;
+    }
+
+    if (real_target.type == TYPE_ARRAY && name &&
+        (strcmp(name, "insert") == 0 || strcmp(name, "removeAt") == 0)) {
+        BreadArray* array = real_target.value.array_val;
+        int argc_expected = name[0] == 'i' ? 2 : 1;
+        if (argc != argc_expected || !args) {
+            char error_msg[64];
+            snprintf(error_msg, sizeof(error_msg), "%s() expects %d argument%s", name, argc_expected,
+                     argc_expected == 1 ? "" : "s");
+            BREAD_ERROR_SET_RUNTIME(error_msg);
+        } else if (args[0].type != TYPE_INT) {
+            char error_msg[64];
+            snprintf(error_msg, sizeof(error_msg), "%s() index must be Int", name);
+            BREAD_ERROR_SET_TYPE_MISMATCH(error_msg);
+        } else if (args[0].value.int_val < INT_MIN || args[0].value.int_val > INT_MAX) {
+            BREAD_ERROR_SET_INDEX_OUT_OF_BOUNDS("Array index out of bounds");
+        } else if (name[0] == 'i') {
+            result = bread_array_insert(array, args[1], (int)args[0].value.int_val);
+        } else {
+            BreadValue removed = bread_array_remove_at(array, (int)args[0].value.int_val);
+            if (removed.type != TYPE_NIL) {
+                *out = removed;
+                result = 1;
+            }
+        }
+        cleanup_if_owned(&real_target, target_owned);
+        return result;
+    }
+
+    if (real_target.type == TYPE_ARRAY && name && strcmp(name, "slice") == 0) {
+        BreadArray* array = real_target.value.array_val;
+        if (bread_method_args(name, 1, 2, TYPE_INT, argc, args)) {
+            int64_t count = bread_array_length(array);
+            int64_t start = args[0].value.int_val, end = argc > 1 ? args[1].value.int_val : count;
+            // clamped here so bread_array_slice's int positions cannot overflow
+            start = start < -count ? -count : (start > count ? count : start);
+            end = end < -count ? -count : (end > count ? count : end);
+            BreadArray* slice = bread_array_slice(array, (int)start, (int)end);
+            if (slice) {
+                bread_value_set_array(out, slice);
+                bread_array_release(slice);
+                result = 1;
+            }
+        }
+        cleanup_if_owned(&real_target, target_owned);
+        return result;
+    }
+
+    if (real_target.type == TYPE_ARRAY && name &&
+        (strcmp(name, "contains") == 0 || strcmp(name, "indexOf") == 0)) {
+        if (argc != 1 || !args) {
+            char error_msg[64];
+            snprintf(error_msg, sizeof(error_msg), "%s() expects 1 argument", name);
+            BREAD_ERROR_SET_RUNTIME(error_msg);
+        } else {
+            int index = bread_array_index_of(real_target.value.array_val, args[0]);
+            if (name[0] == 'c') {
+                bread_value_set_bool(out, index >= 0);
+            } else {
+                bread_value_set_int(out, index);
+            }
+            result = 1;
+        }
+        cleanup_if_owned(&real_target, target_owned);
+        return result;
+    }
+
+    if (real_target.type == TYPE_STRING && name) {
+        result = bread_string_method(real_target.value.string_val, name, argc, args, out);
+        if (result >= 0) {
+            cleanup_if_owned(&real_target, target_owned);
+            return result;
+        }
+        result = 0;
+    }
+
     // Class methods
     if (real_target.type == TYPE_CLASS) {
         BreadClass* class_instance = real_target.value.class_val;
@@ -490,7 +699,7 @@ int bread_dict_set_value(struct BreadDict* d, const BreadValue* key, const Bread
         return 0;
     }
     
-    return bread_dict_set((BreadDict*)d, bread_string_cstr(key->value.string_val), *val);
+    return bread_dict_set_string((BreadDict*)d, key->value.string_val, *val);
 }
 
 int bread_array_append_value(struct BreadArray* a, const BreadValue* v) {
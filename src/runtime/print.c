@@ -104,7 +104,7 @@ void execute_print(char* line) {
             int n = a ? a->count : 0;
             for (int i = 0; i < n; i++) {
                 if (i > 0) printf(", ");
-                BreadValue item = bread_value_clone(a->items[i]);
+                BreadValue item = bread_value_clone(bread_array_at(a, i));
                 ExprResult inner = bread_expr_result_from_value(item);
                 switch (inner.type) {
                     case TYPE_STRING:
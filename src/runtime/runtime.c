@@ -6,6 +6,7 @@
 #include "runtime/runtime.h"
 #include "runtime/memory.h"
 #include "runtime/error.h"
+#include "runtime/number_format.h"
 #include "core/value.h"
 #include "core/var.h"
 #include "compiler/parser/expr.h"
@@ -125,6 +126,41 @@ int bread_var_assign(const char* name, const BreadValue* value) {
     return bread_assign_variable_from_expr_result(name_buf, &r);
 }
 
+// `name = name + parts...` for a global. A String variable holding the
+// only reference to its value is extended in place.
+int bread_var_append(const char* name, BreadValue** parts, int32_t count) {
+    if (!name || !parts || count < 1) return 0;
+
+    Variable* var = get_variable(name);
+    if (!var) {
+        char error_msg[512];
+        snprintf(error_msg, sizeof(error_msg), "Unknown variable '%s'", name);
+        BREAD_ERROR_SET_UNDEFINED_VARIABLE(error_msg);
+        return 0;
+    }
+    if (var->is_const) {
+        BREAD_ERROR_SET_RUNTIME("Cannot assign to constant variable");
+        return 0;
+    }
+
+    if (var->type == TYPE_STRING && var->value.string_val) {
+        BreadValue slot;
+        memset(&slot, 0, sizeof(slot));
+        slot.type = TYPE_STRING;
+        slot.value.string_val = var->value.string_val;
+        int ok = bread_append_op(&slot, parts, count);
+        var->value.string_val = slot.value.string_val;
+        return ok;
+    }
+
+    BreadValue current;
+    if (!bread_var_load(name, &current)) return 0;
+    int ok = bread_append_op(&current, parts, count);
+    if (ok) ok = bread_var_assign(name, &current);
+    bread_value_release(&current);
+    return ok;
+}
+
 static int coerce_and_assign(Variable* var, VarType src_type, VarValue src) {
     if (!var) return 0;
     if (var->type == TYPE_STRING && var->value.string_val) {
@@ -198,31 +234,31 @@ static int coerce_and_assign(Variable* var, VarType src_type, VarValue src) {
             break;
 
         case TYPE_STRING: {
-            char buf[64];
+            char buf[BREAD_FORMAT_MAX];
+            size_t len;
 
             switch (src_type) {
                 case TYPE_STRING:
                     if (src.string_val) {
-                        dst.string_val = src.string_val;
-                        bread_string_retain(dst.string_val);
+                        dst.string_val = bread_string_promote(src.string_val);
                     } else {
                         dst.string_val = bread_string_new("");
                     }
                     break;
 
                 case TYPE_INT:
-                    snprintf(buf, sizeof(buf), "%lld", (long long)src.int_val);
-                    dst.string_val = bread_string_new(buf);
+                    len = bread_format_int(buf, src.int_val);
+                    dst.string_val = bread_string_new_len(buf, len);
                     break;
 
                 case TYPE_FLOAT:
-                    snprintf(buf, sizeof(buf), "%f", src.float_val);
-                    dst.string_val = bread_string_new(buf);
+                    len = bread_format_double_fixed(buf, src.float_val, 6);
+                    dst.string_val = bread_string_new_len(buf, len);
                     break;
 
                 case TYPE_DOUBLE:
-                    snprintf(buf, sizeof(buf), "%lf", src.double_val);
-                    dst.string_val = bread_string_new(buf);
+                    len = bread_format_double_fixed(buf, src.double_val, 6);
+                    dst.string_val = bread_string_new_len(buf, len);
                     break;
 
                 case TYPE_BOOL:
@@ -1,52 +1,262 @@
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <stdio.h>
 
 #include "runtime/runtime.h"
 #include "runtime/memory.h"
 #include "runtime/error.h"
+#include "runtime/number_format.h"
+#include "runtime/string_search.h"
 #include "core/value.h"
 
-#define INTERN_TABLE_SIZE 256
-static BreadString* intern_table[INTERN_TABLE_SIZE];
+#define INTERN_TABLE_INITIAL_CAPACITY 256
+
+// Open-addressed with linear probing. The full hash is kept alongside each
+// string so probes and rehashes only touch string data on a likely match.
+typedef struct {
+    uint64_t hash;
+    BreadString* string; // NULL for an empty slot
+} InternEntry;
+
+static InternEntry* intern_table = NULL;
+static size_t intern_capacity = 0;
+static size_t intern_count = 0;
+static size_t intern_lookups = 0;
+static size_t intern_hits = 0;
 static int intern_initialized = 0;
 
-static BreadString* bread_string_alloc(size_t len) {
+static BreadString* bread_string_alloc_in(size_t len, int young) {
     size_t total = sizeof(BreadString) + len + 1;
-    BreadString* s = (BreadString*)bread_memory_alloc(total, BREAD_OBJ_STRING);
+    BreadString* s = young ? (BreadString*)bread_memory_alloc_young(total, BREAD_OBJ_STRING)
+                           : (BreadString*)bread_memory_alloc(total, BREAD_OBJ_STRING);
     if (!s) return NULL;
     s->len = len;
+    s->hash = 0;
     s->flags = (len <= BREAD_STRING_SMALL_MAX) ? BREAD_STRING_SMALL : 0;
     s->data[len] = '\0';
     return s;
 }
 
-static unsigned int bread_string_hash(const char* str, size_t len) {
-    unsigned int hash = 5381;
-    for (size_t i = 0; i < len; i++) {
-        hash = ((hash << 5) + hash) + (unsigned char)str[i];
+static inline BreadString* bread_string_alloc(size_t len) {
+    return bread_string_alloc_in(len, 0);
+}
+
+// The empty string and every one-byte string are preallocated and immortal,
+// so indexing a string or building single-character keys never allocates.
+typedef struct {
+    BreadObjHeader header;
+    size_t len;
+    uint64_t hash;
+    uint32_t flags;
+    char data[2];
+} BreadShortString;
+
+_Static_assert(offsetof(BreadShortString, data) == offsetof(BreadString, data),
+               "BreadShortString must match the BreadString layout");
+
+static BreadShortString short_strings[257]; // by byte value, then ""
+static int short_strings_ready = 0;
+
+static void bread_string_init_short(void) {
+    for (int i = 0; i < 257; i++) {
+        BreadShortString* s = &short_strings[i];
+        s->header.kind = BREAD_OBJ_STRING;
+        s->header.refcount = BREAD_REFCOUNT_IMMORTAL;
+        s->len = i < 256 ? 1 : 0;
+        s->flags = BREAD_STRING_SMALL;
+        s->data[0] = (char)(i < 256 ? i : 0);
+        s->data[1] = '\0';
+    }
+    short_strings_ready = 1;
+}
+
+static inline BreadString* bread_string_short(const char* data, size_t len) {
+    if (!short_strings_ready) bread_string_init_short();
+    return (BreadString*)&short_strings[len ? (unsigned char)data[0] : 256];
+}
+
+// A slice that shares its parent's bytes instead of copying them. The
+// parent is always a flat string and is kept alive by the view. The bytes
+// are not NUL-terminated, so bread_string_cstr makes a flat copy the first
+// time it is asked and caches it. Code that only needs the bytes should
+// use bread_string_data.
+typedef struct {
+    BreadObjHeader header;
+    size_t len;
+    uint64_t hash;
+    uint32_t flags;
+    BreadString* parent;
+    const char* bytes; // into parent->data
+    BreadString* flat; // owned, NULL until bread_string_cstr
+} BreadStringView;
+
+_Static_assert(offsetof(BreadStringView, flags) == offsetof(BreadString, flags),
+               "BreadStringView must match the BreadString header");
+
+static inline int bread_string_is_view(const BreadString* s) {
+    return s && (s->flags & BREAD_STRING_VIEW);
+}
+
+static void bread_string_view_drop(BreadStringView* v) {
+    bread_string_release(v->parent);
+    if (v->flat) bread_string_release(v->flat);
+    v->parent = NULL;
+    v->flat = NULL;
+}
+
+static BreadString* bread_string_view_new(BreadString* parent, const char* bytes, size_t len, int young) {
+    BreadStringView* v = young ? bread_memory_alloc_young(sizeof(BreadStringView), BREAD_OBJ_STRING)
+                               : bread_memory_alloc(sizeof(BreadStringView), BREAD_OBJ_STRING);
+    if (!v) return NULL;
+    v->len = len;
+    v->hash = 0;
+    v->flags = BREAD_STRING_VIEW;
+    v->parent = parent;
+    v->bytes = bytes;
+    v->flat = NULL;
+    bread_string_retain(parent);
+    if (bread_memory_is_young(v) && !bread_memory_nursery_finalize(v)) {
+        bread_string_release(parent);
+        BREAD_ERROR_SET_MEMORY_ALLOCATION("Out of memory creating string slice");
+        return NULL;
     }
-    return hash % INTERN_TABLE_SIZE;
+    return (BreadString*)v;
+}
+
+void bread_string_finalize_young(BreadString* s) {
+    if (bread_string_is_view(s)) bread_string_view_drop((BreadStringView*)s);
+}
+
+// wyhash (final version 4, Wang Yi), reading 8 bytes at a time
+static const uint64_t bread_hash_secret[4] = {
+    0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+};
+
+static inline uint64_t bread_hash_mix(uint64_t a, uint64_t b) {
+    __uint128_t r = (__uint128_t)a * b;
+    return (uint64_t)r ^ (uint64_t)(r >> 64);
+}
+
+static inline uint64_t bread_hash_read8(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static inline uint64_t bread_hash_read4(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+uint64_t bread_hash_bytes(const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    const uint64_t* secret = bread_hash_secret;
+    uint64_t seed = bread_hash_mix(secret[0], secret[1]);
+    uint64_t a, b;
+
+    if (len <= 16) {
+        if (len >= 4) {
+            size_t mid = (len >> 3) << 2;
+            a = (bread_hash_read4(p) << 32) | bread_hash_read4(p + mid);
+            b = (bread_hash_read4(p + len - 4) << 32) | bread_hash_read4(p + len - 4 - mid);
+        } else if (len > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = bread_hash_mix(bread_hash_read8(p) ^ secret[1], bread_hash_read8(p + 8) ^ seed);
+                see1 = bread_hash_mix(bread_hash_read8(p + 16) ^ secret[2], bread_hash_read8(p + 24) ^ see1);
+                see2 = bread_hash_mix(bread_hash_read8(p + 32) ^ secret[3], bread_hash_read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = bread_hash_mix(bread_hash_read8(p) ^ secret[1], bread_hash_read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = bread_hash_read8(p + i - 16);
+        b = bread_hash_read8(p + i - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    __uint128_t r = (__uint128_t)a * b;
+    a = (uint64_t)r;
+    b = (uint64_t)(r >> 64);
+    uint64_t h = bread_hash_mix(a ^ secret[0] ^ len, b ^ secret[1]);
+    return h ? h : 1; // 0 marks an uncached hash
+}
+
+// Strings are immutable once built, so the hash is computed at most once.
+uint64_t bread_string_hash(const BreadString* s) {
+    if (!s) return bread_hash_bytes("", 0);
+    if (!s->hash) ((BreadString*)s)->hash = bread_hash_bytes(bread_string_data(s), s->len);
+    return s->hash;
 }
 
 void bread_string_intern_init(void) {
     if (intern_initialized) return;
-    memset(intern_table, 0, sizeof(intern_table));
+    intern_table = calloc(INTERN_TABLE_INITIAL_CAPACITY, sizeof(InternEntry));
+    if (!intern_table) return;
+    intern_capacity = INTERN_TABLE_INITIAL_CAPACITY;
+    intern_count = 0;
+    intern_lookups = 0;
+    intern_hits = 0;
     intern_initialized = 1;
 }
 
 void bread_string_intern_cleanup(void) {
     if (!intern_initialized) return;
-    for (int i = 0; i < INTERN_TABLE_SIZE; i++) {
-        if (intern_table[i]) {
-            bread_string_release(intern_table[i]);
-            intern_table[i] = NULL;
-        }
+    for (size_t i = 0; i < intern_capacity; i++) {
+        BreadString* s = intern_table[i].string;
+        if (!s) continue;
+        // survivors are no longer unique once the table is gone
+        if (s->header.refcount > 1) s->flags &= ~BREAD_STRING_INTERNED;
+        bread_string_release(s);
     }
+    free(intern_table);
+    intern_table = NULL;
+    intern_capacity = 0;
+    intern_count = 0;
     intern_initialized = 0;
 }
 
+void bread_string_intern_stats(size_t* count, size_t* lookups, size_t* hits) {
+    if (count) *count = intern_count;
+    if (lookups) *lookups = intern_lookups;
+    if (hits) *hits = intern_hits;
+}
+
+static int bread_string_intern_grow(void) {
+    size_t capacity = intern_capacity * 2;
+    InternEntry* table = calloc(capacity, sizeof(InternEntry));
+    if (!table) return 0;
+
+    for (size_t i = 0; i < intern_capacity; i++) {
+        if (!intern_table[i].string) continue;
+        size_t slot = intern_table[i].hash & (capacity - 1);
+        while (table[slot].string) slot = (slot + 1) & (capacity - 1);
+        table[slot] = intern_table[i];
+    }
+    free(intern_table);
+    intern_table = table;
+    intern_capacity = capacity;
+    return 1;
+}
+
 BreadString* bread_string_new_len(const char* data, size_t len) {
+    if (len == 0 || (len == 1 && data)) return bread_string_short(data, len);
     BreadString* s = bread_string_alloc(len);
     if (!s) return NULL;
     if (len > 0 && data) {
@@ -61,43 +271,97 @@ BreadString* bread_string_new(const char* cstr) {
     return bread_string_new_len(cstr, strlen(cstr));
 }
 
+BreadString* bread_string_new_young(const char* cstr) {
+    if (!cstr) cstr = "";
+    size_t len = strlen(cstr);
+    if (len <= 1) return bread_string_short(cstr, len);
+    BreadString* s = bread_string_alloc_in(len, 1);
+    if (!s) return NULL;
+    memcpy(s->data, cstr, len);
+    return s;
+}
+
+// Decimal text of a number as a young string; the digits of an Int are
+// written straight into the string's buffer.
+BreadString* bread_string_from_int(int64_t value) {
+    size_t len = bread_format_int_length(value);
+    if (len == 1) {
+        char digit = (char)('0' + value);
+        return bread_string_short(&digit, 1);
+    }
+    BreadString* s = bread_string_alloc_in(len, 1);
+    if (!s) return NULL;
+    bread_format_int(s->data, value);
+    return s;
+}
+
+BreadString* bread_string_from_double(double value, int precision) {
+    char buf[BREAD_FORMAT_MAX];
+    size_t len = bread_format_double(buf, value, precision);
+    if (len <= 1) return bread_string_short(buf, len);
+    BreadString* s = bread_string_alloc_in(len, 1);
+    if (!s) return NULL;
+    memcpy(s->data, buf, len);
+    return s;
+}
+
 BreadString* bread_string_new_literal(const char* cstr) {
     if (!cstr) cstr = "";
     size_t len = strlen(cstr);
+    if (len <= 1) return bread_string_short(cstr, len);
     
     if (!intern_initialized) {
         bread_string_intern_init();
+        if (!intern_initialized) return bread_string_new_len(cstr, len);
     }
     
-    unsigned int hash = bread_string_hash(cstr, len);
-    BreadString* s = intern_table[hash];
-    while (s) {
-        if (s->len == len && memcmp(s->data, cstr, len) == 0) {
+    uint64_t hash = bread_hash_bytes(cstr, len);
+    size_t mask = intern_capacity - 1;
+    size_t slot = hash & mask;
+    intern_lookups++;
+    for (BreadString* s; (s = intern_table[slot].string) != NULL; slot = (slot + 1) & mask) {
+        if (intern_table[slot].hash == hash && s->len == len && memcmp(s->data, cstr, len) == 0) {
+            intern_hits++;
             bread_string_retain(s);
             return s;
         }
-        // Use a proper linked list traversal (this is simplified)
-        break; // For now, just handle single entry per bucket
     }
     
-    // Create new interned string
-    s = bread_string_new_len(cstr, len);
+    BreadString* s = bread_string_new_len(cstr, len);
     if (!s) return NULL;
     
+    // the table holds its own reference, so interned strings live until cleanup
     s->flags |= BREAD_STRING_INTERNED;
+    s->hash = hash;
+    bread_string_retain(s);
+    intern_table[slot].hash = hash;
+    intern_table[slot].string = s;
+    intern_count++;
     
-    // Add to intern table (simplified - just replace existing)
-    if (intern_table[hash]) {
-        bread_string_release(intern_table[hash]);
+    // keep the load factor under 70%
+    if (intern_count * 10 > intern_capacity * 7) {
+        bread_string_intern_grow();
     }
-    intern_table[hash] = s;
-    bread_string_retain(s);
     
     return s;
 }
 
 const char* bread_string_cstr(const BreadString* s) {
-    return s ? (const char*)s->data : "";
+    if (!s) return "";
+    if (bread_string_is_view(s)) {
+        BreadStringView* v = (BreadStringView*)s;
+        if (!v->flat) {
+            v->flat = bread_string_new_len(v->bytes, v->len);
+            if (!v->flat) return "";
+        }
+        return v->flat->data;
+    }
+    return (const char*)s->data;
+}
+
+const char* bread_string_data(const BreadString* s) {
+    if (!s) return "";
+    return bread_string_is_view(s) ? ((const BreadStringView*)s)->bytes : (const char*)s->data;
 }
 
 size_t bread_string_len(const BreadString* s) {
@@ -109,30 +373,290 @@ void bread_string_retain(BreadString* s) {
 }
 
 void bread_string_release(BreadString* s) {
+    // young views are dropped by their nursery finalizer instead
+    if (bread_string_is_view(s) && s->header.refcount == 1 && bread_memory_object_size(s)) {
+        bread_string_view_drop((BreadStringView*)s);
+    }
     bread_object_release(s);
 }
 
+BreadString* bread_string_promote(BreadString* s) {
+    if (bread_string_is_view(s) && bread_memory_is_young(s)) {
+        BreadStringView* v = (BreadStringView*)s;
+        // a young parent dies with the statement, so keep only the bytes
+        if (bread_memory_is_young(v->parent)) return bread_string_new_len(v->bytes, v->len);
+        return bread_string_view_new(v->parent, v->bytes, v->len, 0);
+    }
+    return (BreadString*)bread_memory_promote(s);
+}
+
+static BreadString* bread_string_slice_in(BreadString* s, size_t start, size_t end, int young) {
+    size_t len = bread_string_len(s);
+    if (end > len) end = len;
+    if (start > end) start = end;
+    size_t n = end - start;
+    const char* bytes = bread_string_data(s) + start;
+    
+    if (n <= 1) return bread_string_short(bytes, n);
+    if (n <= BREAD_STRING_SMALL_MAX) {
+        BreadString* out = bread_string_alloc_in(n, young);
+        if (!out) return NULL;
+        memcpy(out->data, bytes, n);
+        return out;
+    }
+    BreadString* parent = bread_string_is_view(s) ? ((BreadStringView*)s)->parent : s;
+    // a tracked view must not outlive a young parent, which the statement's
+    // nursery reset frees whatever its refcount says
+    if (!young && bread_memory_is_young(parent)) return bread_string_new_len(bytes, n);
+    return bread_string_view_new(parent, bytes, n, young);
+}
+
+// Characters [start, end) of `s`, clamped to its length. Short results are
+// copied; longer ones are views sharing the bytes of `s`.
+BreadString* bread_string_slice(BreadString* s, size_t start, size_t end) {
+    return bread_string_slice_in(s, start, end, 1);
+}
+
+// Splits in one scan that records where each separator starts, then fills
+// an array sized for exactly that many pieces. Pieces are views into `s`
+// where they are long enough, and copies when `s` is a statement
+// temporary. An empty separator splits into characters.
+BreadArray* bread_string_split(BreadString* s, const BreadString* sep) {
+    const char* data = bread_string_data(s);
+    size_t len = bread_string_len(s);
+    size_t sep_len = bread_string_len(sep);
+    
+    size_t* cuts = NULL;
+    size_t cut_count = 0;
+    if (sep_len > 0) {
+        size_t cut_capacity = 0;
+        for (size_t pos = 0;;) {
+            int64_t at = bread_bytes_find(data + pos, len - pos, bread_string_data(sep), sep_len);
+            if (at < 0) break;
+            if (cut_count == cut_capacity) {
+                cut_capacity = cut_capacity ? cut_capacity * 2 : 16;
+                size_t* grown = realloc(cuts, cut_capacity * sizeof(size_t));
+                if (!grown) {
+                    free(cuts);
+                    BREAD_ERROR_SET_MEMORY_ALLOCATION("Out of memory during string split");
+                    return NULL;
+                }
+                cuts = grown;
+            }
+            cuts[cut_count++] = pos + (size_t)at;
+            pos += (size_t)at + sep_len;
+        }
+    }
+    
+    size_t pieces = sep_len > 0 ? cut_count + 1 : len;
+    BreadArray* out = bread_array_new_with_capacity((int)pieces, TYPE_STRING);
+    if (!out) {
+        free(cuts);
+        return NULL;
+    }
+    for (size_t i = 0; i < pieces; i++) {
+        size_t start = sep_len > 0 ? (i ? cuts[i - 1] + sep_len : 0) : i;
+        size_t end = sep_len > 0 ? (i < cut_count ? cuts[i] : len) : i + 1;
+        BreadString* piece = bread_string_slice_in(s, start, end, 0);
+        if (!piece) {
+            free(cuts);
+            bread_array_release(out);
+            return NULL;
+        }
+        out->items[i].type = TYPE_STRING;
+        out->items[i].value.string_val = piece;
+        out->count++;
+    }
+    free(cuts);
+    return out;
+}
+
+// Every non-overlapping occurrence of `from`, left to right. The result is
+// sized from the match count and written once.
+BreadString* bread_string_replace(BreadString* s, const BreadString* from, const BreadString* to) {
+    const char* data = bread_string_data(s);
+    size_t len = bread_string_len(s);
+    size_t from_len = bread_string_len(from);
+    size_t to_len = bread_string_len(to);
+    size_t count = from_len ? bread_bytes_count(data, len, bread_string_data(from), from_len) : 0;
+    if (count == 0) return bread_string_slice(s, 0, len);
+    
+    size_t total = len - count * from_len + count * to_len;
+    char tiny[2];
+    char* w = tiny;
+    BreadString* out = NULL;
+    if (total > 1) {
+        out = bread_string_alloc_in(total, 1);
+        if (!out) return NULL;
+        w = out->data;
+    }
+    for (size_t pos = 0;;) {
+        int64_t at = bread_bytes_find(data + pos, len - pos, bread_string_data(from), from_len);
+        size_t keep = at < 0 ? len - pos : (size_t)at;
+        memcpy(w, data + pos, keep);
+        w += keep;
+        if (at < 0) break;
+        memcpy(w, bread_string_data(to), to_len);
+        w += to_len;
+        pos += (size_t)at + from_len;
+    }
+    if (!out) return bread_string_short(tiny, total);
+    out->data[total] = '\0';
+    return out;
+}
+
 BreadString* bread_string_concat(const BreadString* a, const BreadString* b) {
     size_t la = bread_string_len(a);
     size_t lb = bread_string_len(b);
-    BreadString* out = bread_string_alloc(la + lb);
+    if (la + lb <= 1) {
+        return bread_string_short(la ? bread_string_data(a) : bread_string_data(b), la + lb);
+    }
+    BreadString* out = bread_string_alloc_in(la + lb, 1);
     if (!out) return NULL;
-    if (la) memcpy(out->data, bread_string_cstr(a), la);
-    if (lb) memcpy(out->data + la, bread_string_cstr(b), lb);
+    if (la) memcpy(out->data, bread_string_data(a), la);
+    if (lb) memcpy(out->data + la, bread_string_data(b), lb);
     out->data[la + lb] = '\0';
     return out;
 }
 
+// Joins `count` strings with a single allocation and one copy of each part.
+BreadString* bread_string_concat_n(const BreadString* const* parts, size_t count) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += bread_string_len(parts[i]);
+    }
+    if (total <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            if (bread_string_len(parts[i])) return bread_string_short(bread_string_data(parts[i]), 1);
+        }
+        return bread_string_short("", 0);
+    }
+    
+    BreadString* out = bread_string_alloc_in(total, 1);
+    if (!out) return NULL;
+    size_t at = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t len = bread_string_len(parts[i]);
+        if (len) memcpy(out->data + at, bread_string_data(parts[i]), len);
+        at += len;
+    }
+    out->data[total] = '\0';
+    return out;
+}
+
+// Returns `s` + `tail`, taking over the caller's reference to `s`. When
+// that reference is the only one, the bytes are appended in place and the
+// buffer grows geometrically, so repeated appends cost amortised O(1) per
+// byte. Shared, interned, static and young strings are copied instead.
+// On failure returns NULL and `s` is left untouched.
+BreadString* bread_string_append(BreadString* s, const BreadString* tail) {
+    size_t len = bread_string_len(s);
+    size_t tail_len = bread_string_len(tail);
+    size_t need = sizeof(BreadString) + len + tail_len + 1;
+    
+    size_t capacity = s ? bread_memory_object_size(s) : 0;
+    if (capacity && s->header.refcount == 1 &&
+        !(s->flags & (BREAD_STRING_INTERNED | BREAD_STRING_VIEW))) {
+        int self = tail == s;
+        if (need > capacity) {
+            size_t grown = sizeof(BreadString) + 2 * (len + tail_len) + 1;
+            BreadString* moved = (BreadString*)bread_memory_realloc(s, grown < 64 ? 64 : grown);
+            if (!moved) return NULL;
+            s = moved;
+        }
+        memcpy(s->data + len, self ? s->data : bread_string_data(tail), tail_len);
+        s->len = len + tail_len;
+        s->data[s->len] = '\0';
+        s->hash = 0;
+        if (s->len > BREAD_STRING_SMALL_MAX) s->flags &= ~BREAD_STRING_SMALL;
+        return s;
+    }
+    
+    // first append: leave room for the next ones
+    size_t room = 2 * (len + tail_len);
+    BreadString* out = (BreadString*)bread_memory_alloc(sizeof(BreadString) + (room < 32 ? 32 : room) + 1,
+                                                        BREAD_OBJ_STRING);
+    if (!out) return NULL;
+    out->len = len + tail_len;
+    out->hash = 0;
+    out->flags = out->len <= BREAD_STRING_SMALL_MAX ? BREAD_STRING_SMALL : 0;
+    if (len) memcpy(out->data, bread_string_data(s), len);
+    if (tail_len) memcpy(out->data + len, bread_string_data(tail), tail_len);
+    out->data[out->len] = '\0';
+    bread_string_release(s);
+    return out;
+}
+
+static inline uint64_t bread_load64(const char* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t bread_load32(const char* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Most keys are short, and for those a few overlapping unaligned loads beat
+// a call into memcmp; long runs go to memcmp, which is already vectorised.
+static inline int bread_bytes_equal(const char* a, const char* b, size_t n) {
+    if (n < 4) {
+        for (size_t i = 0; i < n; i++) {
+            if (a[i] != b[i]) return 0;
+        }
+        return 1;
+    }
+    if (n < 8) {
+        return ((bread_load32(a) ^ bread_load32(b)) | (bread_load32(a + n - 4) ^ bread_load32(b + n - 4))) == 0;
+    }
+    if (n > 64) return memcmp(a, b, n) == 0;
+
+    uint64_t diff = bread_load64(a + n - 8) ^ bread_load64(b + n - 8);
+    for (size_t i = 0; i + 8 < n && !diff; i += 8) {
+        diff = bread_load64(a + i) ^ bread_load64(b + i);
+    }
+    return diff == 0;
+}
+
+// Every runtime string equality test goes through here: identity, then
+// the checks that need no string bytes (interning, length, cached hashes),
+// then the bytes themselves.
 int bread_string_eq(const BreadString* a, const BreadString* b) {
+    if (a == b) return 1;
     size_t la = bread_string_len(a);
     size_t lb = bread_string_len(b);
     if (la != lb) return 0;
     if (la == 0) return 1;
-    return memcmp(bread_string_cstr(a), bread_string_cstr(b), la) == 0;
+    // both non-NULL from here on
+    // interned strings are unique per content
+    if (a->flags & b->flags & BREAD_STRING_INTERNED) return 0;
+    if (a->hash && b->hash && a->hash != b->hash) return 0;
+    return bread_bytes_equal(bread_string_data(a), bread_string_data(b), la);
+}
+
+int bread_string_index_in(const BreadValue* items, int count, const BreadString* needle) {
+    size_t len = bread_string_len(needle);
+    const char* want = bread_string_data(needle);
+    uint64_t hash = needle ? needle->hash : 0;
+    for (int i = 0; i < count; i++) {
+        const BreadString* s = items[i].value.string_val;
+        if (items[i].type != TYPE_STRING || !s || s->len != len) continue;
+        if (s == needle) return i;
+        if (hash && s->hash && s->hash != hash) continue;
+        if (bread_bytes_equal(bread_string_data(s), want, len)) return i;
+    }
+    return -1;
 }
 
 int bread_string_cmp(const BreadString* a, const BreadString* b) {
-    return strcmp(bread_string_cstr(a), bread_string_cstr(b));
+    if (a == b) return 0;
+    size_t la = bread_string_len(a);
+    size_t lb = bread_string_len(b);
+    int c = memcmp(bread_string_data(a), bread_string_data(b), la < lb ? la : lb);
+    if (c) return c;
+    return la < lb ? -1 : la > lb;
 }
 
 char bread_string_get_char(const BreadString* s, size_t index) {
@@ -147,5 +671,5 @@ char bread_string_get_char(const BreadString* s, size_t index) {
         BREAD_ERROR_SET_INDEX_OUT_OF_BOUNDS(error_msg);
         return '\0';
     }
-    return s->data[index];
+    return bread_string_data(s)[index];
 }
\ No newline at end of file
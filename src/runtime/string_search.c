@@ -0,0 +1,138 @@
+#include <string.h>
+
+#include "runtime/string_search.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BREAD_SEARCH_X86 1
+#endif
+
+typedef int64_t (*BreadFindFn)(const char* hay, size_t n, const char* needle, size_t m);
+
+// first and last bytes already match at p
+static inline int bread_bytes_middle_eq(const char* p, const char* needle, size_t m) {
+    return m <= 2 || memcmp(p + 1, needle + 1, m - 2) == 0;
+}
+
+static int64_t bread_find_scalar_from(const char* hay, size_t n, const char* needle, size_t m, size_t i) {
+    const char first = needle[0];
+    const char last = needle[m - 1];
+    for (; i + m <= n; i++) {
+        if (hay[i] == first && hay[i + m - 1] == last && bread_bytes_middle_eq(hay + i, needle, m)) {
+            return (int64_t)i;
+        }
+    }
+    return -1;
+}
+
+static int64_t bread_find_scalar(const char* hay, size_t n, const char* needle, size_t m) {
+    return bread_find_scalar_from(hay, n, needle, m, 0);
+}
+
+#ifdef BREAD_SEARCH_X86
+// Each step compares 16 candidate starts against the needle's first byte
+// and the 16 matching ends against its last byte; the loads stay in bounds
+// and the scalar loop finishes the remaining positions.
+static int64_t bread_find_sse2(const char* hay, size_t n, const char* needle, size_t m) {
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[m - 1]);
+    size_t i = 0;
+    for (; i + m - 1 + 16 <= n; i += 16) {
+        __m128i head = _mm_loadu_si128((const __m128i*)(hay + i));
+        __m128i tail = _mm_loadu_si128((const __m128i*)(hay + i + m - 1));
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last)));
+        while (mask) {
+            unsigned bit = (unsigned)__builtin_ctz(mask);
+            if (bread_bytes_middle_eq(hay + i + bit, needle, m)) return (int64_t)(i + bit);
+            mask &= mask - 1;
+        }
+    }
+    return bread_find_scalar_from(hay, n, needle, m, i);
+}
+
+__attribute__((target("avx2")))
+static int64_t bread_find_avx2(const char* hay, size_t n, const char* needle, size_t m) {
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[m - 1]);
+    size_t i = 0;
+    for (; i + m - 1 + 32 <= n; i += 32) {
+        __m256i head = _mm256_loadu_si256((const __m256i*)(hay + i));
+        __m256i tail = _mm256_loadu_si256((const __m256i*)(hay + i + m - 1));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last)));
+        while (mask) {
+            unsigned bit = (unsigned)__builtin_ctz(mask);
+            if (bread_bytes_middle_eq(hay + i + bit, needle, m)) return (int64_t)(i + bit);
+            mask &= mask - 1;
+        }
+    }
+    return bread_find_scalar_from(hay, n, needle, m, i);
+}
+#endif
+
+static BreadFindFn bread_find_impl = NULL;
+static const char* bread_find_name = "scalar";
+
+static void bread_bytes_select(void) {
+    bread_find_impl = bread_find_scalar;
+    bread_find_name = "scalar";
+#ifdef BREAD_SEARCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        bread_find_impl = bread_find_avx2;
+        bread_find_name = "avx2";
+    } else if (__builtin_cpu_supports("sse2")) {
+        bread_find_impl = bread_find_sse2;
+        bread_find_name = "sse2";
+    }
+#endif
+}
+
+const char* bread_bytes_kernel(void) {
+    if (!bread_find_impl) bread_bytes_select();
+    return bread_find_name;
+}
+
+int bread_bytes_set_kernel(const char* name) {
+    if (!name) return 0;
+    if (strcmp(name, "scalar") == 0) {
+        bread_find_impl = bread_find_scalar;
+        bread_find_name = "scalar";
+        return 1;
+    }
+#ifdef BREAD_SEARCH_X86
+    __builtin_cpu_init();
+    if (strcmp(name, "sse2") == 0 && __builtin_cpu_supports("sse2")) {
+        bread_find_impl = bread_find_sse2;
+        bread_find_name = "sse2";
+        return 1;
+    }
+    if (strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2")) {
+        bread_find_impl = bread_find_avx2;
+        bread_find_name = "avx2";
+        return 1;
+    }
+#endif
+    return 0;
+}
+
+int64_t bread_bytes_find(const char* hay, size_t n, const char* needle, size_t m) {
+    if (m == 0) return 0;
+    if (m > n) return -1;
+    if (!bread_find_impl) bread_bytes_select();
+    return bread_find_impl(hay, n, needle, m);
+}
+
+size_t bread_bytes_count(const char* hay, size_t n, const char* needle, size_t m) {
+    if (m == 0) return n + 1; // the empty string occurs between every pair of bytes
+    size_t count = 0;
+    size_t pos = 0;
+    for (;;) {
+        int64_t at = bread_bytes_find(hay + pos, n - pos, needle, m);
+        if (at < 0) break;
+        count++;
+        pos += (size_t)at + m;
+    }
+    return count;
+}
@@ -6,6 +6,7 @@
 
 #include "runtime/runtime.h"
 #include "runtime/error.h"
+#include "runtime/number_format.h"
 #include "core/value.h"
 #include "core/var.h"
 #include "compiler/parser/expr.h"
@@ -79,6 +80,89 @@ int bread_add(const BreadValue* left, const BreadValue* right, BreadValue* out)
     return 1;
 }
 
+static int bread_all_strings(BreadValue** parts, int32_t count) {
+    for (int32_t i = 0; i < count; i++) {
+        if (!parts[i] || parts[i]->type != TYPE_STRING) return 0;
+    }
+    return 1;
+}
+
+// Left fold of `acc + parts[i]`, used when some operand is not a string
+static int bread_add_fold(BreadValue* acc, BreadValue** parts, int32_t count) {
+    for (int32_t i = 0; i < count; i++) {
+        BreadValue next;
+        if (!bread_add(acc, parts[i], &next)) {
+            bread_value_release(acc);
+            return 0;
+        }
+        bread_value_release(acc);
+        *acc = next;
+    }
+    return 1;
+}
+
+// Evaluates a chain `p0 + p1 + ... + pn`. When every part is a string the
+// result is sized once and each part copied once, instead of building a
+// new intermediate string per `+`.
+int bread_concat_op(BreadValue** parts, int32_t count, BreadValue* out) {
+    if (!parts || count < 1 || !out) return 0;
+
+    if (bread_all_strings(parts, count)) {
+        const BreadString* strings[16];
+        const BreadString** list = count <= 16 ? strings : malloc((size_t)count * sizeof(BreadString*));
+        if (!list) {
+            BREAD_ERROR_SET_MEMORY_ALLOCATION("Out of memory during string concatenation");
+            return 0;
+        }
+        for (int32_t i = 0; i < count; i++) list[i] = parts[i]->value.string_val;
+        BreadString* s = bread_string_concat_n(list, (size_t)count);
+        if (list != strings) free(list);
+
+        memset(out, 0, sizeof(*out));
+        if (!s) {
+            out->type = TYPE_NIL;
+            BREAD_ERROR_SET_MEMORY_ALLOCATION("Out of memory during string concatenation");
+            return 0;
+        }
+        out->type = TYPE_STRING;
+        out->value.string_val = s;
+        return 1;
+    }
+
+    BreadValue acc = bread_value_clone(*parts[0]);
+    if (!bread_add_fold(&acc, parts + 1, count - 1)) {
+        memset(out, 0, sizeof(*out));
+        out->type = TYPE_NIL;
+        return 0;
+    }
+    *out = acc;
+    return 1;
+}
+
+// `target = target + parts...` for a variable slot. A string target the
+// slot owns exclusively is extended in place.
+int bread_append_op(BreadValue* target, BreadValue** parts, int32_t count) {
+    if (!target || !parts || count < 1) return 0;
+
+    if (target->type == TYPE_STRING && bread_all_strings(parts, count)) {
+        for (int32_t i = 0; i < count; i++) {
+            BreadString* s = bread_string_append(target->value.string_val, parts[i]->value.string_val);
+            if (!s) {
+                BREAD_ERROR_SET_MEMORY_ALLOCATION("Out of memory during string concatenation");
+                return 0;
+            }
+            target->value.string_val = s;
+        }
+        return 1;
+    }
+
+    BreadValue acc = bread_value_clone(*target);
+    if (!bread_add_fold(&acc, parts, count)) return 0;
+    bread_value_store(&acc, target);
+    bread_value_release(&acc);
+    return 1;
+}
+
 int bread_eq(const BreadValue* left, const BreadValue* right, int* out_bool) {
     if (!left || !right || !out_bool) return 0;
 
@@ -126,14 +210,13 @@ int bread_eq(const BreadValue* left, const BreadValue* right, int* out_bool) {
     }
 }
 
-static void bread_format_float(char* buf, size_t size, double value) {
-    snprintf(buf, size, "%.15g", value);
-    if (!strchr(buf, '.') && !strchr(buf, 'e') && !strchr(buf, 'E')) {
-        size_t len = strlen(buf);
-        if (len + 2 < size) {
-            strncat(buf, ".0", size - len - 1);
-        }
+static size_t bread_format_float(char* buf, double value) {
+    size_t len = bread_format_double(buf, value, 15);
+    if (!memchr(buf, '.', len) && !memchr(buf, 'e', len)) {
+        memcpy(buf + len, ".0", 3);
+        len += 2;
     }
+    return len;
 }
 
 static void bread_print_value_recursive(const BreadValue* v, int compact) {
@@ -151,29 +234,18 @@ static void bread_print_value_recursive(const BreadValue* v, int compact) {
             printf("%s", v->value.bool_val ? "true" : "false");
             break;
             
-        case TYPE_INT:
-            printf("%lld", (long long)v->value.int_val);
-            break;
-            
-        case TYPE_FLOAT: {
-            if (compact) {
-                char buf[64];
-                bread_format_float(buf, sizeof(buf), (double)v->value.float_val);
-                printf("%s", buf);
-            } else {
-                printf("%f", v->value.float_val);
-            }
+        case TYPE_INT: {
+            char buf[BREAD_FORMAT_MAX];
+            fwrite(buf, 1, bread_format_int(buf, v->value.int_val), stdout);
             break;
         }
             
+        case TYPE_FLOAT:
         case TYPE_DOUBLE: {
-            if (compact) {
-                char buf[64];
-                bread_format_float(buf, sizeof(buf), v->value.double_val);
-                printf("%s", buf);
-            } else {
-                printf("%lf", v->value.double_val);
-            }
+            double value = v->type == TYPE_FLOAT ? (double)v->value.float_val : v->value.double_val;
+            char buf[BREAD_FORMAT_MAX];
+            size_t len = compact ? bread_format_float(buf, value) : bread_format_double_fixed(buf, value, 6);
+            fwrite(buf, 1, len, stdout);
             break;
         }
             
@@ -199,7 +271,8 @@ static void bread_print_value_recursive(const BreadValue* v, int compact) {
             if (a && a->count > 0) {
                 for (int i = 0; i < a->count; i++) {
                     if (i > 0) printf(", ");
-                    bread_print_value_recursive(&a->items[i], compact);
+                    BreadValue item = bread_array_at(a, i);
+                    bread_print_value_recursive(&item, compact);
                 }
             }
             printf("]");
@@ -314,7 +387,7 @@ void bread_value_set_string(BreadValue* out, const char* cstr) {
     if (!out) return;
     memset(out, 0, sizeof(*out));
     out->type = TYPE_STRING;
-    out->value.string_val = bread_string_new(cstr ? cstr : "");
+    out->value.string_val = bread_string_new_young(cstr ? cstr : "");
     if (!out->value.string_val) {
         BREAD_ERROR_SET_MEMORY_ALLOCATION("Out of memory creating string");
         out->type = TYPE_NIL;
@@ -376,6 +449,14 @@ void bread_value_copy(const BreadValue* in, BreadValue* out) {
     *out = bread_value_clone(*in);
 }
 
+// Copy into a slot that outlives the statement, such as a local variable.
+void bread_value_store(const BreadValue* in, BreadValue* out) {
+    if (!in || !out || in == out) return;
+    BreadValue stored = bread_value_promote(*in);
+    bread_value_release(out);
+    *out = stored;
+}
+
 void bread_value_release_value(BreadValue* v) {
     bread_value_release(v);
 }
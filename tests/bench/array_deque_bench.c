@@ -0,0 +1,72 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "runtime/memory.h"
+#include "core/value.h"
+
+// Queue and deque traffic through insert(0, x) and removeAt(0) at growing
+// sizes. Every operation is O(1) amortised, so the time per operation
+// should stay flat as the queue grows instead of rising with its length.
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static BreadValue int_value(int64_t i) {
+    BreadValue v;
+    memset(&v, 0, sizeof(v));
+    v.type = TYPE_INT;
+    v.value.int_val = i;
+    return v;
+}
+
+// BFS-style: fill to `size`, then pop the front and push the back `size`
+// times, then drain
+static double time_queue(int size, int64_t* check) {
+    BreadArray* q = bread_array_new_typed(TYPE_INT);
+    if (!q) return 0;
+    double start = now_seconds();
+    for (int i = 0; i < size; i++) bread_array_append(q, int_value(i));
+    for (int i = 0; i < size; i++) {
+        BreadValue front = bread_array_remove_at(q, 0);
+        bread_array_append(q, int_value(front.value.int_val + size));
+    }
+    while (q->count > 0) *check += bread_array_remove_at(q, 0).value.int_val;
+    double elapsed = now_seconds() - start;
+    bread_array_release(q);
+    return elapsed;
+}
+
+// Pushes `size` elements at the front, then pops from alternate ends
+static double time_deque(int size, int64_t* check) {
+    BreadArray* d = bread_array_new_typed(TYPE_INT);
+    if (!d) return 0;
+    double start = now_seconds();
+    for (int i = 0; i < size; i++) bread_array_insert(d, int_value(i), 0);
+    for (int i = 0; d->count > 0; i++) {
+        *check += bread_array_remove_at(d, i % 2 ? -1 : 0).value.int_val;
+    }
+    double elapsed = now_seconds() - start;
+    bread_array_release(d);
+    return elapsed;
+}
+
+int main(void) {
+    bread_memory_init();
+    printf("%-10s %14s %14s\n", "size", "queue ns/op", "deque ns/op");
+
+    int64_t check = 0;
+    for (int size = 10000; size <= 10000000; size *= 10) {
+        double queue_s = time_queue(size, &check);
+        double deque_s = time_deque(size, &check);
+        // 3 and 2 operations per element
+        printf("%-10d %14.2f %14.2f\n", size, queue_s * 1e9 / (3.0 * size), deque_s * 1e9 / (2.0 * size));
+    }
+
+    bread_memory_cleanup();
+    return check == 0;
+}
@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "runtime/array_reduce.h"
+#include "runtime/memory.h"
+#include "runtime/runtime.h"
+#include "core/value.h"
+
+// Reduces a 100M element [Int] and [Double] with each kernel, reporting
+// GB/s of elements read, and times sum() written as a Bread loop does it,
+// one bread_index_op and bread_binary_op per element.
+
+#define BENCH_COUNT 100000000
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// sink keeps the compiler from dropping the reductions
+static double bench_sink = 0;
+
+static BreadArray* filled(VarType type) {
+    BreadArray* a = bread_array_new_with_capacity(BENCH_COUNT, type);
+    if (!a) return NULL;
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        BreadValue v;
+        memset(&v, 0, sizeof(v));
+        v.type = type;
+        if (type == TYPE_INT) {
+            v.value.int_val = (int64_t)i * 7919 % 1000 - 500;
+        } else {
+            v.value.double_val = (double)((int64_t)i * 7919 % 1000) * 0.25;
+        }
+        if (!bread_array_append(a, v)) return NULL;
+    }
+    return a;
+}
+
+static void report(const char* kernel, const char* op, size_t bytes, double seconds) {
+    printf("%-8s %-12s %10.3f %10.2f\n", kernel, op, seconds, (double)bytes / seconds / 1e9);
+}
+
+static void run_kernels(const char* kernel, const int64_t* ints, const double* doubles) {
+    const size_t n = BENCH_COUNT, bytes = n * 8;
+    double start;
+
+#define TIME_OP(label, expr, read)          \
+    start = now_seconds();                  \
+    bench_sink += (double)(expr);           \
+    report(kernel, label, read, now_seconds() - start)
+
+    TIME_OP("sum [Int]", bread_reduce_sum_i64(ints, n), bytes);
+    TIME_OP("min [Int]", bread_reduce_min_i64(ints, n), bytes);
+    TIME_OP("mean [Int]", bread_reduce_mean_i64(ints, n), bytes);
+    TIME_OP("dot [Int]", bread_reduce_dot_i64(ints, ints, n), 2 * bytes);
+    TIME_OP("sum [Double]", bread_reduce_sum_f64(doubles, n), bytes);
+    TIME_OP("max [Double]", bread_reduce_max_f64(doubles, n), bytes);
+    TIME_OP("prod [Double]", bread_reduce_prod_f64(doubles, n), bytes);
+    TIME_OP("dot [Double]", bread_reduce_dot_f64(doubles, doubles, n), 2 * bytes);
+#undef TIME_OP
+}
+
+static double time_bread_loop(BreadArray* a) {
+    BreadValue array, index, element, total, next;
+    bread_value_set_array(&array, a);
+    bread_value_set_int(&total, 0);
+    double start = now_seconds();
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        bread_value_set_int(&index, i);
+        if (!bread_index_op(&array, &index, &element)) return 0;
+        if (!bread_binary_op('+', &total, &element, &next)) return 0;
+        total = next;
+    }
+    double elapsed = now_seconds() - start;
+    bench_sink += (double)total.value.int_val;
+    bread_value_release(&array);
+    return elapsed;
+}
+
+int main(void) {
+    bread_memory_init();
+    BreadArray* ints = filled(TYPE_INT);
+    BreadArray* doubles = filled(TYPE_DOUBLE);
+    if (!ints || !doubles) {
+        fprintf(stderr, "could not allocate inputs\n");
+        return 1;
+    }
+
+    printf("%-8s %-12s %10s %10s\n", "kernel", "100M", "time (s)", "GB/s");
+    static const char* const kernels[] = {"scalar", "avx2"};
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        if (!bread_reduce_set_kernel(kernels[k])) continue;
+        run_kernels(kernels[k], bread_array_int_data(ints), bread_array_double_data(doubles));
+    }
+    report("loop", "sum [Int]", (size_t)BENCH_COUNT * 8, time_bread_loop(ints));
+
+    bread_array_release(ints);
+    bread_array_release(doubles);
+    bread_memory_cleanup();
+    return bench_sink == 0;
+}
@@ -0,0 +1,87 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "runtime/memory.h"
+#include "core/value.h"
+
+// Binary search over a sorted 1M element [Int] that narrows to a half on
+// every step, once with slice() and once copying the half element by
+// element, which was the only way to do it before slices.
+
+#define BENCH_COUNT 1000000
+#define BENCH_SEARCHES 200
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static BreadArray* copy_range(BreadArray* a, int start, int end) {
+    BreadArray* out = bread_array_new_with_capacity(end - start, a->element_type);
+    if (!out) return NULL;
+    for (int i = start; i < end; i++) {
+        if (!bread_array_append(out, bread_array_at(a, i))) return NULL;
+    }
+    return out;
+}
+
+// Narrows `a` down around `target`, releasing every half it made
+static int search(BreadArray* a, int64_t target, int use_slices) {
+    bread_array_retain(a);
+    while (a->count > 0) {
+        int mid = a->count / 2;
+        int64_t v = bread_array_at(a, mid).value.int_val;
+        if (v == target) {
+            bread_array_release(a);
+            return 1;
+        }
+        int start = v < target ? mid + 1 : 0, end = v < target ? a->count : mid;
+        BreadArray* half = use_slices ? bread_array_slice(a, start, end) : copy_range(a, start, end);
+        bread_array_release(a);
+        if (!half) return -1;
+        a = half;
+    }
+    bread_array_release(a);
+    return 0;
+}
+
+static double time_searches(BreadArray* sorted, int use_slices, int* hits) {
+    double start = now_seconds();
+    *hits = 0;
+    for (int i = 0; i < BENCH_SEARCHES; i++) {
+        int found = search(sorted, (int64_t)i * 997 % (2 * BENCH_COUNT), use_slices);
+        if (found < 0) return 0;
+        *hits += found;
+    }
+    return now_seconds() - start;
+}
+
+int main(void) {
+    bread_memory_init();
+    BreadArray* sorted = bread_array_new_with_capacity(BENCH_COUNT, TYPE_INT);
+    if (!sorted) return 1;
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        BreadValue v;
+        memset(&v, 0, sizeof(v));
+        v.type = TYPE_INT;
+        v.value.int_val = 2 * (int64_t)i;
+        if (!bread_array_append(sorted, v)) return 1;
+    }
+
+    int slice_hits = 0, copy_hits = 0;
+    double slice_s = time_searches(sorted, 1, &slice_hits);
+    double copy_s = time_searches(sorted, 0, &copy_hits);
+
+    printf("%-8s %10s %14s\n", "halves", "time (s)", "us per search");
+    printf("%-8s %10.3f %14.2f\n", "slice", slice_s, slice_s * 1e6 / BENCH_SEARCHES);
+    printf("%-8s %10.3f %14.2f\n", "copy", copy_s, copy_s * 1e6 / BENCH_SEARCHES);
+
+    int ok = slice_hits == copy_hits && slice_hits > 0;
+    if (!ok) fprintf(stderr, "searches disagree\n");
+    bread_array_release(sorted);
+    bread_memory_cleanup();
+    return !ok;
+}
@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "runtime/memory.h"
+
+// Compares bread_memory_alloc/bread_memory_free against the original
+// single-class BreadMemoryPool (64-byte blocks, linear chunk scan on free,
+// malloc for everything larger), reproduced below as the baseline.
+
+#define BENCH_LIVE_OBJECTS 20000
+#define BENCH_ROUNDS 50
+
+#define LEGACY_BLOCK_SIZE 64
+#define LEGACY_BLOCKS_PER_CHUNK 256
+
+typedef struct LegacyChunk {
+    uint8_t blocks[LEGACY_BLOCKS_PER_CHUNK][LEGACY_BLOCK_SIZE];
+    uint64_t free_bitmap[LEGACY_BLOCKS_PER_CHUNK / 64];
+    struct LegacyChunk* next;
+    size_t free_count;
+} LegacyChunk;
+
+static LegacyChunk* legacy_chunks = NULL;
+
+static void* legacy_alloc(size_t size) {
+    if (size > LEGACY_BLOCK_SIZE) return malloc(size);
+
+    if (!legacy_chunks || legacy_chunks->free_count == 0) {
+        LegacyChunk* chunk = calloc(1, sizeof(LegacyChunk));
+        if (!chunk) return NULL;
+        memset(chunk->free_bitmap, 0xFF, sizeof(chunk->free_bitmap));
+        chunk->free_count = LEGACY_BLOCKS_PER_CHUNK;
+        chunk->next = legacy_chunks;
+        legacy_chunks = chunk;
+    }
+
+    LegacyChunk* chunk = legacy_chunks;
+    for (size_t i = 0; i < LEGACY_BLOCKS_PER_CHUNK / 64; i++) {
+        if (chunk->free_bitmap[i] == 0) continue;
+        int bit = __builtin_ctzll(chunk->free_bitmap[i]);
+        chunk->free_bitmap[i] &= ~(1ULL << bit);
+        chunk->free_count--;
+        return &chunk->blocks[i * 64 + bit][0];
+    }
+    return NULL;
+}
+
+static void legacy_free(void* ptr) {
+    for (LegacyChunk* chunk = legacy_chunks; chunk; chunk = chunk->next) {
+        uintptr_t start = (uintptr_t)&chunk->blocks[0][0];
+        uintptr_t addr = (uintptr_t)ptr;
+        if (addr >= start && addr < start + sizeof(chunk->blocks)) {
+            size_t block_idx = (addr - start) / LEGACY_BLOCK_SIZE;
+            chunk->free_bitmap[block_idx / 64] |= (1ULL << (block_idx % 64));
+            chunk->free_count++;
+            return;
+        }
+    }
+    free(ptr);
+}
+
+static void legacy_cleanup(void) {
+    while (legacy_chunks) {
+        LegacyChunk* next = legacy_chunks->next;
+        free(legacy_chunks);
+        legacy_chunks = next;
+    }
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Object sizes seen in the runtime: optionals, arrays/dicts, short and
+// medium strings, structs and classes.
+static const size_t bench_sizes[] = {24, 32, 40, 48, 64, 96, 120, 160, 200, 320};
+
+typedef struct {
+    void* (*alloc)(size_t size);
+    void (*free)(void* ptr);
+} BenchAllocator;
+
+static void* bread_alloc_adapter(size_t size) { return bread_memory_alloc(size, BREAD_OBJ_UNKNOWN); }
+
+static double run_workload(const BenchAllocator* a, size_t* out_ops) {
+    static void* live[BENCH_LIVE_OBJECTS];
+    uint32_t rng = 12345;
+    size_t ops = 0;
+
+    double start = now_seconds();
+    for (int i = 0; i < BENCH_LIVE_OBJECTS; i++) {
+        live[i] = a->alloc(bench_sizes[i % (sizeof(bench_sizes) / sizeof(bench_sizes[0]))]);
+        ops++;
+    }
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        // free and replace a random half of the live set
+        for (int i = 0; i < BENCH_LIVE_OBJECTS / 2; i++) {
+            rng = rng * 1103515245u + 12345u;
+            int slot = (int)((rng >> 8) % BENCH_LIVE_OBJECTS);
+            a->free(live[slot]);
+            live[slot] = a->alloc(bench_sizes[(rng >> 4) % (sizeof(bench_sizes) / sizeof(bench_sizes[0]))]);
+            ops++;
+        }
+    }
+    for (int i = 0; i < BENCH_LIVE_OBJECTS; i++) {
+        a->free(live[i]);
+    }
+    double elapsed = now_seconds() - start;
+
+    *out_ops = ops;
+    return elapsed;
+}
+
+int main(void) {
+    bread_memory_init();
+
+    const BenchAllocator legacy = {legacy_alloc, legacy_free};
+    const BenchAllocator slab = {bread_alloc_adapter, bread_memory_free};
+    size_t legacy_ops = 0, slab_ops = 0;
+
+    double legacy_time = run_workload(&legacy, &legacy_ops);
+    legacy_cleanup();
+    double slab_time = run_workload(&slab, &slab_ops);
+
+    printf("%-24s %12s %16s\n", "allocator", "seconds", "allocs/sec");
+    printf("%-24s %12.4f %16.0f\n", "legacy 64-byte pool", legacy_time, legacy_ops / legacy_time);
+    printf("%-24s %12.4f %16.0f\n", "slab size classes", slab_time, slab_ops / slab_time);
+    printf("speedup: %.2fx\n", legacy_time / slab_time);
+
+    bread_memory_cleanup();
+    return 0;
+}
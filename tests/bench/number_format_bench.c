@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "runtime/number_format.h"
+
+// Formats 10M Ints and 10M Doubles with snprintf and with the runtime's
+// formatters, checking that both produce the same text. Doubles are timed
+// in the three formats the runtime prints: "%g" (toString), "%.15g"
+// (collection elements) and "%f" (print).
+
+#define BENCH_COUNT 10000000
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static uint64_t bench_rng = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t next_random(void) {
+    bench_rng ^= bench_rng << 13;
+    bench_rng ^= bench_rng >> 7;
+    bench_rng ^= bench_rng << 17;
+    return bench_rng;
+}
+
+// sink keeps the compiler from dropping the formatting
+static size_t bench_sink = 0;
+
+static double time_ints(const int64_t* values, int use_printf) {
+    char buf[BREAD_FORMAT_MAX];
+    double start = now_seconds();
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        bench_sink += use_printf ? (size_t)snprintf(buf, sizeof(buf), "%lld", (long long)values[i])
+                                 : bread_format_int(buf, values[i]);
+    }
+    return now_seconds() - start;
+}
+
+static double time_doubles(const double* values, char kind, int precision, int use_printf) {
+    char buf[BREAD_FORMAT_MAX];
+    double start = now_seconds();
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        if (kind == 'g') {
+            bench_sink += use_printf ? (size_t)snprintf(buf, sizeof(buf), "%.*g", precision, values[i])
+                                     : bread_format_double(buf, values[i], precision);
+        } else {
+            bench_sink += use_printf ? (size_t)snprintf(buf, sizeof(buf), "%.*f", precision, values[i])
+                                     : bread_format_double_fixed(buf, values[i], precision);
+        }
+    }
+    return now_seconds() - start;
+}
+
+static int check_doubles(const double* values, char kind, int precision) {
+    char ours[BREAD_FORMAT_MAX];
+    char theirs[BREAD_FORMAT_MAX];
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        if (kind == 'g') {
+            bread_format_double(ours, values[i], precision);
+            snprintf(theirs, sizeof(theirs), "%.*g", precision, values[i]);
+        } else {
+            bread_format_double_fixed(ours, values[i], precision);
+            snprintf(theirs, sizeof(theirs), "%.*f", precision, values[i]);
+        }
+        if (strcmp(ours, theirs) != 0) {
+            fprintf(stderr, "mismatch for %.17g: %s vs %s\n", values[i], ours, theirs);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void report(const char* name, double printf_s, double ours_s) {
+    printf("%-8s %12.3f %12.3f %9.2fx\n", name, printf_s, ours_s, printf_s / ours_s);
+}
+
+int main(void) {
+    int64_t* ints = malloc(BENCH_COUNT * sizeof(int64_t));
+    double* doubles = malloc(BENCH_COUNT * sizeof(double));
+    if (!ints || !doubles) {
+        fprintf(stderr, "could not allocate inputs\n");
+        return 1;
+    }
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        ints[i] = (int64_t)(next_random() >> (next_random() % 64));
+        if (i & 1) ints[i] = -ints[i];
+        // mix of short decimals and full-precision values
+        doubles[i] = (i & 1) ? (double)(next_random() % 1000000) / 100.0
+                             : (double)(next_random() >> 11) / 9007199254740992.0 * 1e6;
+    }
+
+    char ours[BREAD_FORMAT_MAX];
+    char theirs[BREAD_FORMAT_MAX];
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        bread_format_int(ours, ints[i]);
+        snprintf(theirs, sizeof(theirs), "%lld", (long long)ints[i]);
+        if (strcmp(ours, theirs) != 0) {
+            fprintf(stderr, "mismatch for %s: %s\n", theirs, ours);
+            return 1;
+        }
+    }
+    if (!check_doubles(doubles, 'g', 6) || !check_doubles(doubles, 'g', 15) || !check_doubles(doubles, 'f', 6)) {
+        return 1;
+    }
+
+    printf("%-8s %12s %12s %10s\n", "format", "printf (s)", "runtime (s)", "speedup");
+    report("%lld", time_ints(ints, 1), time_ints(ints, 0));
+    report("%g", time_doubles(doubles, 'g', 6, 1), time_doubles(doubles, 'g', 6, 0));
+    report("%.15g", time_doubles(doubles, 'g', 15, 1), time_doubles(doubles, 'g', 15, 0));
+    report("%f", time_doubles(doubles, 'f', 6, 1), time_doubles(doubles, 'f', 6, 0));
+
+    free(ints);
+    free(doubles);
+    return bench_sink == 0;
+}
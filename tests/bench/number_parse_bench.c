@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "runtime/array_utils.h"
+#include "runtime/memory.h"
+#include "runtime/number_parse.h"
+#include "runtime/string_ops.h"
+#include "core/value.h"
+
+// Parses 10M Int and 10M Double strings with strtoll/strtod and with the
+// runtime's parsers, checking both agree, then times the batch
+// toInts()/toDoubles() path on a 1M element [String].
+
+#define BENCH_COUNT 10000000
+#define BATCH_COUNT 1000000
+#define TEXT_WIDTH 32
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static uint64_t bench_rng = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t next_random(void) {
+    bench_rng ^= bench_rng << 13;
+    bench_rng ^= bench_rng >> 7;
+    bench_rng ^= bench_rng << 17;
+    return bench_rng;
+}
+
+// sink keeps the compiler from dropping the parsing
+static double bench_sink = 0;
+
+static double time_ints(const char* texts, const int* lens, int use_libc) {
+    double start = now_seconds();
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        const char* s = texts + (size_t)i * TEXT_WIDTH;
+        int64_t v = 0;
+        if (use_libc) {
+            v = strtoll(s, NULL, 10);
+        } else {
+            bread_parse_int(s, (size_t)lens[i], &v);
+        }
+        bench_sink += (double)v;
+    }
+    return now_seconds() - start;
+}
+
+static double time_doubles(const char* texts, const int* lens, int use_libc) {
+    double start = now_seconds();
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        const char* s = texts + (size_t)i * TEXT_WIDTH;
+        double v = 0;
+        if (use_libc) {
+            v = strtod(s, NULL);
+        } else {
+            bread_parse_double(s, (size_t)lens[i], &v);
+        }
+        bench_sink += v;
+    }
+    return now_seconds() - start;
+}
+
+static size_t total_bytes(const int* lens) {
+    size_t total = 0;
+    for (int i = 0; i < BENCH_COUNT; i++) total += (size_t)lens[i];
+    return total;
+}
+
+static void report(const char* name, size_t bytes, double libc_s, double ours_s) {
+    double mb = (double)bytes / (1024.0 * 1024.0);
+    printf("%-8s %12.1f %12.1f %9.2fx\n", name, mb / libc_s, mb / ours_s, libc_s / ours_s);
+}
+
+static double time_batch(const char* texts, int parse_doubles) {
+    BreadArray* strings = bread_array_new_with_capacity(BATCH_COUNT, TYPE_STRING);
+    if (!strings) return 0;
+    for (int i = 0; i < BATCH_COUNT; i++) {
+        BreadValue* item = &strings->items[strings->count++];
+        memset(item, 0, sizeof(*item));
+        item->type = TYPE_STRING;
+        item->value.string_val = bread_string_new(texts + (size_t)i * TEXT_WIDTH);
+    }
+
+    double start = now_seconds();
+    BreadArray* numbers = parse_doubles ? bread_array_parse_doubles(strings) : bread_array_parse_ints(strings);
+    double elapsed = now_seconds() - start;
+
+    if (numbers) {
+        bench_sink += bread_array_length(numbers);
+        bread_array_release(numbers);
+    }
+    bread_array_release(strings);
+    return elapsed;
+}
+
+int main(void) {
+    bread_memory_init();
+
+    char* int_texts = malloc((size_t)BENCH_COUNT * TEXT_WIDTH);
+    char* double_texts = malloc((size_t)BENCH_COUNT * TEXT_WIDTH);
+    int* int_lens = malloc(BENCH_COUNT * sizeof(int));
+    int* double_lens = malloc(BENCH_COUNT * sizeof(int));
+    if (!int_texts || !double_texts || !int_lens || !double_lens) {
+        fprintf(stderr, "could not allocate inputs\n");
+        return 1;
+    }
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        int64_t n = (int64_t)(next_random() >> (next_random() % 64));
+        if (i & 1) n = -n;
+        int_lens[i] = snprintf(int_texts + (size_t)i * TEXT_WIDTH, TEXT_WIDTH, "%lld", (long long)n);
+        // mix of short decimals and full-precision values
+        double d = (i & 1) ? (double)(next_random() % 1000000) / 100.0
+                           : (double)(next_random() >> 11) / 9007199254740992.0 * 1e6;
+        double_lens[i] = snprintf(double_texts + (size_t)i * TEXT_WIDTH, TEXT_WIDTH, (i & 1) ? "%g" : "%.17g", d);
+    }
+
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        const char* si = int_texts + (size_t)i * TEXT_WIDTH;
+        const char* sd = double_texts + (size_t)i * TEXT_WIDTH;
+        int64_t ours_i = 0;
+        double ours_d = 0;
+        if (!bread_parse_int(si, (size_t)int_lens[i], &ours_i) || ours_i != strtoll(si, NULL, 10)) {
+            fprintf(stderr, "mismatch for %s: %lld\n", si, (long long)ours_i);
+            return 1;
+        }
+        double theirs_d = strtod(sd, NULL);
+        if (!bread_parse_double(sd, (size_t)double_lens[i], &ours_d) || memcmp(&ours_d, &theirs_d, sizeof(double)) != 0) {
+            fprintf(stderr, "mismatch for %s: %.17g\n", sd, ours_d);
+            return 1;
+        }
+    }
+
+    printf("%-8s %12s %12s %10s\n", "parse", "libc (MB/s)", "runtime (MB/s)", "speedup");
+    report("Int", total_bytes(int_lens), time_ints(int_texts, int_lens, 1), time_ints(int_texts, int_lens, 0));
+    report("Double", total_bytes(double_lens), time_doubles(double_texts, double_lens, 1),
+           time_doubles(double_texts, double_lens, 0));
+
+    printf("\n%-12s %12s\n", "batch (1M)", "time (s)");
+    printf("%-12s %12.3f\n", "toInts", time_batch(int_texts, 0));
+    printf("%-12s %12.3f\n", "toDoubles", time_batch(double_texts, 1));
+
+    free(int_texts);
+    free(double_texts);
+    free(int_lens);
+    free(double_lens);
+    bread_memory_cleanup();
+    return bench_sink == 0;
+}
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "runtime/memory.h"
+#include "core/value.h"
+
+// Times full cycle collections over heaps of nested arrays whose leaves are
+// dicts pointing back at their parent, for a range of heap sizes and
+// marking thread counts. "live" collects with the whole heap still
+// referenced (every object is grayed and scanned back to black); "garbage"
+// collects after the last external reference is dropped.
+
+#define BENCH_FANOUT 8
+
+static const int bench_depths[] = {5, 6};
+static const int bench_threads[] = {1, 2, 4, 8};
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static BreadValue array_value(BreadArray* a) {
+    BreadValue v;
+    memset(&v, 0, sizeof(v));
+    v.type = TYPE_ARRAY;
+    v.value.array_val = a;
+    return v;
+}
+
+static BreadValue dict_value(BreadDict* d) {
+    BreadValue v;
+    memset(&v, 0, sizeof(v));
+    v.type = TYPE_DICT;
+    v.value.dict_val = d;
+    return v;
+}
+
+static BreadArray* build_tree(int depth) {
+    BreadArray* node = bread_array_new();
+    for (int i = 0; i < BENCH_FANOUT; i++) {
+        if (depth > 1) {
+            BreadArray* child = build_tree(depth - 1);
+            bread_array_append(node, array_value(child));
+            bread_array_release(child);
+        } else {
+            BreadDict* leaf = bread_dict_new();
+            bread_dict_set(leaf, "up", array_value(node));
+            bread_array_append(node, dict_value(leaf));
+            bread_dict_release(leaf);
+        }
+    }
+    return node;
+}
+
+static double time_collection(void) {
+    double start = now_seconds();
+    bread_memory_collect_cycles();
+    return now_seconds() - start;
+}
+
+int main(void) {
+    bread_memory_init();
+
+    printf("%-10s %8s %12s %12s %10s\n", "objects", "threads", "live (s)", "garbage (s)", "speedup");
+    for (size_t d = 0; d < sizeof(bench_depths) / sizeof(bench_depths[0]); d++) {
+        double baseline = 0.0;
+        for (size_t t = 0; t < sizeof(bench_threads) / sizeof(bench_threads[0]); t++) {
+            bread_memory_set_gc_threads(bench_threads[t]);
+
+            BreadArray* root = build_tree(bench_depths[d]);
+            bread_memory_collect_cycles(); // flush candidates buffered while building
+            size_t objects = bread_memory_get_stats().current_objects;
+
+            bread_memory_possible_cycle_root(root);
+            double live = time_collection();
+
+            bread_array_release(root);
+            double garbage = time_collection();
+
+            if (t == 0) baseline = live + garbage;
+            printf("%-10zu %8d %12.4f %12.4f %9.2fx\n", objects, bench_threads[t],
+                   live, garbage, baseline / (live + garbage));
+        }
+    }
+
+    bread_memory_cleanup();
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "runtime/memory.h"
+#include "runtime/string_ops.h"
+#include "core/value.h"
+
+// Searches a [String] with bread_array_index_of and with the strcmp scan
+// it replaced, at a size that fits in cache and at one that does not. The
+// keys share a long prefix and mostly share a length, so the length check
+// alone does not settle every comparison.
+
+#define BENCH_ELEMENTS 20000000 // per timing: count * rounds
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int strcmp_index_of(BreadArray* array, const BreadString* needle) {
+    const char* want = bread_string_cstr(needle);
+    for (int i = 0; i < array->count; i++) {
+        if (strcmp(bread_string_cstr(array->items[i].value.string_val), want) == 0) return i;
+    }
+    return -1;
+}
+
+static BreadValue string_value(const char* text) {
+    BreadValue v;
+    memset(&v, 0, sizeof(v));
+    v.type = TYPE_STRING;
+    v.value.string_val = bread_string_new(text);
+    return v;
+}
+
+static int run(int count) {
+    BreadArray* keys = bread_array_new_with_capacity(count, TYPE_STRING);
+    if (!keys) {
+        fprintf(stderr, "could not allocate inputs\n");
+        return 0;
+    }
+    char text[64];
+    for (int i = 0; i < count; i++) {
+        snprintf(text, sizeof(text), "session/user-%07d", i);
+        keys->items[keys->count++] = string_value(text);
+    }
+
+    // one hit at the end, one same-length miss, one different-length miss
+    snprintf(text, sizeof(text), "session/user-%07d", count - 1);
+    BreadValue needles[3] = {
+        string_value(text),
+        string_value("session/user-x999990"),
+        string_value("session/user-99"),
+    };
+    const char* needle_names[3] = {"hit", "miss", "miss-len"};
+
+    int rounds = BENCH_ELEMENTS / count;
+    size_t sink = 0;
+    for (int n = 0; n < 3; n++) {
+        int expected = strcmp_index_of(keys, needles[n].value.string_val);
+        if (bread_array_index_of(keys, needles[n]) != expected) {
+            fprintf(stderr, "mismatch for %s\n", needle_names[n]);
+            return 0;
+        }
+
+        double start = now_seconds();
+        for (int r = 0; r < rounds; r++) sink += (size_t)strcmp_index_of(keys, needles[n].value.string_val);
+        double strcmp_s = now_seconds() - start;
+
+        start = now_seconds();
+        for (int r = 0; r < rounds; r++) sink += (size_t)bread_array_index_of(keys, needles[n]);
+        double ours_s = now_seconds() - start;
+
+        printf("%-8d %-10s %12.3f %12.3f %9.2fx\n", count, needle_names[n], strcmp_s, ours_s, strcmp_s / ours_s);
+    }
+
+    for (int n = 0; n < 3; n++) bread_string_release(needles[n].value.string_val);
+    bread_array_release(keys);
+    return sink != 0;
+}
+
+int main(void) {
+    bread_memory_init();
+    printf("%-8s %-10s %12s %12s %10s\n", "count", "search", "strcmp (s)", "runtime (s)", "speedup");
+    int ok = run(10000) && run(1000000);
+    bread_memory_cleanup();
+    return !ok;
+}
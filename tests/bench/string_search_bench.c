@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "runtime/memory.h"
+#include "runtime/string_ops.h"
+#include "runtime/string_search.h"
+#include "core/value.h"
+
+// Search throughput over a 100MB log-like buffer for each search kernel the
+// CPU supports. "find" looks for a needle that never occurs, so it scans the
+// whole input; "count" and "split" stop at every match.
+
+#define BENCH_BYTES (100u * 1024u * 1024u)
+
+static const char* const bench_kernels[] = {"scalar", "sse2", "avx2"};
+
+static const char* const bench_lines[] = {
+    "2024-05-01 12:00:01 INFO  request served path=/index.html status=200\n",
+    "2024-05-01 12:00:02 WARN  slow response path=/api/items took=812ms\n",
+    "2024-05-01 12:00:03 INFO  cache hit key=session:48213\n",
+    "2024-05-01 12:00:04 ERROR upstream closed connection retry=1\n",
+};
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static char* build_input(size_t size) {
+    char* buf = malloc(size);
+    if (!buf) return NULL;
+    size_t at = 0;
+    for (size_t i = 0; at < size; i++) {
+        const char* line = bench_lines[i % (sizeof(bench_lines) / sizeof(bench_lines[0]))];
+        size_t n = strlen(line);
+        if (n > size - at) n = size - at;
+        memcpy(buf + at, line, n);
+        at += n;
+    }
+    return buf;
+}
+
+static double mb_per_second(double seconds) {
+    return (double)BENCH_BYTES / (1024.0 * 1024.0) / seconds;
+}
+
+int main(void) {
+    bread_memory_init();
+
+    char* input = build_input(BENCH_BYTES);
+    BreadString* text = input ? bread_string_new_len(input, BENCH_BYTES) : NULL;
+    BreadString* newline = bread_string_new("\n");
+    if (!text || !newline) {
+        fprintf(stderr, "could not allocate input\n");
+        return 1;
+    }
+
+    printf("%-8s %14s %14s %14s %10s\n", "kernel", "find (MB/s)", "count (MB/s)", "split (MB/s)", "lines");
+    for (size_t k = 0; k < sizeof(bench_kernels) / sizeof(bench_kernels[0]); k++) {
+        if (!bread_bytes_set_kernel(bench_kernels[k])) {
+            printf("%-8s %14s\n", bench_kernels[k], "unsupported");
+            continue;
+        }
+
+        double start = now_seconds();
+        int64_t found = bread_bytes_find(input, BENCH_BYTES, "status=503", 10);
+        double find = now_seconds() - start;
+
+        start = now_seconds();
+        size_t errors = bread_bytes_count(input, BENCH_BYTES, "ERROR", 5);
+        double count = now_seconds() - start;
+
+        start = now_seconds();
+        BreadArray* lines = bread_string_split(text, newline);
+        double split = now_seconds() - start;
+        int line_count = lines ? bread_array_length(lines) : 0;
+        if (lines) bread_array_release(lines);
+
+        if (found != -1 || errors == 0) fprintf(stderr, "unexpected search result\n");
+        printf("%-8s %14.0f %14.0f %14.0f %10d\n", bench_kernels[k], mb_per_second(find),
+               mb_per_second(count), mb_per_second(split), line_count);
+    }
+
+    bread_string_release(newline);
+    bread_string_release(text);
+    free(input);
+    bread_memory_cleanup();
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "runtime/memory.h"
+#include "core/value.h"
+
+// Appends 10M Ints and 10M Doubles and sums them straight off the unboxed
+// store, then again after bread_array_box has converted the array to
+// BreadValues, which is how every array was stored before.
+
+#define BENCH_COUNT 10000000
+#define BENCH_ROUNDS 10
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static double sum_unboxed(BreadArray* a) {
+    double total = 0;
+    if (a->element_type == TYPE_INT) {
+        const int64_t* ints = bread_array_int_data(a);
+        for (int i = 0; i < a->count; i++) total += (double)ints[i];
+    } else {
+        const double* doubles = bread_array_double_data(a);
+        for (int i = 0; i < a->count; i++) total += doubles[i];
+    }
+    return total;
+}
+
+static double sum_boxed(BreadArray* a) {
+    double total = 0;
+    for (int i = 0; i < a->count; i++) {
+        const BreadValue* v = &a->items[i];
+        total += v->type == TYPE_INT ? (double)v->value.int_val : v->value.double_val;
+    }
+    return total;
+}
+
+static double time_sum(double (*sum)(BreadArray*), BreadArray* a, double* out) {
+    double start = now_seconds();
+    for (int r = 0; r < BENCH_ROUNDS; r++) *out = sum(a);
+    return (now_seconds() - start) / BENCH_ROUNDS;
+}
+
+static double gb_per_s(size_t bytes, double seconds) {
+    return (double)bytes / seconds / 1e9;
+}
+
+static int run(const char* name, VarType type) {
+    BreadArray* a = bread_array_new_typed(type);
+    if (!a) return 0;
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        BreadValue v;
+        memset(&v, 0, sizeof(v));
+        v.type = type;
+        if (type == TYPE_INT) {
+            v.value.int_val = i % 1000;
+        } else {
+            v.value.double_val = (double)(i % 1000) * 0.5;
+        }
+        if (!bread_array_append(a, v)) return 0;
+    }
+
+    size_t unboxed_bytes = bread_memory_get_stats().backing_bytes;
+    double unboxed_sum = 0, boxed_sum = 0;
+    double unboxed_s = time_sum(sum_unboxed, a, &unboxed_sum);
+
+    if (!bread_array_box(a)) return 0;
+    size_t boxed_bytes = bread_memory_get_stats().backing_bytes;
+    double boxed_s = time_sum(sum_boxed, a, &boxed_sum);
+
+    if (unboxed_sum != boxed_sum) {
+        fprintf(stderr, "%s sums disagree\n", name);
+        return 0;
+    }
+
+    size_t data_bytes = (size_t)BENCH_COUNT * 8;
+    printf("%-8s %-10s %10.1f %10.4f %10.2f\n", name, "unboxed", unboxed_bytes / 1048576.0, unboxed_s,
+           gb_per_s(data_bytes, unboxed_s));
+    printf("%-8s %-10s %10.1f %10.4f %10.2f\n", name, "boxed", boxed_bytes / 1048576.0, boxed_s,
+           gb_per_s((size_t)BENCH_COUNT * sizeof(BreadValue), boxed_s));
+
+    bread_array_release(a);
+    return 1;
+}
+
+int main(void) {
+    bread_memory_init();
+    printf("%-8s %-10s %10s %10s %10s\n", "array", "sum", "MB held", "time (s)", "GB/s");
+    int ok = run("[Int]", TYPE_INT) && run("[Double]", TYPE_DOUBLE);
+    bread_memory_cleanup();
+    return !ok;
+}
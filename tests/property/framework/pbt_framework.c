@@ -8,7 +8,16 @@ void pbt_init_generator(PBTGenerator* gen, uint32_t seed) {
 // Simple LCG for reproducible random numbers
 uint32_t pbt_random_uint32(PBTGenerator* gen) {
     gen->seed = (gen->seed * 1103515245 + 12345) & 0x7fffffff;
-    return gen->seed;
+    // The low bits of this LCG repeat with short periods (bit 0 just
+    // alternates), so consecutive draws reduced with % would be
+    // correlated; hash the state so every output bit depends on all of it
+    uint32_t x = gen->seed;
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x & 0x7fffffff;
 }
 
 int pbt_random_int(PBTGenerator* gen, int min, int max) {
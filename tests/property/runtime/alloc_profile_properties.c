@@ -0,0 +1,356 @@
+#define _DEFAULT_SOURCE // mkstemp, unsetenv
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "../framework/pbt_framework.h"
+#include "runtime/runtime.h"
+#include "runtime/memory.h"
+#include "runtime/alloc_profile.h"
+
+#define ALLOC_PROFILE_ITERATIONS 300
+#define ALLOC_PROFILE_MAX_OPS 160
+#define ALLOC_PROFILE_MAX_LIVE 64
+#define ALLOC_PROFILE_MAX_SIZE 2048
+#define ALLOC_PROFILE_SITES 5 // the runtime site and four statements
+#define ALLOC_PROFILE_MAX_DEPTH 8
+#define ALLOC_PROFILE_SAMPLED_ITERATIONS PBT_MIN_ITERATIONS
+#define ALLOC_PROFILE_SAMPLES 5000 // sample periods per case, for a ~1.4% spread
+
+typedef enum {
+    OP_SET_SITE,
+    OP_ALLOC,
+    OP_ALLOC_YOUNG,   // charged to the site but never live
+    OP_ALLOC_BACKING, // an array or dict buffer, live until freed
+    OP_REALLOC,       // moves the object to the current site
+    OP_FREE,
+    OP_CALL,          // saves the site as a compiled function's entry does
+    OP_RETURN,        // puts the caller's site back
+    OP_COUNT
+} ProfileOpKind;
+
+typedef struct {
+    ProfileOpKind kind;
+    int pick;
+    size_t size;
+} ProfileOp;
+
+typedef struct {
+    int op_count;
+    ProfileOp ops[ALLOC_PROFILE_MAX_OPS];
+    size_t sample_bytes; // for the sampled property
+    size_t object_size;
+} ProfileInput;
+
+typedef struct {
+    double alloc_objects;
+    double alloc_bytes;
+    double live_objects;
+    double live_bytes;
+} SiteTotals;
+
+typedef struct {
+    void* ptr;
+    size_t size;
+    int site;
+    int backing;
+} LiveObject;
+
+// Site 0 is where allocations land before any statement reports itself.
+// Two sites share a file so only the line and column tell them apart.
+static const char* site_files[ALLOC_PROFILE_SITES] = {NULL, "main.bread", "main.bread", "lib.bread", "util.bread"};
+static const int32_t site_lines[ALLOC_PROFILE_SITES] = {0, 3, 3, 12, 40};
+static const int32_t site_columns[ALLOC_PROFILE_SITES] = {0, 5, 9, 1, 17};
+
+void* generate_profile_input(PBTGenerator* gen) {
+    ProfileInput* data = malloc(sizeof(ProfileInput));
+    if (!data) return NULL;
+    data->op_count = pbt_random_int(gen, 1, ALLOC_PROFILE_MAX_OPS + 1);
+    for (int i = 0; i < data->op_count; i++) {
+        data->ops[i].kind = (ProfileOpKind)pbt_random_int(gen, 0, OP_COUNT);
+        data->ops[i].pick = pbt_random_int(gen, 0, 256);
+        data->ops[i].size = (size_t)pbt_random_int(gen, sizeof(BreadObjHeader), ALLOC_PROFILE_MAX_SIZE + 1);
+    }
+    data->sample_bytes = (size_t)pbt_random_int(gen, 256, 4096 + 1);
+    data->object_size = (size_t)pbt_random_int(gen, 64, 512 + 1);
+    return data;
+}
+
+void cleanup_profile_input(void* test_data) {
+    free(test_data);
+}
+
+static void fresh_heap(void) {
+    bread_memory_cleanup();
+    bread_memory_init();
+}
+
+static FILE* open_report(char* path) {
+    strcpy(path, "/tmp/bread_alloc_profile_XXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) return NULL;
+    close(fd);
+    return fopen(path, "r");
+}
+
+static const char* site_name(int site, char* buf, size_t size) {
+    if (!site_files[site]) return "<runtime>";
+    snprintf(buf, size, "%s:%d:%d", site_files[site], site_lines[site], site_columns[site]);
+    return buf;
+}
+
+// Reads the report rows into `found`, indexed like site_files. Returns 0
+// if a row is malformed, names an unknown site or twice the same site, or
+// if the rows are not sorted by live bytes and then allocated bytes.
+static int read_report(FILE* in, SiteTotals* found, int* seen, double* total_alloc, double* total_live,
+                       size_t* sample_bytes) {
+    char line[512];
+    *sample_bytes = 0;
+    if (!fgets(line, sizeof(line), in) || strcmp(line, "=== Allocation Profile ===\n") != 0) return 0;
+    if (!fgets(line, sizeof(line), in)) return 0;
+    if (sscanf(line, "Sampling 1 in %zu bytes", sample_bytes) == 1 && !fgets(line, sizeof(line), in)) return 0;
+    if (sscanf(line, "Total: %lf bytes allocated, %lf bytes live at exit", total_alloc, total_live) != 2) return 0;
+    if (!fgets(line, sizeof(line), in) || strcmp(line, "\n") != 0) return 0;
+    if (!fgets(line, sizeof(line), in) || !strstr(line, "live bytes")) return 0;
+
+    memset(seen, 0, ALLOC_PROFILE_SITES * sizeof(int));
+    double prev_live = INFINITY, prev_alloc = INFINITY;
+    while (fgets(line, sizeof(line), in)) {
+        SiteTotals row;
+        char name[256];
+        if (sscanf(line, "%lf %lf %lf %lf %255s", &row.live_bytes, &row.live_objects,
+                   &row.alloc_bytes, &row.alloc_objects, name) != 5) {
+            return 0;
+        }
+        if (row.live_bytes > prev_live || (row.live_bytes == prev_live && row.alloc_bytes > prev_alloc)) return 0;
+        prev_live = row.live_bytes;
+        prev_alloc = row.alloc_bytes;
+
+        int site = -1;
+        for (int s = 0; s < ALLOC_PROFILE_SITES; s++) {
+            char buf[64];
+            if (strcmp(name, site_name(s, buf, sizeof(buf))) == 0) site = s;
+        }
+        if (site < 0 || seen[site]) return 0;
+        seen[site] = 1;
+        found[site] = row;
+    }
+    return 1;
+}
+
+static void free_live(const LiveObject* obj) {
+    if (obj->backing) bread_memory_free_backing(obj->ptr, obj->size);
+    else bread_memory_free(obj->ptr);
+}
+
+// Property: without sampling, the report charges every allocation, young
+// ones and collection buffers included, to the statement that was current
+// (the caller's again once a call returns, whatever sites the callee set),
+// counts exactly the tracked objects and buffers still alive at each site,
+// moves reallocated ones to the current site, lists only sites that
+// allocated, and is sorted by live bytes and then allocated bytes
+int property_profile_matches_model(void* test_data) {
+    ProfileInput* data = (ProfileInput*)test_data;
+    fresh_heap();
+    char path[64];
+    FILE* in = open_report(path);
+    if (!in) return 0;
+    bread_alloc_profile_start(path, 0);
+    size_t mark = bread_memory_nursery_mark();
+
+    SiteTotals expected[ALLOC_PROFILE_SITES];
+    memset(expected, 0, sizeof(expected));
+    LiveObject live[ALLOC_PROFILE_MAX_LIVE];
+    int live_count = 0;
+    int current = 0;
+    uint32_t saved[ALLOC_PROFILE_MAX_DEPTH];
+    int callers[ALLOC_PROFILE_MAX_DEPTH];
+    int depth = 0;
+    int ok = 1;
+
+    for (int i = 0; i < data->op_count && ok; i++) {
+        const ProfileOp* op = &data->ops[i];
+        ProfileOpKind kind = op->kind;
+        if ((kind == OP_REALLOC || kind == OP_FREE) && live_count == 0) kind = OP_ALLOC;
+        if ((kind == OP_ALLOC || kind == OP_ALLOC_YOUNG || kind == OP_ALLOC_BACKING) &&
+            live_count == ALLOC_PROFILE_MAX_LIVE) {
+            kind = OP_FREE;
+        }
+        if (kind == OP_CALL && depth == ALLOC_PROFILE_MAX_DEPTH) kind = OP_RETURN;
+        if (kind == OP_RETURN && depth == 0) kind = OP_CALL;
+        LiveObject* obj = live_count ? &live[op->pick % live_count] : NULL;
+
+        switch (kind) {
+            case OP_SET_SITE: {
+                current = op->pick % ALLOC_PROFILE_SITES;
+                // the runtime site is only current before the first statement
+                if (current == 0) current = 1;
+                bread_alloc_profile_set_site(site_files[current], site_lines[current], site_columns[current]);
+                break;
+            }
+            case OP_ALLOC:
+            case OP_ALLOC_YOUNG:
+            case OP_ALLOC_BACKING: {
+                void* ptr = kind == OP_ALLOC         ? bread_memory_alloc(op->size, BREAD_OBJ_STRING)
+                            : kind == OP_ALLOC_YOUNG ? bread_memory_alloc_young(op->size, BREAD_OBJ_STRING)
+                                                     : bread_memory_alloc_backing(op->size, 0);
+                ok = ptr != NULL;
+                if (!ok) break;
+                expected[current].alloc_objects++;
+                expected[current].alloc_bytes += (double)op->size;
+                if (kind != OP_ALLOC_BACKING && bread_memory_is_young(ptr)) break;
+                expected[current].live_objects++;
+                expected[current].live_bytes += (double)op->size;
+                live[live_count].ptr = ptr;
+                live[live_count].size = op->size;
+                live[live_count].site = current;
+                live[live_count].backing = kind == OP_ALLOC_BACKING;
+                live_count++;
+                break;
+            }
+            case OP_REALLOC: {
+                void* moved = obj->backing ? bread_memory_realloc_backing(obj->ptr, obj->size, op->size)
+                                           : bread_memory_realloc(obj->ptr, op->size);
+                ok = moved != NULL;
+                if (!ok) break;
+                expected[obj->site].live_objects--;
+                expected[obj->site].live_bytes -= (double)obj->size;
+                expected[current].alloc_objects++;
+                expected[current].alloc_bytes += (double)op->size;
+                expected[current].live_objects++;
+                expected[current].live_bytes += (double)op->size;
+                obj->ptr = moved;
+                obj->size = op->size;
+                obj->site = current;
+                break;
+            }
+            case OP_CALL:
+                saved[depth] = bread_alloc_profile_site();
+                callers[depth++] = current;
+                break;
+            case OP_RETURN:
+                bread_alloc_profile_restore_site(saved[--depth]);
+                current = callers[depth];
+                break;
+            default:
+                free_live(obj);
+                expected[obj->site].live_objects--;
+                expected[obj->site].live_bytes -= (double)obj->size;
+                *obj = live[--live_count];
+                break;
+        }
+    }
+
+    bread_memory_nursery_reset(mark);
+    bread_alloc_profile_stop();
+    for (int j = 0; j < live_count; j++) free_live(&live[j]);
+
+    SiteTotals found[ALLOC_PROFILE_SITES];
+    int seen[ALLOC_PROFILE_SITES];
+    double total_alloc = 0, total_live = 0;
+    size_t sample_bytes = 0;
+    ok = ok && read_report(in, found, seen, &total_alloc, &total_live, &sample_bytes) && sample_bytes == 0;
+    fclose(in);
+    unlink(path);
+
+    double sum_alloc = 0, sum_live = 0;
+    for (int s = 0; s < ALLOC_PROFILE_SITES && ok; s++) {
+        sum_alloc += expected[s].alloc_bytes;
+        sum_live += expected[s].live_bytes;
+        ok = seen[s] == (expected[s].alloc_objects > 0);
+        if (!seen[s]) continue;
+        ok = ok && found[s].alloc_objects == expected[s].alloc_objects &&
+             found[s].alloc_bytes == expected[s].alloc_bytes &&
+             found[s].live_objects == expected[s].live_objects &&
+             found[s].live_bytes == expected[s].live_bytes;
+    }
+    return ok && total_alloc == sum_alloc && total_live == sum_live;
+}
+
+// Property: with sampling, the scaled-up estimate of the bytes a site
+// allocated lands within 10% of the truth (about seven standard
+// deviations at this many sample periods), and freeing everything leaves no live
+// estimate behind
+int property_sampled_profile_is_unbiased(void* test_data) {
+    ProfileInput* data = (ProfileInput*)test_data;
+    fresh_heap();
+    char path[64];
+    FILE* in = open_report(path);
+    if (!in) return 0;
+    bread_alloc_profile_start(path, data->sample_bytes);
+    bread_alloc_profile_set_site(site_files[1], site_lines[1], site_columns[1]);
+
+    size_t target = data->sample_bytes * ALLOC_PROFILE_SAMPLES;
+    size_t allocated = 0;
+    int ok = 1;
+    while (allocated < target && ok) {
+        void* ptr = bread_memory_alloc(data->object_size, BREAD_OBJ_STRING);
+        ok = ptr != NULL;
+        bread_memory_free(ptr);
+        allocated += data->object_size;
+    }
+    bread_alloc_profile_stop();
+
+    SiteTotals found[ALLOC_PROFILE_SITES];
+    int seen[ALLOC_PROFILE_SITES];
+    double total_alloc = 0, total_live = 0;
+    size_t sample_bytes = 0;
+    ok = ok && read_report(in, found, seen, &total_alloc, &total_live, &sample_bytes) &&
+         sample_bytes == data->sample_bytes && seen[1];
+    fclose(in);
+    unlink(path);
+
+    return ok && fabs(found[1].alloc_bytes - (double)allocated) <= 0.1 * (double)allocated &&
+           fabs(found[1].live_bytes) < 0.5 && fabs(total_live) < 0.5;
+}
+
+int run_alloc_profile_tests() {
+    printf("Running Allocation Profile Property Tests\n");
+    printf("========================================\n\n");
+
+    int all_passed = 1;
+
+    PBTResult result1 = pbt_run_property(
+        "Unsampled reports match a per-site model",
+        generate_profile_input,
+        property_profile_matches_model,
+        cleanup_profile_input,
+        ALLOC_PROFILE_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-alloc-profile", 1,
+                     "Unsampled reports match a per-site model", result1);
+
+    if (result1.failed > 0) all_passed = 0;
+
+    PBTResult result2 = pbt_run_property(
+        "Sampled estimates are within 10% of the truth",
+        generate_profile_input,
+        property_sampled_profile_is_unbiased,
+        cleanup_profile_input,
+        ALLOC_PROFILE_SAMPLED_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-alloc-profile", 2,
+                     "Sampled estimates are within 10% of the truth", result2);
+
+    if (result2.failed > 0) all_passed = 0;
+
+    pbt_free_result(&result1);
+    pbt_free_result(&result2);
+
+    return all_passed;
+}
+
+int main() {
+    // the environment would redirect or resample every profile started here
+    unsetenv("BREAD_ALLOC_PROFILE");
+    unsetenv("BREAD_ALLOC_SAMPLE");
+    bread_memory_init();
+    int passed = run_alloc_profile_tests();
+    bread_memory_cleanup();
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,316 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../framework/pbt_framework.h"
+#include "runtime/runtime.h"
+#include "runtime/memory.h"
+#include "core/value.h"
+
+#define ARENA_ITERATIONS 1000
+#define ARENA_MAX_OPS 96
+#define ARENA_MAX_DEPTH 6
+#define ARENA_STRUCT_FIELDS 4
+
+typedef enum {
+    OP_ENTER,   // a call with arena literals starts
+    OP_LEAVE,   // the innermost such call returns
+    OP_NEW,     // an array, dict or struct literal
+    OP_ADD,     // store a fresh tracked string in a live collection
+    OP_RETAIN,
+    OP_RELEASE,
+    OP_COUNT
+} ArenaOpKind;
+
+typedef enum {
+    SHAPE_ARRAY,
+    SHAPE_DICT,
+    SHAPE_STRUCT,
+    SHAPE_COUNT
+} Shape;
+
+typedef struct {
+    ArenaOpKind kind;
+    Shape shape;
+    int pick;    // which collection or struct field, modulo what is live
+    int observe; // the test keeps its own reference to the stored string
+} ArenaOp;
+
+typedef struct {
+    int op_count;
+    ArenaOp ops[ARENA_MAX_OPS];
+} ArenaInput;
+
+typedef struct {
+    BreadString* s;
+    int refs;    // expected refcount; 0 once freed
+    int observed;
+} Child;
+
+typedef struct {
+    void* ptr;
+    Shape shape;
+    int depth;   // frames open when it was made, 0 for a tracked fallback
+    int refs;    // expected refcount; 0 once its contents are released
+    int holds[2 * ARENA_MAX_OPS]; // one child index per reference held
+    int hold_count;
+    int fields[ARENA_STRUCT_FIELDS];
+} Collection;
+
+typedef struct {
+    Child children[ARENA_MAX_OPS];
+    int child_count;
+    Collection collections[ARENA_MAX_OPS];
+    int collection_count;
+} ArenaModel;
+
+void* generate_arena_input(PBTGenerator* gen) {
+    ArenaInput* data = malloc(sizeof(ArenaInput));
+    if (!data) return NULL;
+    data->op_count = pbt_random_int(gen, 1, ARENA_MAX_OPS + 1);
+    for (int i = 0; i < data->op_count; i++) {
+        data->ops[i].kind = (ArenaOpKind)pbt_random_int(gen, 0, OP_COUNT);
+        data->ops[i].shape = (Shape)pbt_random_int(gen, 0, SHAPE_COUNT);
+        data->ops[i].pick = pbt_random_int(gen, 0, 256);
+        data->ops[i].observe = pbt_random_int(gen, 0, 4) == 0;
+    }
+    return data;
+}
+
+void cleanup_arena_input(void* test_data) {
+    free(test_data);
+}
+
+// Starts each case outside every frame with an empty arena
+static void fresh_heap(void) {
+    bread_memory_cleanup();
+    bread_memory_init();
+}
+
+static char* field_names[ARENA_STRUCT_FIELDS] = {"a", "b", "c", "d"};
+
+static void* new_collection(Shape shape, int in_arena) {
+    switch (shape) {
+        case SHAPE_ARRAY: return in_arena ? (void*)bread_array_new_in_arena() : (void*)bread_array_new();
+        case SHAPE_DICT: return in_arena ? (void*)bread_dict_new_in_arena() : (void*)bread_dict_new();
+        default:
+            return in_arena ? (void*)bread_struct_new_in_arena("Pair", ARENA_STRUCT_FIELDS, field_names)
+                            : (void*)bread_struct_new("Pair", ARENA_STRUCT_FIELDS, field_names);
+    }
+}
+
+static void release_collection(const Collection* c) {
+    switch (c->shape) {
+        case SHAPE_ARRAY: bread_array_release(c->ptr); break;
+        case SHAPE_DICT: bread_dict_release(c->ptr); break;
+        default: bread_struct_release(c->ptr); break;
+    }
+}
+
+// What the runtime does once a collection's count reaches zero, or its
+// frame is left while it is still referenced
+static void drop_holds(ArenaModel* m, Collection* c) {
+    for (int h = 0; h < c->hold_count; h++) m->children[c->holds[h]].refs--;
+    for (int f = 0; f < ARENA_STRUCT_FIELDS; f++) {
+        if (c->fields[f] >= 0) m->children[c->fields[f]].refs--;
+    }
+    c->hold_count = 0;
+    c->refs = 0;
+}
+
+static Collection* pick_live(ArenaModel* m, int pick) {
+    int live = 0;
+    for (int i = 0; i < m->collection_count; i++) live += m->collections[i].refs > 0;
+    if (live == 0) return NULL;
+    pick %= live;
+    for (int i = 0; i < m->collection_count; i++) {
+        if (m->collections[i].refs > 0 && pick-- == 0) return &m->collections[i];
+    }
+    return NULL;
+}
+
+// Stores a fresh string in `c`; the builder's reference goes away unless
+// the test observes the string
+static int add_child(ArenaModel* m, Collection* c, const ArenaOp* op) {
+    char text[32];
+    snprintf(text, sizeof(text), "arena-child-%03d", m->child_count);
+    BreadString* s = bread_string_new(text);
+    if (!s) return 0;
+    int index = m->child_count++;
+    Child* child = &m->children[index];
+    child->s = s;
+    child->refs = 1;
+    child->observed = op->observe;
+
+    BreadValue v = {.type = TYPE_STRING};
+    v.value.string_val = s;
+    int ok = 1;
+    switch (c->shape) {
+        case SHAPE_ARRAY:
+            ok = bread_array_append(c->ptr, v);
+            c->holds[c->hold_count++] = index;
+            child->refs++;
+            break;
+        case SHAPE_DICT:
+            // the string is both the key and the value
+            ok = bread_dict_set_string(c->ptr, s, v);
+            c->holds[c->hold_count++] = index;
+            c->holds[c->hold_count++] = index;
+            child->refs += 2;
+            break;
+        default: {
+            int f = op->pick % ARENA_STRUCT_FIELDS;
+            bread_struct_set_field(c->ptr, field_names[f], v);
+            if (c->fields[f] >= 0) m->children[c->fields[f]].refs--;
+            c->fields[f] = index;
+            child->refs++;
+            break;
+        }
+    }
+    if (!child->observed) {
+        bread_string_release(s);
+        child->refs--;
+    }
+    return ok;
+}
+
+static int model_matches(const ArenaModel* m, size_t baseline) {
+    size_t expected = baseline;
+    for (int i = 0; i < m->child_count; i++) {
+        const Child* child = &m->children[i];
+        if (child->refs == 0) continue;
+        if (bread_object_get_refcount(child->s) != (uint32_t)child->refs) return 0;
+        expected++;
+    }
+    for (int i = 0; i < m->collection_count; i++) {
+        const Collection* c = &m->collections[i];
+        if (c->refs == 0) continue;
+        if (bread_object_get_refcount(c->ptr) != (uint32_t)c->refs) return 0;
+        if (bread_memory_is_arena(c->ptr) != (c->depth > 0)) return 0;
+        if (c->depth == 0) expected++;
+    }
+    return bread_memory_get_stats().current_objects == expected;
+}
+
+// Property: collections made inside a frame come from the arena and are
+// never counted as tracked objects. Leaving a frame releases exactly one
+// reference to everything still stored in its surviving collections,
+// however many references those collections had, and nothing twice for
+// collections already released. Outside every frame the same calls fall
+// back to tracked objects.
+int property_arena_matches_model(void* test_data) {
+    ArenaInput* data = (ArenaInput*)test_data;
+    fresh_heap();
+    size_t baseline = bread_memory_get_stats().current_objects;
+    size_t arena_before = bread_memory_get_stats().arena_allocations;
+    size_t arena_made = 0;
+    ArenaModel* m = calloc(1, sizeof(ArenaModel));
+    if (!m) return 0;
+    size_t marks[ARENA_MAX_DEPTH];
+    int depth = 0;
+    int ok = 1;
+
+    for (int i = 0; i < data->op_count && ok; i++) {
+        const ArenaOp* op = &data->ops[i];
+        ArenaOpKind kind = op->kind;
+        if (kind == OP_ENTER && depth == ARENA_MAX_DEPTH) kind = OP_LEAVE;
+        if (kind == OP_LEAVE && depth == 0) kind = OP_ENTER;
+        Collection* c = pick_live(m, op->pick);
+        if (!c && kind != OP_ENTER && kind != OP_LEAVE) kind = OP_NEW;
+
+        switch (kind) {
+            case OP_ENTER:
+                marks[depth++] = bread_memory_arena_enter();
+                break;
+            case OP_LEAVE:
+                bread_memory_arena_leave(marks[--depth]);
+                for (int j = 0; j < m->collection_count; j++) {
+                    Collection* gone = &m->collections[j];
+                    if (gone->depth > depth && gone->refs > 0) drop_holds(m, gone);
+                }
+                break;
+            case OP_NEW: {
+                Collection* fresh = &m->collections[m->collection_count];
+                fresh->ptr = new_collection(op->shape, depth > 0);
+                fresh->shape = op->shape;
+                fresh->depth = depth;
+                fresh->refs = 1;
+                fresh->hold_count = 0;
+                for (int f = 0; f < ARENA_STRUCT_FIELDS; f++) fresh->fields[f] = -1;
+                ok = fresh->ptr != NULL;
+                if (ok) m->collection_count++;
+                if (depth > 0) arena_made++;
+                break;
+            }
+            case OP_ADD:
+                ok = add_child(m, c, op);
+                break;
+            case OP_RETAIN:
+                bread_object_retain(c->ptr);
+                c->refs++;
+                break;
+            default:
+                release_collection(c);
+                if (--c->refs == 0) drop_holds(m, c);
+                break;
+        }
+
+        ok = ok && model_matches(m, baseline) &&
+             bread_memory_get_stats().arena_allocations == arena_before + arena_made;
+    }
+
+    while (depth > 0) bread_memory_arena_leave(marks[--depth]);
+    for (int j = 0; j < m->collection_count; j++) {
+        Collection* c = &m->collections[j];
+        if (c->depth > 0) {
+            if (c->refs > 0) drop_holds(m, c);
+            continue;
+        }
+        while (c->refs > 0) {
+            release_collection(c);
+            if (--c->refs == 0) drop_holds(m, c);
+        }
+    }
+    ok = ok && model_matches(m, baseline);
+    for (int j = 0; j < m->child_count; j++) {
+        Child* child = &m->children[j];
+        if (!child->observed) continue;
+        // only the test's own reference is left
+        ok = ok && child->refs == 1 && bread_object_get_refcount(child->s) == 1;
+        bread_string_release(child->s);
+    }
+    ok = ok && bread_memory_get_stats().current_objects == baseline;
+    free(m);
+    return ok;
+}
+
+int run_arena_tests() {
+    printf("Running Call Arena Property Tests\n");
+    printf("=================================\n\n");
+
+    int all_passed = 1;
+
+    PBTResult result1 = pbt_run_property(
+        "Arena frames release what surviving collections hold, once",
+        generate_arena_input,
+        property_arena_matches_model,
+        cleanup_arena_input,
+        ARENA_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-arena", 1,
+                     "Arena frames release what surviving collections hold, once", result1);
+
+    if (result1.failed > 0) all_passed = 0;
+
+    pbt_free_result(&result1);
+
+    return all_passed;
+}
+
+int main() {
+    bread_memory_init();
+    int passed = run_arena_tests();
+    bread_memory_cleanup();
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../framework/pbt_framework.h"
+#include "runtime/array_reduce.h"
+
+#define ARRAY_REDUCE_ITERATIONS 20000
+#define ARRAY_REDUCE_MAX_LEN 200
+
+static const char* const reduce_kernels[] = {"scalar", "avx2"};
+
+typedef struct {
+    size_t n;
+    int64_t ints[ARRAY_REDUCE_MAX_LEN];
+    int64_t other_ints[ARRAY_REDUCE_MAX_LEN];
+    double doubles[ARRAY_REDUCE_MAX_LEN];
+    double other_doubles[ARRAY_REDUCE_MAX_LEN];
+} ReduceInput;
+
+static uint64_t random_bits(PBTGenerator* gen) {
+    return ((uint64_t)pbt_random_uint32(gen) << 32) | pbt_random_uint32(gen);
+}
+
+// Small values, values near the Int limits (so sums and products
+// overflow) and, now and then, a NaN or an infinity among the Doubles
+static int64_t random_int(PBTGenerator* gen) {
+    switch (pbt_random_int(gen, 0, 4)) {
+        case 0: return (int64_t)random_bits(gen);
+        case 1: return INT64_MAX - pbt_random_int(gen, 0, 3);
+        case 2: return INT64_MIN + pbt_random_int(gen, 0, 3);
+        default: return pbt_random_int(gen, -1000, 1001);
+    }
+}
+
+static double random_double(PBTGenerator* gen) {
+    switch (pbt_random_int(gen, 0, 40)) {
+        case 0: return NAN;
+        case 1: return INFINITY;
+        case 2: return -0.0;
+        default: return (double)pbt_random_int(gen, -1000000, 1000001) / (1 + pbt_random_int(gen, 0, 1000));
+    }
+}
+
+void* generate_reduce_input(PBTGenerator* gen) {
+    ReduceInput* data = malloc(sizeof(ReduceInput));
+    if (!data) return NULL;
+    data->n = (size_t)pbt_random_int(gen, 1, ARRAY_REDUCE_MAX_LEN + 1);
+    for (size_t i = 0; i < data->n; i++) {
+        data->ints[i] = random_int(gen);
+        data->other_ints[i] = random_int(gen);
+        data->doubles[i] = random_double(gen);
+        data->other_doubles[i] = random_double(gen);
+    }
+    return data;
+}
+
+void cleanup_reduce_input(void* test_data) {
+    free(test_data);
+}
+
+static int same_double(double a, double b) {
+    return memcmp(&a, &b, sizeof(double)) == 0 || (a != a && b != b);
+}
+
+// Property: every kernel gives the Int results of a plain loop, wrapping
+// around on overflow, and mean() from the exact sum
+int property_int_reductions_match_loop(void* test_data) {
+    ReduceInput* data = (ReduceInput*)test_data;
+    uint64_t sum = 0, prod = 1, dot = 0;
+    __int128 exact = 0;
+    int64_t lo = data->ints[0], hi = data->ints[0];
+    for (size_t i = 0; i < data->n; i++) {
+        sum += (uint64_t)data->ints[i];
+        prod *= (uint64_t)data->ints[i];
+        dot += (uint64_t)data->ints[i] * (uint64_t)data->other_ints[i];
+        exact += data->ints[i];
+        if (data->ints[i] < lo) lo = data->ints[i];
+        if (data->ints[i] > hi) hi = data->ints[i];
+    }
+    double mean = (double)exact / (double)data->n;
+
+    for (size_t k = 0; k < sizeof(reduce_kernels) / sizeof(reduce_kernels[0]); k++) {
+        if (!bread_reduce_set_kernel(reduce_kernels[k])) continue;
+        if (bread_reduce_sum_i64(data->ints, data->n) != (int64_t)sum) return 0;
+        if (bread_reduce_prod_i64(data->ints, data->n) != (int64_t)prod) return 0;
+        if (bread_reduce_dot_i64(data->ints, data->other_ints, data->n) != (int64_t)dot) return 0;
+        if (bread_reduce_min_i64(data->ints, data->n) != lo) return 0;
+        if (bread_reduce_max_i64(data->ints, data->n) != hi) return 0;
+        if (!same_double(bread_reduce_mean_i64(data->ints, data->n), mean)) return 0;
+    }
+    return 1;
+}
+
+// Property: Double sums, products and dot products agree bit for bit
+// across kernels, and min/max are NaN exactly when an element is
+int property_double_reductions_agree(void* test_data) {
+    ReduceInput* data = (ReduceInput*)test_data;
+    int has_nan = 0;
+    double lo = INFINITY, hi = -INFINITY;
+    for (size_t i = 0; i < data->n; i++) {
+        if (data->doubles[i] != data->doubles[i]) has_nan = 1;
+        if (data->doubles[i] < lo) lo = data->doubles[i];
+        if (data->doubles[i] > hi) hi = data->doubles[i];
+    }
+
+    if (!bread_reduce_set_kernel("scalar")) return 0;
+    double sum = bread_reduce_sum_f64(data->doubles, data->n);
+    double prod = bread_reduce_prod_f64(data->doubles, data->n);
+    double dot = bread_reduce_dot_f64(data->doubles, data->other_doubles, data->n);
+    double mean = bread_reduce_mean_f64(data->doubles, data->n);
+    if (has_nan && (sum == sum || mean == mean)) return 0;
+
+    for (size_t k = 0; k < sizeof(reduce_kernels) / sizeof(reduce_kernels[0]); k++) {
+        if (!bread_reduce_set_kernel(reduce_kernels[k])) continue;
+        if (!same_double(bread_reduce_sum_f64(data->doubles, data->n), sum)) return 0;
+        if (!same_double(bread_reduce_prod_f64(data->doubles, data->n), prod)) return 0;
+        if (!same_double(bread_reduce_dot_f64(data->doubles, data->other_doubles, data->n), dot)) return 0;
+        if (!same_double(bread_reduce_mean_f64(data->doubles, data->n), mean)) return 0;
+
+        double got_lo = bread_reduce_min_f64(data->doubles, data->n);
+        double got_hi = bread_reduce_max_f64(data->doubles, data->n);
+        if (has_nan) {
+            if (got_lo == got_lo || got_hi == got_hi) return 0;
+        } else if (got_lo != lo || got_hi != hi) {
+            return 0;  // == so that -0.0 and 0.0 count as the same minimum
+        }
+    }
+    return 1;
+}
+
+int run_array_reduce_tests() {
+    printf("Running Array Reduction Property Tests (%s kernel by default)\n", bread_reduce_kernel());
+    printf("===============================================================\n\n");
+
+    int all_passed = 1;
+
+    PBTResult result1 = pbt_run_property(
+        "Int reductions match a wrapping loop",
+        generate_reduce_input,
+        property_int_reductions_match_loop,
+        cleanup_reduce_input,
+        ARRAY_REDUCE_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-array-reductions", 1,
+                     "Int reductions match a wrapping loop", result1);
+
+    if (result1.failed > 0) all_passed = 0;
+
+    PBTResult result2 = pbt_run_property(
+        "Double reductions agree across kernels",
+        generate_reduce_input,
+        property_double_reductions_agree,
+        cleanup_reduce_input,
+        ARRAY_REDUCE_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-array-reductions", 2,
+                     "Double reductions agree across kernels", result2);
+
+    if (result2.failed > 0) all_passed = 0;
+
+    pbt_free_result(&result1);
+    pbt_free_result(&result2);
+
+    return all_passed;
+}
+
+int main() {
+    return run_array_reduce_tests() ? 0 : 1;
+}
@@ -0,0 +1,368 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../framework/pbt_framework.h"
+#include "runtime/runtime.h"
+#include "runtime/memory.h"
+#include "core/value.h"
+
+#define BACKING_ITERATIONS 500
+#define BACKING_MAX_OPS 120
+#define BACKING_MAX_BUFFERS 32
+#define BACKING_MAX_SIZE 8192
+#define BACKING_COLLECTIONS 6
+#define BACKING_GC_BYTES (1024 * 1024) // the default bytes_threshold
+#define BACKING_GC_ITERATIONS PBT_MIN_ITERATIONS
+
+typedef enum {
+    OP_ALLOC,
+    OP_REALLOC, // from NULL too, with a stale size that must be ignored
+    OP_FREE,
+    OP_APPEND,
+    OP_INSERT_FRONT,
+    OP_REMOVE,
+    OP_SLICE,   // replaces a collection with a view of part of it
+    OP_BOX,
+    OP_DICT_SET,
+    OP_COUNT
+} BackingOpKind;
+
+typedef struct {
+    BackingOpKind kind;
+    int pick;
+    size_t size;
+    int zeroed;
+} BackingOp;
+
+typedef struct {
+    int op_count;
+    BackingOp ops[BACKING_MAX_OPS];
+    int piece_count;          // backing buffers that push past the GC threshold
+    size_t pieces[BACKING_MAX_OPS];
+} BackingInput;
+
+typedef struct {
+    uint8_t* ptr;
+    size_t size;
+    uint8_t fill;
+} Buffer;
+
+void* generate_backing_input(PBTGenerator* gen) {
+    BackingInput* data = malloc(sizeof(BackingInput));
+    if (!data) return NULL;
+    data->op_count = pbt_random_int(gen, 1, BACKING_MAX_OPS + 1);
+    for (int i = 0; i < data->op_count; i++) {
+        data->ops[i].kind = (BackingOpKind)pbt_random_int(gen, 0, OP_COUNT);
+        data->ops[i].pick = pbt_random_int(gen, 0, 256);
+        data->ops[i].size = (size_t)pbt_random_int(gen, 1, BACKING_MAX_SIZE + 1);
+        data->ops[i].zeroed = pbt_random_int(gen, 0, 2);
+    }
+    // enough pieces to cross the threshold however they are sized
+    data->piece_count = pbt_random_int(gen, 1, BACKING_MAX_OPS + 1);
+    size_t each = BACKING_GC_BYTES / (size_t)data->piece_count + 1;
+    for (int i = 0; i < data->piece_count; i++) {
+        data->pieces[i] = each + (size_t)pbt_random_int(gen, 0, (int)each + 1);
+    }
+    return data;
+}
+
+void cleanup_backing_input(void* test_data) {
+    free(test_data);
+}
+
+// Each case starts with no backing stores and nothing since the last
+// collection
+static void fresh_heap(void) {
+    bread_memory_cleanup();
+    bread_memory_init();
+}
+
+static int buffer_intact(const Buffer* b, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        if (b->ptr[i] != b->fill) return 0;
+    }
+    return 1;
+}
+
+// Property: backing_bytes always equals the bytes held in live buffers,
+// through allocations, reallocations (from NULL too) and frees;
+// peak_backing_bytes is the highest it has been; zeroed buffers are
+// zero and reallocation keeps the kept prefix
+int property_backing_matches_model(void* test_data) {
+    BackingInput* data = (BackingInput*)test_data;
+    fresh_heap();
+    BreadMemoryStats before = bread_memory_get_stats();
+    Buffer buffers[BACKING_MAX_BUFFERS];
+    int count = 0;
+    size_t held = 0;
+    size_t peak = before.peak_backing_bytes;
+    int ok = 1;
+
+    for (int i = 0; i < data->op_count && ok; i++) {
+        const BackingOp* op = &data->ops[i];
+        BackingOpKind kind = (BackingOpKind)(op->kind % 3);
+        if (count == 0 && kind == OP_FREE) kind = OP_ALLOC;
+        if (count == BACKING_MAX_BUFFERS && kind == OP_ALLOC) kind = OP_FREE;
+        Buffer* b = count ? &buffers[op->pick % count] : NULL;
+
+        switch (kind) {
+            case OP_ALLOC:
+            case OP_REALLOC: {
+                int from_null = kind == OP_ALLOC || b == NULL || (op->zeroed && count < BACKING_MAX_BUFFERS);
+                if (from_null && count == BACKING_MAX_BUFFERS) break;
+                Buffer* target = from_null ? &buffers[count] : b;
+                size_t old_size = from_null ? 0 : target->size;
+                uint8_t* ptr = kind == OP_ALLOC ? bread_memory_alloc_backing(op->size, op->zeroed)
+                               : from_null      ? bread_memory_realloc_backing(NULL, (size_t)op->pick, op->size)
+                                                : bread_memory_realloc_backing(target->ptr, old_size, op->size);
+                ok = ptr != NULL;
+                if (!ok) break;
+                if (kind == OP_ALLOC && op->zeroed) {
+                    for (size_t j = 0; j < op->size && ok; j++) ok = ptr[j] == 0;
+                }
+                if (!from_null) {
+                    Buffer moved = {ptr, target->size, target->fill};
+                    ok = ok && buffer_intact(&moved, old_size < op->size ? old_size : op->size);
+                }
+                target->ptr = ptr;
+                target->size = op->size;
+                target->fill = (uint8_t)(i + 1);
+                memset(ptr, target->fill, op->size);
+                held += op->size;
+                held -= old_size;
+                if (from_null) count++;
+                break;
+            }
+            default:
+                bread_memory_free_backing(b->ptr, b->size);
+                held -= b->size;
+                *b = buffers[--count];
+                break;
+        }
+
+        BreadMemoryStats now = bread_memory_get_stats();
+        if (before.backing_bytes + held > peak) peak = before.backing_bytes + held;
+        ok = ok && now.backing_bytes == before.backing_bytes + held && now.peak_backing_bytes == peak;
+        for (int j = 0; j < count && ok; j++) ok = buffer_intact(&buffers[j], buffers[j].size);
+    }
+
+    for (int j = 0; j < count; j++) bread_memory_free_backing(buffers[j].ptr, buffers[j].size);
+    return ok && bread_memory_get_stats().backing_bytes == before.backing_bytes;
+}
+
+typedef struct {
+    void* ptr;
+    int is_dict;
+    int strings; // array of strings, so its elements stay boxed
+    int next_key;
+} Collection;
+
+static BreadValue element(const Collection* c, int i) {
+    BreadValue v;
+    if (c->strings) {
+        char text[32];
+        snprintf(text, sizeof(text), "element-%d", i);
+        bread_value_set_string(&v, text);
+    } else {
+        bread_value_set_int(&v, i);
+    }
+    return v;
+}
+
+// What the live collections must at least hold in backing stores
+static size_t backing_floor(const Collection* collections) {
+    size_t floor = 0;
+    for (int c = 0; c < BACKING_COLLECTIONS; c++) {
+        if (collections[c].is_dict) {
+            floor += (size_t)((BreadDict*)collections[c].ptr)->count * sizeof(BreadDictEntry);
+        } else {
+            BreadArray* a = collections[c].ptr;
+            if (!a->base) floor += (size_t)a->count * sizeof(int64_t); // views share their base's
+        }
+    }
+    return floor;
+}
+
+static void release_collection(Collection* c) {
+    if (c->is_dict) bread_dict_release(c->ptr);
+    else bread_array_release(c->ptr);
+}
+
+// Property: arrays and dicts charge their items and entries to
+// backing_bytes as they grow, shift, box, slice and copy on write, never
+// fall below what they hold, keep the peak at or above the current
+// figure, and give every byte back once released
+int property_collections_return_backing(void* test_data) {
+    BackingInput* data = (BackingInput*)test_data;
+    fresh_heap();
+    size_t baseline = bread_memory_get_stats().backing_bytes;
+    Collection collections[BACKING_COLLECTIONS];
+    for (int c = 0; c < BACKING_COLLECTIONS; c++) {
+        collections[c].is_dict = c % 3 == 2;
+        collections[c].strings = c % 3 == 1;
+        collections[c].next_key = 0;
+        collections[c].ptr = collections[c].is_dict ? (void*)bread_dict_new() : (void*)bread_array_new();
+        if (!collections[c].ptr) return 0;
+    }
+    int ok = 1;
+
+    for (int i = 0; i < data->op_count && ok; i++) {
+        const BackingOp* op = &data->ops[i];
+        Collection* c = &collections[op->pick % BACKING_COLLECTIONS];
+        BackingOpKind kind = op->kind;
+        if (kind < OP_APPEND) kind = c->is_dict ? OP_DICT_SET : OP_APPEND;
+        if (c->is_dict) kind = OP_DICT_SET;
+        else if (kind == OP_DICT_SET) kind = OP_INSERT_FRONT;
+        BreadArray* a = c->ptr;
+        if ((kind == OP_REMOVE || kind == OP_SLICE) && a->count == 0) kind = OP_APPEND;
+
+        switch (kind) {
+            case OP_APPEND: {
+                // a burst, so items grow through several capacities
+                int n = 1 + (int)(op->size % 40);
+                for (int j = 0; j < n && ok; j++) {
+                    BreadValue v = element(c, a->count);
+                    ok = bread_array_append(a, v);
+                    bread_value_release(&v);
+                }
+                break;
+            }
+            case OP_INSERT_FRONT: {
+                BreadValue v = element(c, a->count);
+                ok = bread_array_insert(a, v, 0);
+                bread_value_release(&v);
+                break;
+            }
+            case OP_REMOVE: {
+                BreadValue v = bread_array_remove_at(a, op->size % (size_t)a->count);
+                bread_value_release(&v);
+                break;
+            }
+            case OP_SLICE: {
+                int start = (int)(op->size % (size_t)a->count);
+                BreadArray* view = bread_array_slice(a, start, a->count);
+                ok = view != NULL;
+                if (!ok) break;
+                bread_array_release(a);
+                c->ptr = view;
+                break;
+            }
+            case OP_BOX:
+                ok = a->count == 0 || bread_array_box(a);
+                break;
+            default: {
+                int n = 1 + (int)(op->size % 24);
+                for (int j = 0; j < n && ok; j++) {
+                    char key[32];
+                    snprintf(key, sizeof(key), "k%d", c->next_key++);
+                    BreadValue v;
+                    bread_value_set_int(&v, j);
+                    ok = bread_dict_set(c->ptr, key, v);
+                }
+                break;
+            }
+        }
+
+        BreadMemoryStats now = bread_memory_get_stats();
+        ok = ok && now.backing_bytes >= baseline + backing_floor(collections) &&
+             now.peak_backing_bytes >= now.backing_bytes;
+    }
+
+    for (int c = 0; c < BACKING_COLLECTIONS; c++) release_collection(&collections[c]);
+    bread_memory_collect_cycles();
+    return ok && bread_memory_get_stats().backing_bytes == baseline;
+}
+
+// Property: backing growth alone counts towards the collection trigger,
+// so a buffered garbage cycle is reclaimed before a megabyte of new
+// backing stores has been handed out
+int property_backing_growth_triggers_collection(void* test_data) {
+    BackingInput* data = (BackingInput*)test_data;
+    fresh_heap();
+    size_t baseline = bread_memory_get_stats().current_objects;
+
+    BreadArray* x = bread_array_new();
+    BreadArray* y = bread_array_new();
+    if (!x || !y) return 0;
+    BreadValue vx = {.type = TYPE_ARRAY};
+    BreadValue vy = {.type = TYPE_ARRAY};
+    vx.value.array_val = x;
+    vy.value.array_val = y;
+    int ok = bread_array_append(x, vy) && bread_array_append(y, vx);
+    bread_array_release(x);
+    bread_array_release(y);
+    ok = ok && bread_memory_get_stats().current_objects == baseline + 2;
+
+    void* pieces[BACKING_MAX_OPS];
+    int count = 0;
+    for (int i = 0; i < data->piece_count && ok; i++) {
+        pieces[i] = bread_memory_alloc_backing(data->pieces[i], 0);
+        ok = pieces[i] != NULL;
+        if (ok) count++;
+    }
+    ok = ok && bread_memory_get_stats().current_objects == baseline;
+
+    for (int i = 0; i < count; i++) bread_memory_free_backing(pieces[i], data->pieces[i]);
+    bread_memory_collect_cycles();
+    return ok && bread_memory_get_stats().current_objects == baseline;
+}
+
+int run_backing_tests() {
+    printf("Running Backing Store Property Tests\n");
+    printf("====================================\n\n");
+
+    int all_passed = 1;
+
+    PBTResult result1 = pbt_run_property(
+        "backing_bytes matches the buffers held",
+        generate_backing_input,
+        property_backing_matches_model,
+        cleanup_backing_input,
+        BACKING_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-backing", 1,
+                     "backing_bytes matches the buffers held", result1);
+
+    if (result1.failed > 0) all_passed = 0;
+
+    PBTResult result2 = pbt_run_property(
+        "Collections give back every backing byte",
+        generate_backing_input,
+        property_collections_return_backing,
+        cleanup_backing_input,
+        BACKING_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-backing", 2,
+                     "Collections give back every backing byte", result2);
+
+    if (result2.failed > 0) all_passed = 0;
+
+    PBTResult result3 = pbt_run_property(
+        "Backing growth triggers cycle collection",
+        generate_backing_input,
+        property_backing_growth_triggers_collection,
+        cleanup_backing_input,
+        BACKING_GC_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-backing", 3,
+                     "Backing growth triggers cycle collection", result3);
+
+    if (result3.failed > 0) all_passed = 0;
+
+    pbt_free_result(&result1);
+    pbt_free_result(&result2);
+    pbt_free_result(&result3);
+
+    return all_passed;
+}
+
+int main() {
+    bread_memory_init();
+    int passed = run_backing_tests();
+    bread_memory_cleanup();
+    return passed ? 0 : 1;
+}
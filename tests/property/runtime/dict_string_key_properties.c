@@ -0,0 +1,200 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../framework/pbt_framework.h"
+#include "runtime/runtime.h"
+#include "runtime/memory.h"
+#include "core/value.h"
+
+#define DICT_KEY_ITERATIONS 1000
+#define DICT_KEY_TEXTS 8
+#define DICT_KEY_MAX_LEN 40
+#define DICT_KEY_MAX_OPS 64
+
+// The ways compiled code can hold a string key
+typedef enum {
+    KEY_INTERNED,   // bread_string_new_literal
+    KEY_EMITTED,    // immortal object from cg_get_string_object
+    KEY_RUNTIME,    // tracked heap string
+    KEY_YOUNG,      // statement temporary
+    KEY_YOUNG_VIEW, // slice of a tracked string, still young
+    KEY_VIEW,       // promoted slice of a tracked string
+    KEY_CONCAT,     // built from two halves
+    KEY_KIND_COUNT
+} KeyKind;
+
+typedef struct {
+    int text;
+    KeyKind kind;
+    int is_set;
+} DictOp;
+
+typedef struct {
+    char texts[DICT_KEY_TEXTS][DICT_KEY_MAX_LEN + 1];
+    int op_count;
+    DictOp ops[DICT_KEY_MAX_OPS];
+} DictKeyInput;
+
+// Texts from 0 to 40 bytes over a small alphabet, so short strings, small
+// heap strings and views all appear and several texts share a length
+void* generate_dict_key_input(PBTGenerator* gen) {
+    DictKeyInput* data = malloc(sizeof(DictKeyInput));
+    if (!data) return NULL;
+    for (int t = 0; t < DICT_KEY_TEXTS; t++) {
+        int len = pbt_random_int(gen, 0, 3) ? pbt_random_int(gen, 0, DICT_KEY_MAX_LEN + 1) : pbt_random_int(gen, 0, 3);
+        for (int i = 0; i < len; i++) data->texts[t][i] = (char)('a' + pbt_random_int(gen, 0, 3));
+        data->texts[t][len] = '\0';
+    }
+    data->op_count = pbt_random_int(gen, 1, DICT_KEY_MAX_OPS + 1);
+    for (int i = 0; i < data->op_count; i++) {
+        data->ops[i].text = pbt_random_int(gen, 0, DICT_KEY_TEXTS);
+        data->ops[i].kind = (KeyKind)pbt_random_int(gen, 0, KEY_KIND_COUNT);
+        data->ops[i].is_set = pbt_random_int(gen, 0, 2);
+    }
+    return data;
+}
+
+void cleanup_dict_key_input(void* test_data) {
+    free(test_data);
+}
+
+// Builds `text` as a key of the given kind. Returns a reference the
+// caller releases; emitted keys are immortal and are freed by the caller
+// once the dict that may hold them is gone.
+static BreadString* make_key(const char* text, KeyKind kind) {
+    size_t len = strlen(text);
+    switch (kind) {
+        case KEY_INTERNED:
+            return bread_string_new_literal(text);
+        case KEY_EMITTED: {
+            BreadString* s = calloc(1, sizeof(BreadString) + len + 1);
+            if (!s) return NULL;
+            s->header.kind = BREAD_OBJ_STRING;
+            s->header.refcount = BREAD_REFCOUNT_IMMORTAL;
+            s->len = len;
+            s->hash = bread_hash_bytes(text, len);
+            s->flags = len <= BREAD_STRING_SMALL_MAX ? BREAD_STRING_SMALL : 0;
+            memcpy(s->data, text, len);
+            return s;
+        }
+        case KEY_RUNTIME:
+            return bread_string_new_len(text, len);
+        case KEY_YOUNG:
+            return bread_string_new_young(text);
+        case KEY_YOUNG_VIEW:
+        case KEY_VIEW: {
+            char padded[DICT_KEY_MAX_LEN + 8];
+            snprintf(padded, sizeof(padded), "[[%s]]", text);
+            BreadString* parent = bread_string_new(padded);
+            BreadString* slice = bread_string_slice(parent, 2, 2 + len);
+            BreadString* out = kind == KEY_VIEW ? bread_string_promote(slice) : slice;
+            bread_string_release(parent);
+            return out;
+        }
+        default: {
+            BreadString* left = bread_string_new_len(text, len / 2);
+            BreadString* right = bread_string_new_len(text + len / 2, len - len / 2);
+            BreadString* out = bread_string_concat(left, right);
+            bread_string_release(left);
+            bread_string_release(right);
+            return out;
+        }
+    }
+}
+
+// Property: however a key was built, it hashes like every other string
+// with its bytes, sets overwrite the entry any other kind of key made,
+// and gets find it, both by BreadString and by C string
+int property_key_kinds_are_interchangeable(void* test_data) {
+    DictKeyInput* data = (DictKeyInput*)test_data;
+    BreadDict* d = bread_dict_new_typed(TYPE_STRING, TYPE_INT);
+    if (!d) return 0;
+    // texts can repeat, so the model is indexed by each text's first copy
+    int canonical[DICT_KEY_TEXTS];
+    for (int t = 0; t < DICT_KEY_TEXTS; t++) {
+        canonical[t] = t;
+        for (int u = t - 1; u >= 0; u--) {
+            if (strcmp(data->texts[u], data->texts[t]) == 0) canonical[t] = u;
+        }
+    }
+    int64_t model[DICT_KEY_TEXTS];
+    int present[DICT_KEY_TEXTS] = {0};
+    BreadString* emitted[DICT_KEY_MAX_OPS];
+    int emitted_count = 0;
+    int ok = 1;
+
+    for (int i = 0; i < data->op_count && ok; i++) {
+        const DictOp* op = &data->ops[i];
+        const char* text = data->texts[op->text];
+        int slot = canonical[op->text];
+        size_t mark = bread_memory_nursery_mark();
+        BreadString* key = make_key(text, op->kind);
+        if (key && op->kind == KEY_EMITTED) emitted[emitted_count++] = key;
+        BreadString* plain = bread_string_new(text);
+        ok = key && plain;
+
+        BreadValue kv = {.type = TYPE_STRING};
+        BreadValue pv = {.type = TYPE_STRING};
+        kv.value.string_val = key;
+        pv.value.string_val = plain;
+        ok = ok && bread_dict_hash_key(kv) == bread_dict_hash_key(pv);
+
+        if (ok && op->is_set) {
+            BreadValue v = {.type = TYPE_INT};
+            v.value.int_val = i;
+            ok = bread_dict_set_string(d, key, v);
+            model[slot] = i;
+            present[slot] = 1;
+        } else if (ok) {
+            BreadValue* by_key = bread_dict_get_string(d, key);
+            BreadValue* by_cstr = bread_dict_get(d, text);
+            ok = present[slot] ? by_key && by_cstr == by_key && by_key->value.int_val == model[slot]
+                               : !by_key && !by_cstr;
+        }
+
+        if (key && op->kind != KEY_EMITTED) bread_string_release(key);
+        if (plain) bread_string_release(plain);
+        bread_memory_nursery_reset(mark);
+    }
+
+    int expected_count = 0;
+    for (int t = 0; t < DICT_KEY_TEXTS; t++) expected_count += present[t];
+    ok = ok && bread_dict_count(d) == expected_count;
+
+    bread_dict_release(d);
+    for (int i = 0; i < emitted_count; i++) free(emitted[i]);
+    return ok;
+}
+
+int run_dict_string_key_tests() {
+    printf("Running Dictionary String Key Property Tests\n");
+    printf("============================================\n\n");
+
+    int all_passed = 1;
+
+    PBTResult result1 = pbt_run_property(
+        "Interned, emitted, runtime and view keys are interchangeable",
+        generate_dict_key_input,
+        property_key_kinds_are_interchangeable,
+        cleanup_dict_key_input,
+        DICT_KEY_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-dict-string-keys", 1,
+                     "Interned, emitted, runtime and view keys are interchangeable", result1);
+
+    if (result1.failed > 0) all_passed = 0;
+
+    pbt_free_result(&result1);
+
+    return all_passed;
+}
+
+int main() {
+    bread_memory_init();
+    int passed = run_dict_string_key_tests();
+    bread_string_intern_cleanup();
+    bread_memory_cleanup();
+    return passed ? 0 : 1;
+}
@@ -1,79 +1,323 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include "../framework/pbt_framework.h"
+#include "runtime/runtime.h"
 #include "runtime/memory.h"
 #include "core/value.h"
-#include <stdio.h>
-#include <stdlib.h>
 
-// Property: Garbage collection should not crash with cyclic references
-static bool test_gc_cyclic_references(void) {
-    bread_memory_init();
-    
-    // Create circular reference
-    BreadValue* arr1 = bread_value_create_array();
-    BreadValue* arr2 = bread_value_create_array();
-    
-    if (!arr1 || !arr2) return false;
-    
-    bread_value_array_append(arr1, arr2);
-    bread_value_array_append(arr2, arr1);
-    
-    // Should handle cleanup without crashing
-    bread_value_free(arr1);
-    bread_value_free(arr2);
-    
-    bread_memory_cleanup();
-    return true;
+#define GC_ITERATIONS 300
+#define GC_MAX_RINGS 24
+#define GC_MAX_RING_LENGTH 12
+#define GC_MAX_RING_OBJECTS (2 * GC_MAX_RING_LENGTH) // members and the owners of sliced ones
+#define GC_MAX_SLICE_BUDGET 32
+#define GC_PARALLEL_ITERATIONS PBT_MIN_ITERATIONS // each case builds a 65536-object heap twice
+#define GC_PARALLEL_MIN_OBJECTS 65536 // BREAD_GC_PARALLEL_MIN_OBJECTS
+#define GC_PARALLEL_THREADS 4
+#define GC_MAX_STAR 20000
+
+typedef struct {
+    int length;
+    int use_classes; // ring of class instances instead of arrays
+    int live;        // one member stays referenced from outside
+    int sliced;      // array members are sliced, so the ring runs through
+                     // the owners of their shared storage
+} RingSpec;
+
+typedef struct {
+    int ring_count;
+    RingSpec rings[GC_MAX_RINGS];
+    size_t slice_budget; // objects per incremental slice
+    int star_size;       // arrays pointing back at one hub, for parallel marking
+    int star_live;
+} GcInput;
+
+typedef struct {
+    void* members[GC_MAX_RING_LENGTH];
+    int length;
+    int use_classes;
+    int owners; // storage owners made by slicing members
+    void* held; // external reference to a live ring, or NULL
+} Ring;
+
+void* generate_gc_input(PBTGenerator* gen) {
+    GcInput* data = malloc(sizeof(GcInput));
+    if (!data) return NULL;
+    data->ring_count = pbt_random_int(gen, 1, GC_MAX_RINGS + 1);
+    for (int i = 0; i < data->ring_count; i++) {
+        data->rings[i].length = pbt_random_int(gen, 1, GC_MAX_RING_LENGTH + 1);
+        data->rings[i].use_classes = pbt_random_int(gen, 0, 2);
+        data->rings[i].live = pbt_random_int(gen, 0, 4) == 0;
+        data->rings[i].sliced = pbt_random_int(gen, 0, 2);
+    }
+    data->slice_budget = (size_t)pbt_random_int(gen, 1, GC_MAX_SLICE_BUDGET + 1);
+    data->star_size = pbt_random_int(gen, 1, GC_MAX_STAR + 1);
+    data->star_live = pbt_random_int(gen, 0, 2);
+    return data;
 }
 
-// Property: Memory allocation should be consistent
-static bool test_memory_allocation_consistency(void) {
+void cleanup_gc_input(void* test_data) {
+    free(test_data);
+}
+
+// Each case starts from an empty heap with no buffered roots and the
+// default, stop-the-world collector
+static void fresh_heap(void) {
+    bread_memory_cleanup();
     bread_memory_init();
-    
-    void* ptrs[100];
-    
-    // Allocate memory
-    for (int i = 0; i < 100; i++) {
-        ptrs[i] = bread_malloc(100);
-        if (!ptrs[i]) return false;
+}
+
+static BreadValue ring_value(const Ring* ring, void* member) {
+    BreadValue v = {.type = ring->use_classes ? TYPE_CLASS : TYPE_ARRAY};
+    if (ring->use_classes) v.value.class_val = member;
+    else v.value.array_val = member;
+    return v;
+}
+
+static void ring_release(const Ring* ring, void* member) {
+    if (ring->use_classes) bread_class_release(member);
+    else bread_array_release(member);
+}
+
+// Links each member to the next and drops the builder's references, which
+// buffers every member as a possible cycle root. A sliced array member
+// hands its elements to a hidden owner, so its link to the next member
+// goes through that owner.
+static int build_ring(const RingSpec* spec, Ring* ring) {
+    static char* names[] = {"next"};
+    ring->length = spec->length;
+    ring->use_classes = spec->use_classes;
+    ring->owners = 0;
+    ring->held = NULL;
+    for (int i = 0; i < ring->length; i++) {
+        ring->members[i] = ring->use_classes ? (void*)bread_class_new("Node", NULL, 1, names)
+                                             : (void*)bread_array_new();
+        if (!ring->members[i]) return 0;
     }
-    
-    // Free memory
-    for (int i = 0; i < 100; i++) {
-        bread_free(ptrs[i]);
+    for (int i = 0; i < ring->length; i++) {
+        BreadValue next = ring_value(ring, ring->members[(i + 1) % ring->length]);
+        if (ring->use_classes) bread_class_set_field(ring->members[i], "next", next);
+        else if (!bread_array_append(ring->members[i], next)) return 0;
     }
-    
-    bread_memory_cleanup();
-    return true;
+    for (int i = 0; i < ring->length && spec->sliced && !ring->use_classes; i++) {
+        BreadArray* slice = bread_array_slice(ring->members[i], 0, 1);
+        if (!slice) return 0;
+        ring->owners++;
+        bread_array_release(slice);
+    }
+    if (spec->live) ring->held = ring->members[0];
+    for (int i = 0; i < ring->length; i++) {
+        if (ring->members[i] != ring->held) ring_release(ring, ring->members[i]);
+    }
+    return 1;
+}
+
+static int build_rings(const GcInput* data, Ring* rings, size_t* live_objects) {
+    *live_objects = 0;
+    for (int i = 0; i < data->ring_count; i++) {
+        if (!build_ring(&data->rings[i], &rings[i])) return 0;
+        if (rings[i].held) *live_objects += (size_t)(rings[i].length + rings[i].owners);
+    }
+    return 1;
+}
+
+static void drop_live_rings(const GcInput* data, Ring* rings) {
+    for (int i = 0; i < data->ring_count; i++) {
+        if (rings[i].held) ring_release(&rings[i], rings[i].held);
+    }
+}
+
+static int live_rings_intact(const GcInput* data, const Ring* rings) {
+    for (int i = 0; i < data->ring_count; i++) {
+        if (!rings[i].held) continue;
+        for (int m = 0; m < rings[i].length; m++) {
+            if (bread_memory_object_size(rings[i].members[m]) == 0) return 0;
+            size_t expected = m == 0 ? 2 : 1; // the ring and the outside reference
+            if (bread_object_get_refcount(rings[i].members[m]) != expected) return 0;
+        }
+    }
+    return 1;
+}
+
+// Property: a full collection reclaims every unreachable ring of arrays,
+// sliced arrays or class instances and leaves referenced rings as they were
+int property_collection_reclaims_only_garbage(void* test_data) {
+    GcInput* data = (GcInput*)test_data;
+    fresh_heap();
+    size_t baseline = bread_memory_get_stats().current_objects;
+    Ring rings[GC_MAX_RINGS];
+    size_t live_objects = 0;
+    if (!build_rings(data, rings, &live_objects)) return 0;
+
+    bread_memory_collect_cycles();
+    int ok = bread_memory_get_stats().current_objects == baseline + live_objects &&
+             live_rings_intact(data, rings);
+
+    drop_live_rings(data, rings);
+    bread_memory_collect_cycles();
+    ok = ok && bread_memory_get_stats().current_objects == baseline;
+    return ok;
+}
+
+// Property: an incremental slice frees no more than its object budget
+// plus the rest of the last ring it started, records one pause, and
+// slices keep coming until all garbage is gone and live rings survive
+int property_incremental_slices_stay_in_budget(void* test_data) {
+    GcInput* data = (GcInput*)test_data;
+    fresh_heap();
+    size_t baseline = bread_memory_get_stats().current_objects;
+    Ring rings[GC_MAX_RINGS];
+    size_t live_objects = 0;
+    if (!build_rings(data, rings, &live_objects)) return 0;
+
+    bread_memory_set_incremental_gc(0, data->slice_budget);
+    int ok = 1;
+    int slices = 0;
+    BreadMemoryStats before = bread_memory_get_stats();
+    while (ok && before.current_objects > baseline + live_objects) {
+        bread_memory_gc_safepoint();
+        BreadMemoryStats after = bread_memory_get_stats();
+        size_t freed = before.current_objects - after.current_objects;
+        ok = after.current_objects <= before.current_objects &&
+             freed <= data->slice_budget + GC_MAX_RING_OBJECTS - 1 &&
+             after.gc_collections == before.gc_collections + 1 &&
+             ++slices <= GC_MAX_RINGS * GC_MAX_RING_OBJECTS;
+        before = after;
+    }
+
+    size_t pauses = 0;
+    for (int b = 0; b < BREAD_GC_PAUSE_BUCKETS; b++) pauses += before.gc_pause_histogram[b];
+    ok = ok && pauses == before.gc_collections && live_rings_intact(data, rings);
+
+    bread_memory_set_incremental_gc(0, 0);
+    drop_live_rings(data, rings);
+    bread_memory_collect_cycles();
+    ok = ok && bread_memory_get_stats().current_objects == baseline;
+    return ok;
+}
+
+// Builds the star and returns the hub if it is live, NULL once it is
+// garbage
+static int build_star(const GcInput* data, BreadArray** held) {
+    *held = NULL;
+    BreadArray* hub = bread_array_new();
+    if (!hub) return 0;
+    BreadValue hub_value = {.type = TYPE_ARRAY};
+    hub_value.value.array_val = hub;
+    for (int i = 0; i < data->star_size; i++) {
+        BreadArray* spoke = bread_array_new();
+        BreadValue spoke_value = {.type = TYPE_ARRAY};
+        spoke_value.value.array_val = spoke;
+        int ok = spoke && bread_array_append(spoke, hub_value) && bread_array_append(hub, spoke_value);
+        if (spoke) bread_array_release(spoke);
+        if (!ok) return 0;
+    }
+    if (data->star_live) *held = hub;
+    else bread_array_release(hub);
+    return 1;
+}
+
+// Collects the rings and the star on top of enough plain objects to
+// reach the parallel marking threshold, with the given marking threads.
+// Returns the objects the collection kept beyond the padding.
+static int collect_with_threads(const GcInput* data, int threads, size_t* survivors) {
+    fresh_heap();
+    bread_memory_set_gc_threads(threads);
+    size_t baseline = bread_memory_get_stats().current_objects;
+    void** padding = malloc(GC_PARALLEL_MIN_OBJECTS * sizeof(void*));
+    if (!padding) return 0;
+    int ok = 1;
+    for (int i = 0; i < GC_PARALLEL_MIN_OBJECTS && ok; i++) {
+        padding[i] = bread_memory_alloc(sizeof(BreadObjHeader), BREAD_OBJ_STRING);
+        ok = padding[i] != NULL;
+    }
+
+    Ring rings[GC_MAX_RINGS];
+    size_t live_objects = 0;
+    BreadArray* hub = NULL;
+    ok = ok && build_rings(data, rings, &live_objects) && build_star(data, &hub);
+    if (!ok) return 0;
+
+    bread_memory_collect_cycles();
+    *survivors = bread_memory_get_stats().current_objects - baseline - GC_PARALLEL_MIN_OBJECTS;
+    ok = live_rings_intact(data, rings) &&
+         (!hub || bread_object_get_refcount(hub) == (uint32_t)data->star_size + 1);
+
+    drop_live_rings(data, rings);
+    if (hub) bread_array_release(hub);
+    for (int i = 0; i < GC_PARALLEL_MIN_OBJECTS; i++) bread_memory_free(padding[i]);
+    free(padding);
+    bread_memory_collect_cycles();
+    ok = ok && bread_memory_get_stats().current_objects == baseline;
+    return ok;
+}
+
+// Property: on a heap past the parallel threshold, marking on several
+// threads keeps exactly the objects marking on one thread keeps, which
+// are the live rings and a live star
+int property_parallel_mark_matches_serial(void* test_data) {
+    GcInput* data = (GcInput*)test_data;
+    size_t expected = data->star_live ? (size_t)data->star_size + 1 : 0;
+    for (int i = 0; i < data->ring_count; i++) {
+        const RingSpec* spec = &data->rings[i];
+        if (!spec->live) continue;
+        // a sliced array ring keeps an owner per member too
+        expected += (size_t)spec->length * (spec->sliced && !spec->use_classes ? 2 : 1);
+    }
+
+    size_t serial = 0;
+    size_t parallel = 0;
+    int ok = collect_with_threads(data, 1, &serial) &&
+             collect_with_threads(data, GC_PARALLEL_THREADS, &parallel);
+    bread_memory_set_gc_threads(1);
+    return ok && serial == expected && parallel == expected;
 }
 
-// Property: Reference counting should work correctly
-static bool test_reference_counting(void) {
+int run_gc_tests() {
+    printf("Running Garbage Collection Property Tests\n");
+    printf("========================================\n\n");
+
+    struct {
+        const char* text;
+        pbt_property_fn property;
+    } properties[] = {
+        {"Collection reclaims unreachable cycles and keeps reachable ones", property_collection_reclaims_only_garbage},
+        {"Incremental slices stay within their budget and finish", property_incremental_slices_stay_in_budget},
+    };
+
+    int all_passed = 1;
+    for (size_t i = 0; i < sizeof(properties) / sizeof(properties[0]); i++) {
+        PBTResult result = pbt_run_property(
+            properties[i].text,
+            generate_gc_input,
+            properties[i].property,
+            cleanup_gc_input,
+            GC_ITERATIONS
+        );
+        pbt_report_result("breadlang-gc", (int)i + 1, properties[i].text, result);
+        if (result.failed > 0) all_passed = 0;
+        pbt_free_result(&result);
+    }
+
+    PBTResult parallel = pbt_run_property(
+        "Parallel marking keeps what serial marking keeps",
+        generate_gc_input,
+        property_parallel_mark_matches_serial,
+        cleanup_gc_input,
+        GC_PARALLEL_ITERATIONS
+    );
+    pbt_report_result("breadlang-gc", (int)(sizeof(properties) / sizeof(properties[0])) + 1,
+                     "Parallel marking keeps what serial marking keeps", parallel);
+    if (parallel.failed > 0) all_passed = 0;
+    pbt_free_result(&parallel);
+
+    return all_passed;
+}
+
+int main() {
     bread_memory_init();
-    
-    BreadValue* val = bread_value_create_int(42);
-    if (!val) return false;
-    
-    // Increment reference count
-    bread_value_retain(val);
-    bread_value_retain(val);
-    
-    // Decrement reference count
-    bread_value_release(val);
-    bread_value_release(val);
-    
-    // Final release should free
-    bread_value_release(val);
-    
+    int passed = run_gc_tests();
     bread_memory_cleanup();
-    return true;
-}
-
-int main(void) {
-    pbt_init("Garbage Collection Properties");
-    
-    pbt_property("GC handles cyclic references", test_gc_cyclic_references);
-    pbt_property("Memory allocation consistency", test_memory_allocation_consistency);
-    pbt_property("Reference counting correctness", test_reference_counting);
-    
-    return pbt_run();
-}
\ No newline at end of file
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,392 @@
+#define _DEFAULT_SOURCE // mincore and fork under -std=c11
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "../framework/pbt_framework.h"
+#include "runtime/runtime.h"
+#include "runtime/memory.h"
+#include "runtime/error.h"
+#include "core/value.h"
+
+#define MEMORY_POOL_ITERATIONS 500
+#define MEMORY_POOL_CHUNK_SIZE (64 * 1024)      // BREAD_POOL_CHUNK_SIZE
+#define MEMORY_POOL_CHUNK_HEADER_SIZE 64        // BREAD_POOL_CHUNK_HEADER_SIZE
+#define MEMORY_POOL_MAX_CHUNKS 6
+#define MEMORY_POOL_MAX_HELD 4096
+
+// bread_pool_class_sizes in memory.c
+static const size_t pool_classes[BREAD_POOL_CLASS_COUNT] = {
+    32, 48, 64, 96, 128, 192, 256, 384, 512
+};
+
+typedef struct {
+    int pool_class;   // never 0: a 32-byte block has no room past the node
+    size_t size;      // object bytes that round up to `pool_class`
+    int count;        // objects allocated, all in the first chunk
+    int* free_order;  // indices of the objects freed, in order
+    int free_count;
+} PoolInput;
+
+static size_t class_capacity(int pool_class) {
+    return (MEMORY_POOL_CHUNK_SIZE - MEMORY_POOL_CHUNK_HEADER_SIZE) / pool_classes[pool_class];
+}
+
+void* generate_pool_input(PBTGenerator* gen) {
+    PoolInput* data = malloc(sizeof(PoolInput));
+    if (!data) return NULL;
+    data->pool_class = pbt_random_int(gen, 1, BREAD_POOL_CLASS_COUNT);
+    size_t lowest = pool_classes[data->pool_class - 1] + 1 - sizeof(BreadObjectNode);
+    if (lowest < sizeof(BreadObjHeader)) lowest = sizeof(BreadObjHeader);
+    data->size = (size_t)pbt_random_int(gen, (int)lowest, (int)(pool_classes[data->pool_class] - sizeof(BreadObjectNode)) + 1);
+    data->count = pbt_random_int(gen, 1, (int)class_capacity(data->pool_class) + 1);
+
+    // a random prefix of a shuffle of the objects
+    data->free_order = malloc((size_t)data->count * sizeof(int));
+    if (!data->free_order) {
+        free(data);
+        return NULL;
+    }
+    for (int i = 0; i < data->count; i++) data->free_order[i] = i;
+    for (int i = data->count - 1; i > 0; i--) {
+        int j = pbt_random_int(gen, 0, i + 1);
+        int t = data->free_order[i];
+        data->free_order[i] = data->free_order[j];
+        data->free_order[j] = t;
+    }
+    data->free_count = pbt_random_int(gen, 0, data->count + 1);
+    return data;
+}
+
+void cleanup_pool_input(void* test_data) {
+    PoolInput* data = (PoolInput*)test_data;
+    free(data->free_order);
+    free(data);
+}
+
+// Starts each case from empty pools, so the first chunk of a class is the
+// one this case maps
+static void fresh_heap(void) {
+    bread_memory_cleanup();
+    bread_memory_init();
+}
+
+static uintptr_t chunk_of(const void* object) {
+    return (uintptr_t)object & ~(uintptr_t)(MEMORY_POOL_CHUNK_SIZE - 1);
+}
+
+// Property: an object lands in the smallest class whose block holds it
+// and its node, 16-byte aligned, and realloc keeps it in place exactly
+// while the new size still fits that block
+int property_objects_round_to_smallest_class(void* test_data) {
+    PoolInput* data = (PoolInput*)test_data;
+    fresh_heap();
+    size_t block = pool_classes[data->pool_class];
+    size_t room = block - sizeof(BreadObjectNode);
+
+    uint8_t* obj = bread_memory_alloc(data->size, BREAD_OBJ_STRING);
+    int ok = obj && ((uintptr_t)obj & 15) == 0 &&
+             (uintptr_t)obj - sizeof(BreadObjectNode) - chunk_of(obj) == MEMORY_POOL_CHUNK_HEADER_SIZE;
+    // a second object sits one block further on
+    uint8_t* next = bread_memory_alloc(data->size, BREAD_OBJ_STRING);
+    ok = ok && next && next == obj + block;
+
+    uint8_t* current = obj;
+    if (ok) {
+        current = bread_memory_realloc(obj, room);
+        ok = current == obj && bread_memory_object_size(current) == room;
+    }
+    if (ok) {
+        current = bread_memory_realloc(current, sizeof(BreadObjHeader));
+        ok = current == obj;
+    }
+    if (ok) {
+        current = bread_memory_realloc(current, room + 1);
+        ok = current && current != obj && bread_memory_object_size(current) == room + 1;
+    }
+
+    if (current) bread_memory_free(current);
+    if (next) bread_memory_free(next);
+    return ok;
+}
+
+// Property: blocks come from a chunk in address order, freed blocks are
+// reused last-freed first, and a chunk's blocks never overlap
+int property_freed_blocks_reused_lifo(void* test_data) {
+    PoolInput* data = (PoolInput*)test_data;
+    fresh_heap();
+    size_t block = pool_classes[data->pool_class];
+    uint8_t** objects = malloc((size_t)data->count * sizeof(uint8_t*));
+    if (!objects) return 0;
+    int ok = 1;
+    int allocated = 0;
+
+    for (int i = 0; i < data->count && ok; i++) {
+        objects[i] = bread_memory_alloc(data->size, BREAD_OBJ_STRING);
+        ok = objects[i] != NULL;
+        if (!ok) break;
+        allocated++;
+        ok = chunk_of(objects[i]) == chunk_of(objects[0]) &&
+             objects[i] == objects[0] + (size_t)i * block;
+    }
+
+    for (int i = 0; i < data->free_count && ok; i++) {
+        bread_memory_free(objects[data->free_order[i]]);
+    }
+    for (int i = data->free_count - 1; i >= 0 && ok; i--) {
+        uint8_t* again = bread_memory_alloc(data->size, BREAD_OBJ_STRING);
+        ok = again == objects[data->free_order[i]];
+    }
+
+    BreadMemoryStats stats = bread_memory_get_stats();
+    ok = ok && stats.current_objects == (size_t)allocated;
+    for (int i = 0; i < allocated; i++) bread_memory_free(objects[i]);
+    free(objects);
+    return ok;
+}
+
+typedef struct {
+    int pool_class;
+    int count;        // objects spread over up to MEMORY_POOL_MAX_CHUNKS chunks
+    int* free_order;
+    int retain_chunks;
+} RetentionInput;
+
+void* generate_retention_input(PBTGenerator* gen) {
+    RetentionInput* data = malloc(sizeof(RetentionInput));
+    if (!data) return NULL;
+    data->pool_class = pbt_random_int(gen, 1, BREAD_POOL_CLASS_COUNT);
+    data->count = pbt_random_int(gen, 1, MEMORY_POOL_MAX_CHUNKS * (int)class_capacity(data->pool_class) + 1);
+    data->retain_chunks = pbt_random_int(gen, 0, MEMORY_POOL_MAX_CHUNKS + 1);
+    data->free_order = malloc((size_t)data->count * sizeof(int));
+    if (!data->free_order) {
+        free(data);
+        return NULL;
+    }
+    for (int i = 0; i < data->count; i++) data->free_order[i] = i;
+    for (int i = data->count - 1; i > 0; i--) {
+        int j = pbt_random_int(gen, 0, i + 1);
+        int t = data->free_order[i];
+        data->free_order[i] = data->free_order[j];
+        data->free_order[j] = t;
+    }
+    return data;
+}
+
+void cleanup_retention_input(void* test_data) {
+    RetentionInput* data = (RetentionInput*)test_data;
+    free(data->free_order);
+    free(data);
+}
+
+// mincore fails with ENOMEM on a range that is not mapped
+static int chunks_unmapped(const uintptr_t* chunks, int count) {
+    int unmapped = 0;
+    unsigned char vec[MEMORY_POOL_CHUNK_SIZE / 4096];
+    for (int i = 0; i < count; i++) {
+        if (mincore((void*)chunks[i], MEMORY_POOL_CHUNK_SIZE, vec) != 0 && errno == ENOMEM) unmapped++;
+    }
+    return unmapped;
+}
+
+// Property: as chunks empty, the first ones up to the retention
+// watermark are kept and every later one is unmapped; lowering the
+// watermark to zero unmaps the kept ones too
+int property_empty_chunks_unmapped_past_retention(void* test_data) {
+    RetentionInput* data = (RetentionInput*)test_data;
+    fresh_heap();
+    bread_memory_set_pool_retention((size_t)data->retain_chunks * MEMORY_POOL_CHUNK_SIZE);
+    size_t size = pool_classes[data->pool_class] - sizeof(BreadObjectNode);
+    void** objects = malloc((size_t)data->count * sizeof(void*));
+    if (!objects) return 0;
+    uintptr_t chunks[MEMORY_POOL_MAX_CHUNKS];
+    int chunk_count = 0;
+    int allocated = 0;
+    int ok = 1;
+
+    for (int i = 0; i < data->count && ok; i++) {
+        objects[i] = bread_memory_alloc(size, BREAD_OBJ_STRING);
+        ok = objects[i] != NULL;
+        if (!ok) break;
+        allocated++;
+        if (chunk_count == 0 || chunks[chunk_count - 1] != chunk_of(objects[i])) {
+            ok = chunk_count < MEMORY_POOL_MAX_CHUNKS;
+            if (ok) chunks[chunk_count++] = chunk_of(objects[i]);
+        }
+    }
+    if (!ok) {
+        for (int i = 0; i < allocated; i++) bread_memory_free(objects[i]);
+        free(objects);
+        return 0;
+    }
+
+    size_t released_before = bread_memory_get_stats().chunks_released;
+    for (int i = 0; i < data->count; i++) bread_memory_free(objects[data->free_order[i]]);
+    free(objects);
+
+    int expected = chunk_count > data->retain_chunks ? chunk_count - data->retain_chunks : 0;
+    size_t released = bread_memory_get_stats().chunks_released - released_before;
+    ok = released == (size_t)expected && chunks_unmapped(chunks, chunk_count) == expected;
+
+    bread_memory_set_pool_retention(0);
+    released = bread_memory_get_stats().chunks_released - released_before;
+    ok = ok && released == (size_t)chunk_count && chunks_unmapped(chunks, chunk_count) == chunk_count;
+    return ok;
+}
+
+typedef struct {
+    size_t limit;
+    int cycle_length; // arrays in a garbage cycle made before filling up
+    size_t sizes[MEMORY_POOL_MAX_HELD];
+} HeapLimitInput;
+
+void* generate_heap_limit_input(PBTGenerator* gen) {
+    HeapLimitInput* data = malloc(sizeof(HeapLimitInput));
+    if (!data) return NULL;
+    data->limit = (size_t)pbt_random_int(gen, 8 * 1024, 128 * 1024 + 1);
+    data->cycle_length = pbt_random_int(gen, 0, 9);
+    for (int i = 0; i < MEMORY_POOL_MAX_HELD; i++) {
+        data->sizes[i] = (size_t)pbt_random_int(gen, 64, pbt_random_int(gen, 0, 3) ? 601 : 4001);
+    }
+    return data;
+}
+
+void cleanup_heap_limit_input(void* test_data) {
+    free(test_data);
+}
+
+static size_t live_bytes(void) {
+    BreadMemoryStats stats = bread_memory_get_stats();
+    return stats.bytes_allocated - stats.bytes_freed + stats.backing_bytes;
+}
+
+static void make_garbage_cycle(int length) {
+    if (length == 0) return;
+    BreadArray* first = bread_array_new();
+    BreadArray* prev = first;
+    for (int i = 1; i <= length; i++) {
+        BreadArray* next = i == length ? first : bread_array_new();
+        BreadValue v = {.type = TYPE_ARRAY};
+        v.value.array_val = next;
+        bread_array_append(prev, v);
+        if (prev != first) bread_array_release(prev);
+        prev = next;
+    }
+    bread_array_release(first);
+}
+
+// What the child filling the heap was doing when the limit failure
+// aborted it
+static size_t limit_baseline;
+static size_t limit_pending;
+static size_t limit_held;
+static size_t limit_bytes;
+
+static void on_limit_abort(int sig) {
+    (void)sig;
+    BreadMemoryStats stats = bread_memory_get_stats();
+    int ok = bread_error_get_type() == BREAD_ERROR_MEMORY_ALLOCATION &&
+             live_bytes() + limit_pending > limit_bytes &&
+             stats.current_objects == limit_baseline + limit_held;
+    _exit(ok ? 0 : 3);
+}
+
+// Property: live bytes never pass the limit; an allocation that would
+// pass it first collects garbage cycles, then fails with a memory error
+// (which aborts) holding only the objects allocated before it
+int property_heap_limit_fails_cleanly(void* test_data) {
+    HeapLimitInput* data = (HeapLimitInput*)test_data;
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) return 0;
+
+    if (pid == 0) {
+        if (!freopen("/dev/null", "w", stderr)) _exit(2);
+        fresh_heap();
+        limit_baseline = bread_memory_get_stats().current_objects;
+        make_garbage_cycle(data->cycle_length);
+        limit_bytes = data->limit;
+        bread_memory_set_heap_limit(data->limit);
+        signal(SIGABRT, on_limit_abort);
+        if (live_bytes() > data->limit) _exit(2);
+
+        for (limit_held = 0; limit_held < MEMORY_POOL_MAX_HELD; limit_held++) {
+            limit_pending = data->sizes[limit_held];
+            if (!bread_memory_alloc(limit_pending, BREAD_OBJ_STRING) ||
+                bread_error_has_error() || live_bytes() > data->limit) {
+                _exit(2);
+            }
+        }
+        _exit(4); // never reached the limit
+    }
+
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid) return 0;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int run_memory_pool_tests() {
+    printf("Running Memory Pool Property Tests\n");
+    printf("==================================\n\n");
+
+    struct {
+        const char* text;
+        pbt_property_fn property;
+    } properties[] = {
+        {"Objects round up to the smallest class that holds them", property_objects_round_to_smallest_class},
+        {"Freed blocks are reused last-freed first", property_freed_blocks_reused_lifo},
+    };
+    struct {
+        const char* text;
+        pbt_generator_fn generate;
+        pbt_property_fn property;
+        pbt_cleanup_fn cleanup;
+    } limits[] = {
+        {"Empty chunks past the retention watermark are unmapped", generate_retention_input,
+         property_empty_chunks_unmapped_past_retention, cleanup_retention_input},
+        {"The heap limit collects, then fails without growing the heap", generate_heap_limit_input,
+         property_heap_limit_fails_cleanly, cleanup_heap_limit_input},
+    };
+
+    int all_passed = 1;
+    for (size_t i = 0; i < sizeof(properties) / sizeof(properties[0]); i++) {
+        PBTResult result = pbt_run_property(
+            properties[i].text,
+            generate_pool_input,
+            properties[i].property,
+            cleanup_pool_input,
+            MEMORY_POOL_ITERATIONS
+        );
+        pbt_report_result("breadlang-memory-pool", (int)i + 1, properties[i].text, result);
+        if (result.failed > 0) all_passed = 0;
+        pbt_free_result(&result);
+    }
+    for (size_t i = 0; i < sizeof(limits) / sizeof(limits[0]); i++) {
+        PBTResult result = pbt_run_property(
+            limits[i].text,
+            limits[i].generate,
+            limits[i].property,
+            limits[i].cleanup,
+            MEMORY_POOL_ITERATIONS
+        );
+        int number = (int)(sizeof(properties) / sizeof(properties[0]) + i) + 1;
+        pbt_report_result("breadlang-memory-pool", number, limits[i].text, result);
+        if (result.failed > 0) all_passed = 0;
+        pbt_free_result(&result);
+    }
+
+    return all_passed;
+}
+
+int main() {
+    bread_memory_init();
+    int passed = run_memory_pool_tests();
+    bread_memory_cleanup();
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../framework/pbt_framework.h"
+#include "runtime/runtime.h"
+#include "runtime/memory.h"
+
+#define MEMORY_TRACKING_ITERATIONS 500
+#define MEMORY_TRACKING_MAX_OPS 200
+#define MEMORY_TRACKING_MAX_LIVE 64
+#define MEMORY_TRACKING_MAX_SIZE 2048
+
+typedef enum {
+    OP_ALLOC,
+    OP_FREE,
+    OP_REALLOC,
+    OP_RETRACK, // untrack twice, then track twice
+    OP_COUNT
+} TrackingOpKind;
+
+typedef struct {
+    TrackingOpKind kind;
+    int slot;    // which live object, modulo the live count
+    size_t size; // for alloc and realloc
+} TrackingOp;
+
+typedef struct {
+    int op_count;
+    TrackingOp ops[MEMORY_TRACKING_MAX_OPS];
+} TrackingInput;
+
+typedef struct {
+    uint8_t* ptr;
+    size_t size;
+    uint8_t fill;
+} LiveObject;
+
+// Sizes on both sides of the largest slab class and a few past it, so
+// pooled and malloc'd blocks both move through realloc
+static size_t random_size(PBTGenerator* gen) {
+    switch (pbt_random_int(gen, 0, 4)) {
+        case 0: return (size_t)pbt_random_int(gen, sizeof(BreadObjHeader), 64);
+        case 1: return (size_t)pbt_random_int(gen, 400, 560);
+        default: return (size_t)pbt_random_int(gen, sizeof(BreadObjHeader), MEMORY_TRACKING_MAX_SIZE + 1);
+    }
+}
+
+void* generate_tracking_input(PBTGenerator* gen) {
+    TrackingInput* data = malloc(sizeof(TrackingInput));
+    if (!data) return NULL;
+    data->op_count = pbt_random_int(gen, 1, MEMORY_TRACKING_MAX_OPS + 1);
+    for (int i = 0; i < data->op_count; i++) {
+        data->ops[i].kind = (TrackingOpKind)pbt_random_int(gen, 0, OP_COUNT);
+        data->ops[i].slot = pbt_random_int(gen, 0, MEMORY_TRACKING_MAX_LIVE);
+        data->ops[i].size = random_size(gen);
+    }
+    return data;
+}
+
+void cleanup_tracking_input(void* test_data) {
+    free(test_data);
+}
+
+// Everything past the object header holds the object's fill byte
+static void fill_object(LiveObject* obj) {
+    memset(obj->ptr + sizeof(BreadObjHeader), obj->fill, obj->size - sizeof(BreadObjHeader));
+}
+
+static int object_intact(const LiveObject* obj) {
+    if (bread_memory_object_size(obj->ptr) != obj->size) return 0;
+    const BreadObjectNode* node = (const BreadObjectNode*)obj->ptr - 1;
+    if (node->next->prev != node || node->prev->next != node || node->size != obj->size) return 0;
+    for (size_t i = sizeof(BreadObjHeader); i < obj->size; i++) {
+        if (obj->ptr[i] != obj->fill) return 0;
+    }
+    return 1;
+}
+
+// Property: through any mix of allocations, frees and reallocations the
+// live objects keep their sizes and bytes, their nodes stay linked, and
+// the object and byte counts match the model
+int property_tracking_matches_model(void* test_data) {
+    TrackingInput* data = (TrackingInput*)test_data;
+    BreadMemoryStats before = bread_memory_get_stats();
+    LiveObject live[MEMORY_TRACKING_MAX_LIVE];
+    int live_count = 0;
+    size_t live_bytes = 0;
+    int ok = 1;
+
+    for (int i = 0; i < data->op_count && ok; i++) {
+        const TrackingOp* op = &data->ops[i];
+        TrackingOpKind kind = op->kind;
+        if (live_count == 0) kind = OP_ALLOC;
+        if (live_count == MEMORY_TRACKING_MAX_LIVE && kind == OP_ALLOC) kind = OP_FREE;
+        LiveObject* obj = live_count ? &live[op->slot % live_count] : NULL;
+
+        switch (kind) {
+            case OP_ALLOC: {
+                LiveObject* fresh = &live[live_count];
+                fresh->ptr = bread_memory_alloc(op->size, BREAD_OBJ_STRING);
+                fresh->size = op->size;
+                fresh->fill = (uint8_t)(i + 1);
+                ok = fresh->ptr != NULL;
+                if (ok) {
+                    fill_object(fresh);
+                    live_count++;
+                    live_bytes += op->size;
+                }
+                break;
+            }
+            case OP_FREE:
+                bread_memory_free(obj->ptr);
+                live_bytes -= obj->size;
+                *obj = live[--live_count];
+                break;
+            case OP_REALLOC: {
+                uint8_t* moved = bread_memory_realloc(obj->ptr, op->size);
+                ok = moved != NULL;
+                if (!ok) break;
+                // the kept prefix must survive; refill so a grown tail is checked too
+                size_t kept = op->size < obj->size ? op->size : obj->size;
+                for (size_t b = sizeof(BreadObjHeader); b < kept && ok; b++) ok = moved[b] == obj->fill;
+                for (size_t b = kept; b < op->size && ok; b++) ok = moved[b] == 0;
+                live_bytes += op->size;
+                live_bytes -= obj->size;
+                obj->ptr = moved;
+                obj->size = op->size;
+                fill_object(obj);
+                break;
+            }
+            default: {
+                BreadObjectNode* node = (BreadObjectNode*)obj->ptr - 1;
+                BreadMemoryStats mid = bread_memory_get_stats();
+                bread_memory_untrack_object(obj->ptr);
+                bread_memory_untrack_object(obj->ptr);
+                ok = node->next == node && node->prev == node &&
+                     bread_memory_get_stats().current_objects == mid.current_objects - 1;
+                bread_memory_track_object(obj->ptr, obj->size, BREAD_OBJ_STRING);
+                bread_memory_track_object(obj->ptr, obj->size, BREAD_OBJ_STRING);
+                ok = ok && bread_memory_get_stats().current_objects == mid.current_objects;
+                // untracking counted the bytes as freed and tracking does
+                // not count them back
+                before.bytes_freed += obj->size;
+                break;
+            }
+        }
+
+        BreadMemoryStats now = bread_memory_get_stats();
+        ok = ok && now.current_objects == before.current_objects + (size_t)live_count &&
+             now.bytes_allocated - now.bytes_freed == before.bytes_allocated - before.bytes_freed + live_bytes;
+        for (int j = 0; j < live_count && ok; j++) ok = object_intact(&live[j]);
+    }
+
+    for (int j = 0; j < live_count; j++) bread_memory_free(live[j].ptr);
+    ok = ok && bread_memory_get_stats().current_objects == before.current_objects;
+    return ok;
+}
+
+int run_memory_tracking_tests() {
+    printf("Running Memory Tracking Property Tests\n");
+    printf("======================================\n\n");
+
+    int all_passed = 1;
+
+    PBTResult result1 = pbt_run_property(
+        "Tracked objects match a model through alloc, free and realloc",
+        generate_tracking_input,
+        property_tracking_matches_model,
+        cleanup_tracking_input,
+        MEMORY_TRACKING_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-memory-tracking", 1,
+                     "Tracked objects match a model through alloc, free and realloc", result1);
+
+    if (result1.failed > 0) all_passed = 0;
+
+    pbt_free_result(&result1);
+
+    return all_passed;
+}
+
+int main() {
+    bread_memory_init();
+    int passed = run_memory_tracking_tests();
+    bread_memory_cleanup();
+    return passed ? 0 : 1;
+}
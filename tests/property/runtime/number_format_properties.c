@@ -0,0 +1,168 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "../framework/pbt_framework.h"
+#include "runtime/number_format.h"
+
+#define NUMBER_FORMAT_ITERATIONS 200000
+
+typedef struct {
+    double value;
+    int precision;  // for "%.<precision>g", including the snprintf fallbacks
+    int decimals;   // for "%.<decimals>f"
+    int64_t int_value;
+} NumberInput;
+
+static uint64_t random_bits(PBTGenerator* gen) {
+    return ((uint64_t)pbt_random_uint32(gen) << 32) | pbt_random_uint32(gen);
+}
+
+static double double_from_bits(uint64_t bits) {
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Any bit pattern, subnormals, signed zeros and infinities, NaNs, short
+// decimals (which sit on rounding halfway points at low precisions) and
+// neighbours of powers of ten
+static double random_double(PBTGenerator* gen) {
+    uint64_t bits = random_bits(gen);
+    switch (pbt_random_int(gen, 0, 10)) {
+        case 0: return double_from_bits(bits & 0x800FFFFFFFFFFFFFULL); // subnormal or zero
+        case 1: return pbt_random_int(gen, 0, 2) ? 0.0 : -0.0;
+        case 2: return pbt_random_int(gen, 0, 2) ? INFINITY : -INFINITY;
+        case 3: return double_from_bits(bits | 0x7FF0000000000001ULL); // NaN, either sign
+        case 4: return (double)pbt_random_int(gen, -100000, 100001) / pow(10, pbt_random_int(gen, 0, 7));
+        case 5: {
+            double p = pow(10, pbt_random_int(gen, -30, 31));
+            return pbt_random_int(gen, 0, 2) ? nextafter(p, 0) : nextafter(p, INFINITY);
+        }
+        case 6: return pbt_random_int(gen, 0, 2) ? DBL_MAX : DBL_MIN;
+        default: return double_from_bits(bits);
+    }
+}
+
+static int64_t random_int(PBTGenerator* gen) {
+    switch (pbt_random_int(gen, 0, 5)) {
+        case 0: return INT64_MIN + pbt_random_int(gen, 0, 3);
+        case 1: return INT64_MAX - pbt_random_int(gen, 0, 3);
+        case 2: return pbt_random_int(gen, -1000, 1001);
+        default: {
+            int64_t v = (int64_t)(random_bits(gen) >> pbt_random_int(gen, 1, 64));
+            return pbt_random_int(gen, 0, 2) ? -v : v;
+        }
+    }
+}
+
+void* generate_number_input(PBTGenerator* gen) {
+    NumberInput* data = malloc(sizeof(NumberInput));
+    if (!data) return NULL;
+    data->value = random_double(gen);
+    data->precision = pbt_random_int(gen, -1, 19);
+    data->decimals = pbt_random_int(gen, -1, 18);
+    data->int_value = random_int(gen);
+    return data;
+}
+
+void cleanup_number_input(void* test_data) {
+    free(test_data);
+}
+
+// Property: bread_format_double writes exactly what "%.<precision>g" does
+int property_format_double_matches_printf(void* test_data) {
+    NumberInput* data = (NumberInput*)test_data;
+    char expected[BREAD_FORMAT_MAX];
+    char actual[BREAD_FORMAT_MAX];
+    int expected_len = snprintf(expected, sizeof(expected), "%.*g", data->precision, data->value);
+    size_t len = bread_format_double(actual, data->value, data->precision);
+    return len == (size_t)expected_len && strcmp(actual, expected) == 0;
+}
+
+static int same_double(double a, double b) {
+    if (isnan(a) || isnan(b)) return isnan(a) && isnan(b) && signbit(a) == signbit(b);
+    return memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// Property: at every precision the text reads back through strtod to the
+// value printf's text reads back to, and at 17 digits to the value itself,
+// signed zero included
+int property_format_double_round_trips(void* test_data) {
+    NumberInput* data = (NumberInput*)test_data;
+    for (int precision = 1; precision <= 17; precision++) {
+        char buf[BREAD_FORMAT_MAX];
+        char expected[BREAD_FORMAT_MAX];
+        size_t len = bread_format_double(buf, data->value, precision);
+        snprintf(expected, sizeof(expected), "%.*g", precision, data->value);
+        char* end;
+        double back = strtod(buf, &end);
+        if (len != strlen(buf) || end != buf + len) return 0;
+        if (!same_double(back, strtod(expected, NULL))) return 0;
+        if (precision == 17 && !same_double(back, data->value)) return 0;
+    }
+    return 1;
+}
+
+// Property: bread_format_double_fixed writes exactly what "%.<decimals>f"
+// does, for values small enough that the output fits BREAD_FORMAT_MAX
+int property_format_double_fixed_matches_printf(void* test_data) {
+    NumberInput* data = (NumberInput*)test_data;
+    double value = data->value;
+    if (isfinite(value) && fabs(value) >= 1e300) value = ldexp(value, -900);
+    char expected[BREAD_FORMAT_MAX + 32];
+    char actual[BREAD_FORMAT_MAX + 32];
+    int expected_len = snprintf(expected, sizeof(expected), "%.*f", data->decimals, value);
+    if (expected_len >= BREAD_FORMAT_MAX) return 1;
+    size_t len = bread_format_double_fixed(actual, value, data->decimals);
+    return len == (size_t)expected_len && strcmp(actual, expected) == 0;
+}
+
+// Property: bread_format_int writes exactly what "%lld" does, INT64_MIN
+// included, and bread_format_int_length predicts its length
+int property_format_int_matches_printf(void* test_data) {
+    NumberInput* data = (NumberInput*)test_data;
+    char expected[32];
+    char actual[32];
+    int expected_len = snprintf(expected, sizeof(expected), "%lld", (long long)data->int_value);
+    size_t len = bread_format_int(actual, data->int_value);
+    return len == (size_t)expected_len && strcmp(actual, expected) == 0 &&
+           bread_format_int_length(data->int_value) == len;
+}
+
+int run_number_format_tests() {
+    printf("Running Number Formatting Property Tests\n");
+    printf("========================================\n\n");
+
+    struct {
+        const char* text;
+        pbt_property_fn property;
+    } properties[] = {
+        {"Double formatting matches %.*g", property_format_double_matches_printf},
+        {"Doubles round-trip through strtod at every precision", property_format_double_round_trips},
+        {"Fixed formatting matches %.*f", property_format_double_fixed_matches_printf},
+        {"Int formatting matches %lld", property_format_int_matches_printf},
+    };
+
+    int all_passed = 1;
+    for (size_t i = 0; i < sizeof(properties) / sizeof(properties[0]); i++) {
+        PBTResult result = pbt_run_property(
+            properties[i].text,
+            generate_number_input,
+            properties[i].property,
+            cleanup_number_input,
+            NUMBER_FORMAT_ITERATIONS
+        );
+        pbt_report_result("breadlang-number-formatting", (int)i + 1, properties[i].text, result);
+        if (result.failed > 0) all_passed = 0;
+        pbt_free_result(&result);
+    }
+
+    return all_passed;
+}
+
+int main() {
+    return run_number_format_tests() ? 0 : 1;
+}
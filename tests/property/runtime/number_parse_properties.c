@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "../framework/pbt_framework.h"
+#include "runtime/number_parse.h"
+
+#define NUMBER_PARSE_ITERATIONS 200000
+
+typedef struct {
+    char text[96];
+    int len;
+} NumberText;
+
+// Mix of doubles printed at every precision, fixed-point decimals and
+// random runs of number-like characters (most of which are not numbers)
+void* generate_number_text(PBTGenerator* gen) {
+    NumberText* data = malloc(sizeof(NumberText));
+    if (!data) return NULL;
+
+    uint64_t bits = ((uint64_t)pbt_random_uint32(gen) << 33) ^ ((uint64_t)pbt_random_uint32(gen) << 2) ^
+                    pbt_random_uint32(gen);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    if (value != value || value - value != 0) value = 1.5; // nan or inf
+
+    switch (pbt_random_int(gen, 0, 4)) {
+        case 0:
+            data->len = snprintf(data->text, sizeof(data->text), "%.*g", pbt_random_int(gen, 1, 18), value);
+            break;
+        case 1:
+            data->len = snprintf(data->text, sizeof(data->text), "%.*f", pbt_random_int(gen, 0, 9),
+                                 (double)pbt_random_uint32(gen) / (1 + pbt_random_int(gen, 0, 1000)));
+            break;
+        default: {
+            static const char alphabet[] = "0123456789012345678901234567890123456789.eE+- ";
+            int len = pbt_random_int(gen, 1, 32);
+            for (int i = 0; i < len; i++) {
+                data->text[i] = alphabet[pbt_random_uint32(gen) % (sizeof(alphabet) - 1)];
+            }
+            data->text[len] = '\0';
+            data->len = len;
+            break;
+        }
+    }
+    return data;
+}
+
+void cleanup_number_text(void* test_data) {
+    free(test_data);
+}
+
+// Property: bread_parse_double agrees with strtod on acceptance and on
+// every bit of the result
+int property_parse_double_matches_strtod(void* test_data) {
+    NumberText* data = (NumberText*)test_data;
+    char* end;
+    double expected = strtod(data->text, &end);
+    int expected_ok = data->len > 0 && end == data->text + data->len;
+
+    double actual = 0.0;
+    int ok = bread_parse_double(data->text, (size_t)data->len, &actual);
+    if (ok != expected_ok) return 0;
+    return !ok || memcmp(&actual, &expected, sizeof(double)) == 0;
+}
+
+// Property: bread_parse_int agrees with strtoll, overflow included
+int property_parse_int_matches_strtoll(void* test_data) {
+    NumberText* data = (NumberText*)test_data;
+    char* end;
+    errno = 0;
+    long long expected = strtoll(data->text, &end, 10);
+    int expected_ok = data->len > 0 && end == data->text + data->len && errno != ERANGE;
+
+    int64_t actual = 0;
+    int ok = bread_parse_int(data->text, (size_t)data->len, &actual);
+    if (ok != expected_ok) return 0;
+    return !ok || actual == expected;
+}
+
+int run_number_parse_tests() {
+    printf("Running Number Parsing Property Tests\n");
+    printf("=====================================\n\n");
+
+    int all_passed = 1;
+
+    PBTResult result1 = pbt_run_property(
+        "Double parsing matches strtod",
+        generate_number_text,
+        property_parse_double_matches_strtod,
+        cleanup_number_text,
+        NUMBER_PARSE_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-number-parsing", 1,
+                     "Double parsing matches strtod", result1);
+
+    if (result1.failed > 0) all_passed = 0;
+
+    PBTResult result2 = pbt_run_property(
+        "Int parsing matches strtoll",
+        generate_number_text,
+        property_parse_int_matches_strtoll,
+        cleanup_number_text,
+        NUMBER_PARSE_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-number-parsing", 2,
+                     "Int parsing matches strtoll", result2);
+
+    if (result2.failed > 0) all_passed = 0;
+
+    pbt_free_result(&result1);
+    pbt_free_result(&result2);
+
+    return all_passed;
+}
+
+int main() {
+    return run_number_parse_tests() ? 0 : 1;
+}
@@ -0,0 +1,220 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../framework/pbt_framework.h"
+#include "runtime/runtime.h"
+#include "runtime/memory.h"
+
+#define NURSERY_ITERATIONS 1000
+#define NURSERY_MAX_OPS 96
+#define NURSERY_MAX_DEPTH 8
+#define NURSERY_MAX_OBJECT 1024 // BREAD_NURSERY_MAX_OBJECT
+
+typedef enum {
+    OP_MARK,       // a statement starts
+    OP_RESET,      // the innermost open statement completes
+    OP_RESET_OUTER, // a return skips the resets of the statements it leaves
+    OP_ALLOC,
+    OP_PROMOTE,
+    OP_COUNT
+} NurseryOpKind;
+
+typedef struct {
+    NurseryOpKind kind;
+    int pick;    // which mark or object, modulo what is open
+    size_t size;
+} NurseryOp;
+
+typedef struct {
+    int op_count;
+    NurseryOp ops[NURSERY_MAX_OPS];
+} NurseryInput;
+
+typedef struct {
+    size_t mark;
+    uint8_t* first_alloc; // first young object allocated after the mark
+} OpenMark;
+
+typedef struct {
+    uint8_t* ptr;
+    size_t size;
+    uint8_t fill;
+    int young;
+    int depth; // statements open when it was allocated
+} Allocation;
+
+void* generate_nursery_input(PBTGenerator* gen) {
+    NurseryInput* data = malloc(sizeof(NurseryInput));
+    if (!data) return NULL;
+    data->op_count = pbt_random_int(gen, 1, NURSERY_MAX_OPS);
+    for (int i = 0; i < data->op_count; i++) {
+        data->ops[i].kind = (NurseryOpKind)pbt_random_int(gen, 0, OP_COUNT);
+        data->ops[i].pick = pbt_random_int(gen, 0, 255);
+        data->ops[i].size = pbt_random_int(gen, 0, 7) ? (size_t)pbt_random_int(gen, sizeof(BreadObjHeader), 200)
+                                                      : (size_t)pbt_random_int(gen, 900, 1200);
+    }
+    return data;
+}
+
+void cleanup_nursery_input(void* test_data) {
+    free(test_data);
+}
+
+// Starts each case outside every statement with an empty nursery
+static void fresh_heap(void) {
+    bread_memory_cleanup();
+    bread_memory_init();
+}
+
+static void fill(Allocation* a) {
+    memset(a->ptr + sizeof(BreadObjHeader), a->fill, a->size - sizeof(BreadObjHeader));
+}
+
+static int intact(const uint8_t* ptr, size_t size, uint8_t fill) {
+    for (size_t i = sizeof(BreadObjHeader); i < size; i++) {
+        if (ptr[i] != fill) return 0;
+    }
+    return 1;
+}
+
+// Property: objects are young exactly while a statement is open and they
+// are small enough, even after returns skip inner resets; a reset drops
+// only what was allocated since its mark, and the next young object
+// reuses that space; promoted copies are tracked and outlive every reset
+int property_nursery_matches_model(void* test_data) {
+    NurseryInput* data = (NurseryInput*)test_data;
+    fresh_heap();
+    BreadMemoryStats before = bread_memory_get_stats();
+    OpenMark marks[NURSERY_MAX_DEPTH];
+    int depth = 0;
+    Allocation objects[NURSERY_MAX_OPS];
+    int object_count = 0;
+    Allocation promoted[NURSERY_MAX_OPS];
+    int promoted_count = 0;
+    uint8_t* expected_next = NULL; // where the next young object must land
+    size_t young = 0;
+    int ok = 1;
+
+    for (int i = 0; i < data->op_count && ok; i++) {
+        const NurseryOp* op = &data->ops[i];
+        NurseryOpKind kind = op->kind;
+        if (kind == OP_MARK && depth == NURSERY_MAX_DEPTH) kind = OP_RESET;
+        if ((kind == OP_RESET || kind == OP_RESET_OUTER) && depth == 0) kind = OP_MARK;
+        if (kind == OP_PROMOTE && object_count == 0) kind = OP_ALLOC;
+
+        switch (kind) {
+            case OP_MARK:
+                marks[depth].mark = bread_memory_nursery_mark();
+                marks[depth].first_alloc = NULL;
+                depth++;
+                break;
+            case OP_RESET:
+            case OP_RESET_OUTER: {
+                int target = kind == OP_RESET ? depth - 1 : op->pick % depth;
+                bread_memory_nursery_reset(marks[target].mark);
+                if (marks[target].first_alloc) expected_next = marks[target].first_alloc;
+                depth = target;
+                int kept = 0;
+                for (int j = 0; j < object_count; j++) {
+                    if (!objects[j].young || objects[j].depth <= depth) objects[kept++] = objects[j];
+                }
+                object_count = kept;
+                break;
+            }
+            case OP_ALLOC: {
+                Allocation* a = &objects[object_count];
+                a->ptr = bread_memory_alloc_young(op->size, BREAD_OBJ_STRING);
+                a->size = op->size;
+                a->fill = (uint8_t)(i + 1);
+                a->depth = depth;
+                a->young = a->ptr && bread_memory_is_young(a->ptr);
+                ok = a->ptr && a->young == (depth > 0 && op->size <= NURSERY_MAX_OBJECT) &&
+                     bread_object_get_refcount(a->ptr) == 1;
+                if (!a->ptr) break;
+                object_count++;
+                fill(a);
+                if (!a->young) break;
+                young++;
+                ok = ok && ((uintptr_t)a->ptr & 15) == 0 && (!expected_next || a->ptr == expected_next);
+                expected_next = NULL;
+                for (int d = depth - 1; d >= 0 && !marks[d].first_alloc; d--) marks[d].first_alloc = a->ptr;
+                break;
+            }
+            default: {
+                Allocation* a = &objects[op->pick % object_count];
+                BreadMemoryStats mid = bread_memory_get_stats();
+                uint8_t* copy = bread_memory_promote(a->ptr);
+                BreadMemoryStats now = bread_memory_get_stats();
+                if (a->young) {
+                    ok = copy && copy != a->ptr && !bread_memory_is_young(copy) &&
+                         bread_memory_object_size(copy) == a->size &&
+                         bread_object_get_refcount(copy) == 1 && intact(copy, a->size, a->fill) &&
+                         now.nursery_promotions == mid.nursery_promotions + 1;
+                } else {
+                    ok = copy == a->ptr && bread_object_get_refcount(copy) == 2 &&
+                         now.nursery_promotions == mid.nursery_promotions;
+                    bread_object_release(copy);
+                    break;
+                }
+                if (copy) {
+                    promoted[promoted_count].ptr = copy;
+                    promoted[promoted_count].size = a->size;
+                    promoted[promoted_count].fill = a->fill;
+                    promoted_count++;
+                }
+                break;
+            }
+        }
+
+        for (int j = 0; j < object_count && ok; j++) ok = intact(objects[j].ptr, objects[j].size, objects[j].fill);
+        for (int j = 0; j < promoted_count && ok; j++) ok = intact(promoted[j].ptr, promoted[j].size, promoted[j].fill);
+    }
+
+    BreadMemoryStats after = bread_memory_get_stats();
+    ok = ok && after.nursery_allocations == before.nursery_allocations + young &&
+         after.nursery_promotions == before.nursery_promotions + (size_t)promoted_count;
+
+    // leaving the outermost statement turns young allocation off
+    if (depth > 0) bread_memory_nursery_reset(marks[0].mark);
+    uint8_t* outside = bread_memory_alloc_young(sizeof(BreadObjHeader), BREAD_OBJ_STRING);
+    ok = ok && outside && !bread_memory_is_young(outside);
+    if (outside) bread_memory_free(outside);
+
+    for (int j = 0; j < object_count; j++) {
+        if (!objects[j].young) bread_memory_free(objects[j].ptr);
+    }
+    for (int j = 0; j < promoted_count; j++) bread_memory_free(promoted[j].ptr);
+    return ok;
+}
+
+int run_nursery_tests() {
+    printf("Running Nursery Property Tests\n");
+    printf("==============================\n\n");
+
+    int all_passed = 1;
+
+    PBTResult result1 = pbt_run_property(
+        "Young allocation, resets and promotion match a model",
+        generate_nursery_input,
+        property_nursery_matches_model,
+        cleanup_nursery_input,
+        NURSERY_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-nursery", 1,
+                     "Young allocation, resets and promotion match a model", result1);
+
+    if (result1.failed > 0) all_passed = 0;
+
+    pbt_free_result(&result1);
+
+    return all_passed;
+}
+
+int main() {
+    bread_memory_init();
+    int passed = run_nursery_tests();
+    bread_memory_cleanup();
+    return passed ? 0 : 1;
+}
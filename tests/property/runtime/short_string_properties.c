@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../framework/pbt_framework.h"
+#include "runtime/runtime.h"
+#include "runtime/memory.h"
+#include "core/value.h"
+
+#define SHORT_STRING_ITERATIONS 2000
+#define SHORT_STRING_MAX_OPS 32
+
+typedef struct {
+    int empty;        // "" instead of a one-byte string
+    unsigned char c;
+    size_t at;        // where `c` sits in a longer string to slice
+    int op_count;
+    int ops[SHORT_STRING_MAX_OPS];
+} ShortStringInput;
+
+void* generate_short_string_input(PBTGenerator* gen) {
+    ShortStringInput* data = malloc(sizeof(ShortStringInput));
+    if (!data) return NULL;
+    data->empty = pbt_random_int(gen, 0, 10) == 0;
+    data->c = (unsigned char)pbt_random_int(gen, 0, 256);
+    data->at = (size_t)pbt_random_int(gen, 0, 40);
+    data->op_count = pbt_random_int(gen, 1, SHORT_STRING_MAX_OPS + 1);
+    for (int i = 0; i < data->op_count; i++) data->ops[i] = pbt_random_int(gen, 0, 8);
+    return data;
+}
+
+void cleanup_short_string_input(void* test_data) {
+    free(test_data);
+}
+
+static int is_short_object(const BreadString* s, const ShortStringInput* data) {
+    size_t len = data->empty ? 0 : 1;
+    return s && s->len == len && (len == 0 || (unsigned char)s->data[0] == data->c) && s->data[len] == '\0' &&
+           s->header.refcount == BREAD_REFCOUNT_IMMORTAL && !bread_memory_is_young(s) &&
+           bread_memory_object_size(s) == 0;
+}
+
+// Property: every way of making an empty or one-byte string returns the
+// same static object
+int property_short_strings_are_shared(void* test_data) {
+    ShortStringInput* data = (ShortStringInput*)test_data;
+    char text[2] = {(char)data->c, '\0'};
+    size_t len = data->empty ? 0 : 1;
+    BreadString* expected = bread_string_new_len(text, len);
+    int ok = is_short_object(expected, data);
+    size_t mark = bread_memory_nursery_mark();
+
+    char longer[40];
+    memset(longer, 'x', sizeof(longer));
+    longer[data->at] = (char)data->c;
+    BreadString* source = bread_string_new_len(longer, sizeof(longer));
+    BreadString* empty = bread_string_new_len("", 0);
+    const BreadString* parts[3] = {empty, expected, empty};
+
+    BreadString* made[6] = {
+        bread_string_slice(source, data->at, data->at + len),
+        bread_string_concat(empty, expected),
+        bread_string_concat(expected, empty),
+        bread_string_concat_n(parts, 3),
+        NULL,
+        NULL,
+    };
+    // the C-string constructors stop at a NUL byte
+    if (data->empty || data->c != 0) {
+        made[4] = bread_string_new_young(data->empty ? "" : text);
+        made[5] = bread_string_new_literal(data->empty ? "" : text);
+    }
+    for (int i = 0; i < 6; i++) {
+        if (made[i]) ok = ok && made[i] == expected;
+    }
+    if (!data->empty && data->c >= '0' && data->c <= '9') {
+        ok = ok && bread_string_from_int(data->c - '0') == expected;
+    }
+
+    bread_memory_nursery_reset(mark);
+    bread_string_release(source);
+    ok = ok && is_short_object(expected, data);
+    return ok;
+}
+
+// Property: retains, releases, promotion and storing the string in
+// arrays and dicts never touch its refcount
+int property_short_string_refcount_never_changes(void* test_data) {
+    ShortStringInput* data = (ShortStringInput*)test_data;
+    char text[1] = {(char)data->c};
+    BreadString* s = bread_string_new_len(text, data->empty ? 0 : 1);
+    BreadValue v = {.type = TYPE_STRING};
+    v.value.string_val = s;
+    int ok = is_short_object(s, data);
+
+    for (int i = 0; i < data->op_count && ok; i++) {
+        switch (data->ops[i]) {
+            case 0: bread_string_retain(s); break;
+            case 1: bread_string_release(s); break;
+            case 2: ok = bread_string_promote(s) == s; break;
+            case 3: {
+                BreadArray* a = bread_array_new_typed(TYPE_STRING);
+                ok = a && bread_array_append(a, v) && bread_array_append(a, v);
+                if (a) bread_array_release(a);
+                break;
+            }
+            case 4: {
+                BreadDict* d = bread_dict_new_typed(TYPE_STRING, TYPE_STRING);
+                ok = d && bread_dict_set_string(d, s, v);
+                if (d) bread_dict_release(d);
+                break;
+            }
+            case 5: {
+                BreadValue copy = bread_value_promote(v);
+                ok = copy.value.string_val == s;
+                bread_value_release(&copy);
+                break;
+            }
+            case 6: bread_memory_collect_cycles(); break;
+            default: {
+                size_t mark = bread_memory_nursery_mark();
+                BreadString* again = bread_string_slice(s, 0, 1);
+                ok = again == s;
+                bread_memory_nursery_reset(mark);
+                break;
+            }
+        }
+        ok = ok && is_short_object(s, data);
+    }
+    return ok;
+}
+
+int run_short_string_tests() {
+    printf("Running Short String Property Tests\n");
+    printf("===================================\n\n");
+
+    int all_passed = 1;
+
+    PBTResult result1 = pbt_run_property(
+        "Empty and one-byte strings are shared static objects",
+        generate_short_string_input,
+        property_short_strings_are_shared,
+        cleanup_short_string_input,
+        SHORT_STRING_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-short-strings", 1,
+                     "Empty and one-byte strings are shared static objects", result1);
+
+    if (result1.failed > 0) all_passed = 0;
+
+    PBTResult result2 = pbt_run_property(
+        "Immortal refcounts never change",
+        generate_short_string_input,
+        property_short_string_refcount_never_changes,
+        cleanup_short_string_input,
+        SHORT_STRING_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-short-strings", 2,
+                     "Immortal refcounts never change", result2);
+
+    if (result2.failed > 0) all_passed = 0;
+
+    pbt_free_result(&result1);
+    pbt_free_result(&result2);
+
+    return all_passed;
+}
+
+int main() {
+    bread_memory_init();
+    int passed = run_short_string_tests();
+    bread_string_intern_cleanup();
+    bread_memory_cleanup();
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../framework/pbt_framework.h"
+#include "runtime/runtime.h"
+#include "runtime/memory.h"
+
+#define STRING_EQUALITY_ITERATIONS 2000
+#define STRING_EQUALITY_MAX_LEN 60
+
+typedef struct {
+    char text[STRING_EQUALITY_MAX_LEN + 1];
+    char other[STRING_EQUALITY_MAX_LEN + 1]; // same length, one byte different
+    size_t len;
+    size_t split; // where the runtime-built copy is concatenated
+    int cache_hashes;
+} EqualityInput;
+
+void* generate_equality_input(PBTGenerator* gen) {
+    EqualityInput* data = malloc(sizeof(EqualityInput));
+    if (!data) return NULL;
+    data->len = (size_t)pbt_random_int(gen, 2, STRING_EQUALITY_MAX_LEN + 1);
+    for (size_t i = 0; i < data->len; i++) {
+        data->text[i] = (char)('a' + pbt_random_int(gen, 0, 3));
+    }
+    data->text[data->len] = '\0';
+    memcpy(data->other, data->text, data->len + 1);
+    size_t at = (size_t)pbt_random_int(gen, 0, (int)data->len);
+    data->other[at] = data->other[at] == 'z' ? 'y' : 'z';
+    data->split = (size_t)pbt_random_int(gen, 0, (int)data->len + 1);
+    data->cache_hashes = pbt_random_int(gen, 0, 2);
+    return data;
+}
+
+void cleanup_equality_input(void* test_data) {
+    free(test_data);
+}
+
+// The object cg_get_string_object emits for a literal: immortal, hash
+// already filled in, never interned
+static BreadString* emitted_literal(const char* text, size_t len) {
+    BreadString* s = calloc(1, sizeof(BreadString) + len + 1);
+    if (!s) return NULL;
+    s->header.kind = BREAD_OBJ_STRING;
+    s->header.refcount = BREAD_REFCOUNT_IMMORTAL;
+    s->len = len;
+    s->hash = bread_hash_bytes(text, len);
+    s->flags = len <= BREAD_STRING_SMALL_MAX ? BREAD_STRING_SMALL : 0;
+    memcpy(s->data, text, len);
+    return s;
+}
+
+static int equal_both_ways(const BreadString* a, const BreadString* b) {
+    int ab = bread_string_eq(a, b);
+    return ab == bread_string_eq(b, a) ? ab : -1;
+}
+
+static void maybe_cache(const EqualityInput* data, BreadString* s) {
+    if (data->cache_hashes) bread_string_hash(s);
+}
+
+// Property: an interned literal and an emitted literal equal a runtime
+// string with the same bytes, and neither equals a string differing in
+// one byte
+int property_literal_equals_runtime_string(void* test_data) {
+    EqualityInput* data = (EqualityInput*)test_data;
+    BreadString* interned = bread_string_new_literal(data->text);
+    BreadString* emitted = emitted_literal(data->text, data->len);
+    BreadString* left = bread_string_new_len(data->text, data->split);
+    BreadString* right = bread_string_new_len(data->text + data->split, data->len - data->split);
+    BreadString* built = bread_string_concat(left, right);
+    BreadString* other = bread_string_new_len(data->other, data->len);
+    maybe_cache(data, built);
+    maybe_cache(data, other);
+
+    int ok = interned && emitted && built && other &&
+             equal_both_ways(interned, built) == 1 &&
+             equal_both_ways(emitted, built) == 1 &&
+             equal_both_ways(interned, emitted) == 1 &&
+             equal_both_ways(interned, other) == 0 &&
+             equal_both_ways(emitted, other) == 0;
+
+    bread_string_release(interned);
+    free(emitted);
+    bread_string_release(left);
+    bread_string_release(right);
+    bread_string_release(built);
+    bread_string_release(other);
+    return ok;
+}
+
+// Property: an interned string equals a view with the same bytes and
+// differs from a view with other bytes, young or promoted
+int property_interned_equals_view(void* test_data) {
+    EqualityInput* data = (EqualityInput*)test_data;
+    char padded[STRING_EQUALITY_MAX_LEN * 2 + 32];
+    int pad = snprintf(padded, sizeof(padded), "<<%s>>%s", data->text, data->other);
+
+    BreadString* interned = bread_string_new_literal(data->text);
+    BreadString* parent = bread_string_new_len(padded, (size_t)pad);
+    size_t mark = bread_memory_nursery_mark();
+    BreadString* same = bread_string_slice(parent, 2, 2 + data->len);
+    BreadString* differs = bread_string_slice(parent, 4 + data->len, 4 + 2 * data->len);
+    maybe_cache(data, same);
+    BreadString* kept = bread_string_promote(same);
+
+    int ok = interned && parent && kept &&
+             equal_both_ways(interned, same) == 1 &&
+             equal_both_ways(interned, kept) == 1 &&
+             equal_both_ways(interned, differs) == 0;
+
+    bread_memory_nursery_reset(mark);
+    if (kept) bread_string_release(kept);
+    bread_string_release(parent);
+    bread_string_release(interned);
+    return ok;
+}
+
+// Property: a literal held across bread_string_intern_cleanup loses its
+// interned flag, so it still equals the copy interned afterwards
+int property_equality_across_intern_cleanup(void* test_data) {
+    EqualityInput* data = (EqualityInput*)test_data;
+    BreadString* before = bread_string_new_literal(data->text);
+    BreadString* again = bread_string_new_literal(data->text);
+    int ok = before && before == again && (before->flags & BREAD_STRING_INTERNED);
+    bread_string_release(again);
+
+    bread_string_intern_cleanup();
+    ok = ok && !(before->flags & BREAD_STRING_INTERNED);
+    BreadString* after = bread_string_new_literal(data->text);
+    BreadString* other = bread_string_new_literal(data->other);
+    maybe_cache(data, before);
+    ok = ok && after && after != before && (after->flags & BREAD_STRING_INTERNED) &&
+         equal_both_ways(before, after) == 1 &&
+         equal_both_ways(before, other) == 0;
+
+    bread_string_release(before);
+    bread_string_release(after);
+    bread_string_release(other);
+    bread_string_intern_cleanup();
+    return ok;
+}
+
+int run_string_equality_tests() {
+    printf("Running String Equality Property Tests\n");
+    printf("======================================\n\n");
+
+    struct {
+        const char* text;
+        pbt_property_fn property;
+    } properties[] = {
+        {"Literals equal runtime strings with the same bytes", property_literal_equals_runtime_string},
+        {"Interned strings equal views with the same bytes", property_interned_equals_view},
+        {"Equality holds across intern table cleanup", property_equality_across_intern_cleanup},
+    };
+
+    int all_passed = 1;
+    for (size_t i = 0; i < sizeof(properties) / sizeof(properties[0]); i++) {
+        PBTResult result = pbt_run_property(
+            properties[i].text,
+            generate_equality_input,
+            properties[i].property,
+            cleanup_equality_input,
+            STRING_EQUALITY_ITERATIONS
+        );
+        pbt_report_result("breadlang-string-equality", (int)i + 1, properties[i].text, result);
+        if (result.failed > 0) all_passed = 0;
+        pbt_free_result(&result);
+    }
+
+    return all_passed;
+}
+
+int main() {
+    bread_memory_init();
+    int passed = run_string_equality_tests();
+    bread_string_intern_cleanup();
+    bread_memory_cleanup();
+    return passed ? 0 : 1;
+}
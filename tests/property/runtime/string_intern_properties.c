@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../framework/pbt_framework.h"
+#include "runtime/runtime.h"
+#include "runtime/memory.h"
+
+#define STRING_INTERN_ITERATIONS 500
+#define STRING_INTERN_MIN_TEXTS 300   // past the 70% load of the initial 256 slots
+#define STRING_INTERN_MAX_TEXTS 2000
+#define STRING_INTERN_MAX_LEN 24
+
+typedef struct {
+    int count;
+    char (*texts)[STRING_INTERN_MAX_LEN + 16];
+} InternInput;
+
+// Distinct texts, each tagged with its index so no two collide by
+// content, sharing random tails so many have the same length
+void* generate_intern_input(PBTGenerator* gen) {
+    InternInput* data = malloc(sizeof(InternInput));
+    if (!data) return NULL;
+    data->count = pbt_random_int(gen, STRING_INTERN_MIN_TEXTS, STRING_INTERN_MAX_TEXTS + 1);
+    data->texts = malloc((size_t)data->count * sizeof(*data->texts));
+    if (!data->texts) {
+        free(data);
+        return NULL;
+    }
+    for (int i = 0; i < data->count; i++) {
+        char tail[STRING_INTERN_MAX_LEN + 1];
+        int len = pbt_random_int(gen, 0, STRING_INTERN_MAX_LEN + 1);
+        for (int j = 0; j < len; j++) tail[j] = (char)('a' + pbt_random_int(gen, 0, 26));
+        tail[len] = '\0';
+        snprintf(data->texts[i], sizeof(data->texts[i]), "%d:%s", i, tail);
+    }
+    return data;
+}
+
+void cleanup_intern_input(void* test_data) {
+    InternInput* data = (InternInput*)test_data;
+    free(data->texts);
+    free(data);
+}
+
+// Property: while the table grows from its initial capacity, looking a
+// text up again returns the string interned for it, with one reference
+// held by the table and one by the caller
+int property_interned_strings_survive_growth(void* test_data) {
+    InternInput* data = (InternInput*)test_data;
+    BreadString** interned = calloc((size_t)data->count, sizeof(BreadString*));
+    if (!interned) return 0;
+    int ok = 1;
+
+    for (int i = 0; i < data->count && ok; i++) {
+        interned[i] = bread_string_new_literal(data->texts[i]);
+        ok = interned[i] && (interned[i]->flags & BREAD_STRING_INTERNED) &&
+             bread_object_get_refcount(interned[i]) == 2;
+        // revisit an earlier entry, which may have moved slots in a grow
+        int earlier = i / 2;
+        BreadString* again = ok ? bread_string_new_literal(data->texts[earlier]) : NULL;
+        ok = ok && again == interned[earlier];
+        if (again) bread_string_release(again);
+    }
+
+    size_t count = 0;
+    bread_string_intern_stats(&count, NULL, NULL);
+    ok = ok && count == (size_t)data->count;
+
+    for (int i = 0; i < data->count && ok; i++) {
+        BreadString* again = bread_string_new_literal(data->texts[i]);
+        ok = again == interned[i] && bread_object_get_refcount(again) == 3 &&
+             strcmp(bread_string_cstr(again), data->texts[i]) == 0;
+        if (again) bread_string_release(again);
+    }
+
+    for (int i = 0; i < data->count; i++) {
+        if (interned[i]) bread_string_release(interned[i]);
+    }
+    free(interned);
+    bread_string_intern_cleanup();
+    return ok;
+}
+
+int run_string_intern_tests() {
+    printf("Running String Intern Table Property Tests\n");
+    printf("==========================================\n\n");
+
+    int all_passed = 1;
+
+    PBTResult result1 = pbt_run_property(
+        "Interned strings keep their identity as the table grows",
+        generate_intern_input,
+        property_interned_strings_survive_growth,
+        cleanup_intern_input,
+        STRING_INTERN_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-string-intern", 1,
+                     "Interned strings keep their identity as the table grows", result1);
+
+    if (result1.failed > 0) all_passed = 0;
+
+    pbt_free_result(&result1);
+
+    return all_passed;
+}
+
+int main() {
+    bread_memory_init();
+    int passed = run_string_intern_tests();
+    bread_memory_cleanup();
+    return passed ? 0 : 1;
+}
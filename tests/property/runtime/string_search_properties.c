@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../framework/pbt_framework.h"
+#include "runtime/string_search.h"
+
+#define STRING_SEARCH_ITERATIONS 20000
+#define STRING_SEARCH_MAX_HAY 300
+
+static const char* const search_kernels[] = {"scalar", "sse2", "avx2"};
+
+typedef struct {
+    char* hay;     // exactly n bytes, so a kernel reading past the end trips ASan
+    size_t n;
+    char* needle;
+    size_t m;
+} SearchInput;
+
+// Haystacks over a two- or four-letter alphabet, so first/last byte
+// candidates are common. Needles are 1 or 2 bytes, longer than a 16-byte
+// block, longer than the haystack, or cut from the haystack's tail so the
+// only match ends on its last byte.
+void* generate_search_input(PBTGenerator* gen) {
+    SearchInput* data = malloc(sizeof(SearchInput));
+    if (!data) return NULL;
+    const char* alphabet = pbt_random_int(gen, 0, 2) ? "ab" : "abcd";
+    size_t letters = strlen(alphabet);
+
+    data->n = (size_t)pbt_random_int(gen, 0, STRING_SEARCH_MAX_HAY + 1);
+    data->hay = malloc(data->n ? data->n : 1);
+    for (size_t i = 0; i < data->n; i++) {
+        data->hay[i] = alphabet[pbt_random_uint32(gen) % letters];
+    }
+
+    int shape = pbt_random_int(gen, 0, 5);
+    switch (shape) {
+        case 0: data->m = 1; break;
+        case 1: data->m = 2; break;
+        case 2: data->m = (size_t)pbt_random_int(gen, 17, 41); break;
+        case 3: data->m = data->n + (size_t)pbt_random_int(gen, 1, 4); break;
+        default: data->m = data->n ? (size_t)pbt_random_int(gen, 1, (int)(data->n < 40 ? data->n : 40) + 1) : 1; break;
+    }
+    data->needle = malloc(data->m);
+    if (shape == 4 && data->m <= data->n) {
+        memcpy(data->needle, data->hay + data->n - data->m, data->m);
+    } else {
+        for (size_t i = 0; i < data->m; i++) {
+            data->needle[i] = alphabet[pbt_random_uint32(gen) % letters];
+        }
+    }
+    return data;
+}
+
+void cleanup_search_input(void* test_data) {
+    SearchInput* data = (SearchInput*)test_data;
+    free(data->hay);
+    free(data->needle);
+    free(data);
+}
+
+static int64_t naive_find(const char* hay, size_t n, const char* needle, size_t m) {
+    if (m > n) return -1;
+    for (size_t i = 0; i + m <= n; i++) {
+        if (memcmp(hay + i, needle, m) == 0) return (int64_t)i;
+    }
+    return -1;
+}
+
+static size_t naive_count(const char* hay, size_t n, const char* needle, size_t m) {
+    size_t count = 0;
+    for (size_t i = 0; i + m <= n;) {
+        if (memcmp(hay + i, needle, m) == 0) {
+            count++;
+            i += m;
+        } else {
+            i++;
+        }
+    }
+    return count;
+}
+
+// Property: every kernel finds the first match a byte-by-byte loop finds,
+// from every starting offset, and counts the same non-overlapping matches
+int property_kernels_match_naive_search(void* test_data) {
+    SearchInput* data = (SearchInput*)test_data;
+    size_t expected_count = naive_count(data->hay, data->n, data->needle, data->m);
+
+    for (size_t k = 0; k < sizeof(search_kernels) / sizeof(search_kernels[0]); k++) {
+        if (!bread_bytes_set_kernel(search_kernels[k])) continue;
+        for (size_t from = 0; from <= data->n; from++) {
+            const char* hay = data->hay + from;
+            size_t n = data->n - from;
+            if (bread_bytes_find(hay, n, data->needle, data->m) != naive_find(hay, n, data->needle, data->m)) {
+                return 0;
+            }
+        }
+        if (bread_bytes_count(data->hay, data->n, data->needle, data->m) != expected_count) return 0;
+    }
+    return 1;
+}
+
+// Property: the empty needle matches at 0 and between every pair of bytes
+int property_empty_needle(void* test_data) {
+    SearchInput* data = (SearchInput*)test_data;
+    for (size_t k = 0; k < sizeof(search_kernels) / sizeof(search_kernels[0]); k++) {
+        if (!bread_bytes_set_kernel(search_kernels[k])) continue;
+        if (bread_bytes_find(data->hay, data->n, "", 0) != 0) return 0;
+        if (bread_bytes_count(data->hay, data->n, "", 0) != data->n + 1) return 0;
+    }
+    return 1;
+}
+
+int run_string_search_tests() {
+    printf("Running String Search Property Tests (%s kernel by default)\n", bread_bytes_kernel());
+    printf("===========================================================\n\n");
+
+    int all_passed = 1;
+
+    PBTResult result1 = pbt_run_property(
+        "Every kernel matches a naive search",
+        generate_search_input,
+        property_kernels_match_naive_search,
+        cleanup_search_input,
+        STRING_SEARCH_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-string-search", 1,
+                     "Every kernel matches a naive search", result1);
+
+    if (result1.failed > 0) all_passed = 0;
+
+    PBTResult result2 = pbt_run_property(
+        "The empty needle matches everywhere",
+        generate_search_input,
+        property_empty_needle,
+        cleanup_search_input,
+        PBT_MIN_ITERATIONS
+    );
+
+    pbt_report_result("breadlang-string-search", 2,
+                     "The empty needle matches everywhere", result2);
+
+    if (result2.failed > 0) all_passed = 0;
+
+    pbt_free_result(&result1);
+    pbt_free_result(&result2);
+
+    return all_passed;
+}
+
+int main() {
+    return run_string_search_tests() ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../framework/pbt_framework.h"
+#include "runtime/runtime.h"
+#include "runtime/memory.h"
+
+#define STRING_VIEW_ITERATIONS 2000
+#define STRING_VIEW_MAX_LEN 160
+
+typedef struct {
+    char text[STRING_VIEW_MAX_LEN + 1];
+    size_t len;
+    size_t start, end;            // outer slice of text
+    size_t inner_start, inner_end; // slice of the outer slice
+} ViewInput;
+
+// Texts long enough that most slices exceed BREAD_STRING_SMALL_MAX and
+// come back as views; the rest exercise the short copies.
+void* generate_view_input(PBTGenerator* gen) {
+    ViewInput* data = malloc(sizeof(ViewInput));
+    if (!data) return NULL;
+    data->len = (size_t)pbt_random_int(gen, BREAD_STRING_SMALL_MAX + 1, STRING_VIEW_MAX_LEN + 1);
+    for (size_t i = 0; i < data->len; i++) {
+        data->text[i] = (char)('a' + pbt_random_int(gen, 0, 26));
+    }
+    data->text[data->len] = '\0';
+    data->start = (size_t)pbt_random_int(gen, 0, (int)data->len + 1);
+    data->end = (size_t)pbt_random_int(gen, (int)data->start, (int)data->len + 1);
+    size_t outer = data->end - data->start;
+    data->inner_start = (size_t)pbt_random_int(gen, 0, (int)outer + 1);
+    data->inner_end = (size_t)pbt_random_int(gen, (int)data->inner_start, (int)outer + 1);
+    return data;
+}
+
+void cleanup_view_input(void* test_data) {
+    free(test_data);
+}
+
+static int holds(const BreadString* s, const char* bytes, size_t len) {
+    return s && bread_string_len(s) == len && memcmp(bread_string_data(s), bytes, len) == 0;
+}
+
+static int is_view(const BreadString* s) {
+    return (s->flags & BREAD_STRING_VIEW) != 0;
+}
+
+// Fills the nursery region a reset just dropped, so a string still
+// pointing into it reads garbage instead of its old bytes
+static void scribble_nursery(void) {
+    char junk[STRING_VIEW_MAX_LEN + 1];
+    memset(junk, '#', STRING_VIEW_MAX_LEN);
+    junk[STRING_VIEW_MAX_LEN] = '\0';
+    for (int i = 0; i < 8; i++) bread_string_new_young(junk);
+}
+
+// Property: a slice of a view reads the right bytes of the original
+// string, and its promoted copy survives the statement's reset
+int property_view_of_view(void* test_data) {
+    ViewInput* data = (ViewInput*)test_data;
+    BreadString* parent = bread_string_new_len(data->text, data->len);
+    if (!parent) return 0;
+    size_t mark = bread_memory_nursery_mark();
+
+    BreadString* outer = bread_string_slice(parent, data->start, data->end);
+    BreadString* inner = bread_string_slice(outer, data->inner_start, data->inner_end);
+    const char* expected = data->text + data->start + data->inner_start;
+    size_t expected_len = data->inner_end - data->inner_start;
+    int ok = holds(outer, data->text + data->start, data->end - data->start) &&
+             holds(inner, expected, expected_len) &&
+             is_view(inner) == (expected_len > BREAD_STRING_SMALL_MAX);
+    BreadString* kept = ok ? bread_string_promote(inner) : NULL;
+
+    bread_memory_nursery_reset(mark);
+    scribble_nursery();
+    bread_memory_nursery_reset(mark);
+    ok = ok && holds(kept, expected, expected_len);
+    if (kept) bread_string_release(kept);
+    bread_string_release(parent);
+    return ok;
+}
+
+// Property: promoting a slice of a statement temporary copies the bytes,
+// since the temporary is gone once the statement resets
+int property_young_parent_promote(void* test_data) {
+    ViewInput* data = (ViewInput*)test_data;
+    size_t mark = bread_memory_nursery_mark();
+
+    BreadString* parent = bread_string_new_young(data->text);
+    BreadString* slice = bread_string_slice(parent, data->start, data->end);
+    size_t expected_len = data->end - data->start;
+    int ok = bread_memory_is_young(parent) && holds(slice, data->text + data->start, expected_len);
+    BreadString* kept = ok ? bread_string_promote(slice) : NULL;
+    ok = ok && kept && !bread_memory_is_young(kept) && !is_view(kept);
+
+    bread_memory_nursery_reset(mark);
+    scribble_nursery();
+    bread_memory_nursery_reset(mark);
+    ok = ok && holds(kept, data->text + data->start, expected_len);
+    if (kept) bread_string_release(kept);
+    return ok;
+}
+
+// Property: bread_string_cstr on a view returns a NUL-terminated copy of
+// its bytes, made once and reused
+int property_view_cstr(void* test_data) {
+    ViewInput* data = (ViewInput*)test_data;
+    BreadString* parent = bread_string_new_len(data->text, data->len);
+    if (!parent) return 0;
+    size_t mark = bread_memory_nursery_mark();
+
+    BreadString* slice = bread_string_slice(parent, data->start, data->end);
+    BreadString* kept = bread_string_promote(slice);
+    bread_memory_nursery_reset(mark);
+    size_t expected_len = data->end - data->start;
+    const char* first = kept ? bread_string_cstr(kept) : NULL;
+    int ok = first && strlen(first) == expected_len &&
+             memcmp(first, data->text + data->start, expected_len) == 0 &&
+             bread_string_cstr(kept) == first;
+
+    if (kept) bread_string_release(kept);
+    bread_string_release(parent);
+    return ok;
+}
+
+// Property: a tracked view keeps its parent's bytes alive after every
+// other reference to the parent is released
+int property_view_outlives_parent(void* test_data) {
+    ViewInput* data = (ViewInput*)test_data;
+    BreadString* parent = bread_string_new_len(data->text, data->len);
+    if (!parent) return 0;
+    size_t mark = bread_memory_nursery_mark();
+
+    BreadString* slice = bread_string_slice(parent, data->start, data->end);
+    BreadString* kept = bread_string_promote(slice);
+    bread_memory_nursery_reset(mark);
+    bread_string_release(parent);
+
+    size_t expected_len = data->end - data->start;
+    int ok = holds(kept, data->text + data->start, expected_len);
+    // fresh allocations would reuse the parent's block had it been freed
+    for (int i = 0; i < 8; i++) {
+        BreadString* junk = bread_string_new_len(data->text, data->len);
+        memset(junk->data, '#', data->len);
+        bread_string_release(junk);
+    }
+    ok = ok && holds(kept, data->text + data->start, expected_len);
+    if (kept) bread_string_release(kept);
+    return ok;
+}
+
+int run_string_view_tests() {
+    printf("Running String View Property Tests\n");
+    printf("==================================\n\n");
+
+    struct {
+        const char* text;
+        pbt_property_fn property;
+    } properties[] = {
+        {"A slice of a view reads the original bytes", property_view_of_view},
+        {"Promoting a slice of a temporary copies it", property_young_parent_promote},
+        {"bread_string_cstr flattens a view once", property_view_cstr},
+        {"A view keeps its released parent's bytes", property_view_outlives_parent},
+    };
+
+    int all_passed = 1;
+    for (size_t i = 0; i < sizeof(properties) / sizeof(properties[0]); i++) {
+        PBTResult result = pbt_run_property(
+            properties[i].text,
+            generate_view_input,
+            properties[i].property,
+            cleanup_view_input,
+            STRING_VIEW_ITERATIONS
+        );
+        pbt_report_result("breadlang-string-views", (int)i + 1, properties[i].text, result);
+        if (result.failed > 0) all_passed = 0;
+        pbt_free_result(&result);
+    }
+
+    return all_passed;
+}
+
+int main() {
+    bread_memory_init();
+    int passed = run_string_view_tests();
+    bread_memory_cleanup();
+    return passed ? 0 : 1;
+}